@@ -1,57 +1,20 @@
-import dev.nokee.platform.nativebase.NativeBinary
-import dev.nokee.testing.nativebase.NativeTestSuite
-import dev.nokee.testing.nativebase.internal.DefaultNativeTestSuiteComponent
-
 plugins {
-    id("psys-component")
+    id("br.dev.pedrolamarao.metal.archive")
+    id("br.dev.pedrolamarao.metal.cpp")
+    id("br.dev.pedrolamarao.metal.cxx")
+    id("br.dev.pedrolamarao.metal.ixx")
 }
 
-library {
-    targetLinkages.add(linkages.static)
-
-    targetMachines.addAll(
-        // #XXX: build on any for same
-        machines.linux.x86_64,
-        machines.windows.x86_64,
-        // #XXX: build on any for x86_32-elf-multiboot2
-        machines.os("host").architecture("-x86_32-elf-multiboot2"),
-        // #XXX: build on any for x86_64-elf-multiboot2
-        machines.os("host").architecture("-x86_64-elf-multiboot2"),
-    )
-
-    dependencies { api(project(":psys")) }
+group = "br.dev.pedrolamarao.metal.acpi"
 
-    binaries.configureEach {
-        if (this is NativeBinary) {
-            compileTasks.configureEach {
-                compilerArgs.addAll("-std=c++20", "-flto")
-            }
-        }
-    }
+dependencies {
+    api(project(":psys"))
+    testImplementation(project(":googletest"))
 }
 
-testSuites {
-    register("test", NativeTestSuite::class.java) {
-        testedComponent(library)
+metal {
+    compileOptions = listOf("-fasm-blocks","-g","-std=c++20","-Wno-unused-command-line-argument")
 
-        dependencies {
-            // #XXX: Nokee does not transitively include main `api` dependencies
-            implementation(project(":psys"))
-            implementation(project(":googletest"))
-        }
-
-        if (this is DefaultNativeTestSuiteComponent) {
-            binaries.configureEach {
-                if (this is dev.nokee.platform.nativebase.ExecutableBinary) {
-                    compileTasks.configureEach {
-                        compilerArgs.addAll("-std=c++20", "-flto")
-                    }
-                    linkTask {
-                        // #XXX: Nokee ignores toolchain linker arguments
-                        linkerArgs.addAll("-fuse-ld=lld", "-flto")
-                    }
-                }
-            }
-        }
-    }
-}
\ No newline at end of file
+    applications { test { targets = setOf("x86_64-pc-linux-gnu","x86_64-pc-windows-msvc") } }
+    ixx { main { public = true } }
+}
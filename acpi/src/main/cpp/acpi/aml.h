@@ -0,0 +1,338 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <acpi/system_description.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace acpi
+{
+  //! AML load or evaluation status.
+
+  enum class aml_status : ps::size1
+  {
+    ok          = 0,
+    not_found   = 1,
+    unsupported = 2,
+    malformed   = 3,
+    exhausted   = 4,
+  };
+
+  //! AML namespace object type.
+
+  enum class aml_object : ps::size1
+  {
+    scope          = 0,
+    device         = 1,
+    method         = 2,
+    name           = 3,
+    processor      = 4,
+    power_resource = 5,
+    thermal_zone   = 6,
+    region         = 7,
+    field          = 8,
+    mutex          = 9,
+    event          = 10,
+    alias          = 11,
+  };
+
+  //! AML value type.
+
+  enum class aml_type : ps::size1
+  {
+    none      = 0,
+    integer   = 1,
+    string    = 2,
+    buffer    = 3,
+    package   = 4,
+    reference = 5,
+  };
+
+  struct aml_node ;
+
+  //! AML value.
+  //!
+  //! Strings and buffers usually point into table memory; package elements live in the arena.
+
+  struct aml_value
+  {
+    aml_type          type;
+    ps::size4         length;
+    ps::size8         integer;
+    ps::size1 const * data;
+    aml_value *       elements;
+    aml_node *        node;
+  };
+
+  //! AML namespace node.
+  //!
+  //! Methods and named objects keep their AML and are evaluated only when requested.
+
+  struct aml_node
+  {
+    ps::size4         name;
+    aml_object        type;
+    ps::size1         arguments;
+    aml_node *        parent;
+    aml_node *        child;
+    aml_node *        sibling;
+    ps::size1 const * code;
+    ps::size1 const * end;
+    aml_value *       value;
+  };
+
+  //! Bump allocator over caller memory.
+
+  class aml_arena
+  {
+    ps::size1 * _next {};
+    ps::size1 * _end {};
+
+  public:
+
+    constexpr
+    aml_arena () = default;
+
+    aml_arena ( void * memory, ps::size size ) ;
+
+    //! Zeroed array of count objects, or null if exhausted.
+
+    template <typename T>
+    auto allocate ( ps::size count = 1 ) -> T * ;
+
+    auto available () const -> ps::size { return _end - _next; }
+
+    //! Allocation position, to release later allocations with reset.
+
+    auto mark () const -> ps::size1 * { return _next; }
+
+    void reset ( ps::size1 * mark ) { _next = mark; }
+  };
+
+  struct aml_interpreter ;
+
+  //! AML namespace.
+  //!
+  //! Loading a DSDT or SSDT builds namespace nodes in the arena without running any method;
+  //! evaluation interprets a bounded subset of AML: data objects, locals and arguments,
+  //! control flow, integer arithmetic and logic, Store, Index, SizeOf and method invocation.
+  //! Operation region access is not supported: evaluation touching fields fails as unsupported.
+  //! Load time If blocks are skipped.
+
+  class aml_namespace
+  {
+    friend struct aml_interpreter;
+
+    aml_arena   _arena;
+    aml_node *  _root {};
+    ps::size1 * _pinned {};
+    unsigned    _count {};
+    unsigned    _steps {};
+    ps::size8   _ones { ~ps::size8(0) };
+
+  public:
+
+    //! Maximum method call depth.
+
+    static constexpr unsigned max_depth = 8;
+
+    //! Maximum opcodes executed per evaluation.
+
+    static constexpr unsigned max_steps = 100000;
+
+    //! Object
+    //! @{
+
+    aml_namespace ( void * memory, ps::size size ) ;
+
+    aml_namespace ( aml_namespace const & ) = delete;
+
+    //! @}
+
+    //! Properties
+    //! @{
+
+    auto root () const -> aml_node * { return _root; }
+
+    //! Number of namespace nodes.
+
+    auto size () const -> unsigned { return _count; }
+
+    auto arena () -> aml_arena & { return _arena; }
+
+    //! @}
+
+    //! Load definition block from DSDT or SSDT.
+    //!
+    //! A DSDT with revision less than 2 selects 32-bit integers.
+
+    auto load ( system_description const & table ) -> aml_status ;
+
+    //! Node at path, absolute or relative to scope, without upward search; null if not found.
+    //!
+    //! Path segments are separated by dots; short segments are padded with underscores.
+
+    auto find ( char const * path, aml_node const * scope = nullptr ) const -> aml_node * ;
+
+    //! Evaluate node: invoke method with arguments, or evaluate named object.
+
+    auto evaluate ( aml_node * node, aml_value & result, aml_value const * arguments = nullptr, unsigned count = 0 ) -> aml_status ;
+
+    //! Evaluate node at path.
+
+    auto evaluate ( aml_node const * scope, char const * path, aml_value & result ) -> aml_status ;
+
+    //! Release arena memory allocated since mark by evaluations, keeping namespace nodes and named values.
+    //!
+    //! Values evaluated since mark may refer to released memory.
+
+    void release ( ps::size1 * mark ) { _arena.reset(mark > _pinned ? mark : _pinned); }
+  };
+
+  //! Device status from _STA; present, enabled, shown and functioning if absent.
+
+  auto device_status ( aml_namespace & ns, aml_node * device ) -> ps::size4 ;
+
+  //! PCI interrupt routing entry.
+  //!
+  //! Source is null for a hard-wired global system interrupt index,
+  //! otherwise the link device whose current resources select the interrupt.
+
+  struct pci_route
+  {
+    ps::size4  address;
+    ps::size1  pin;
+    aml_node * source;
+    ps::size4  index;
+  };
+
+  //! Collect PCI interrupt routing from bridge _PRT; returns number found, which may exceed capacity.
+
+  auto pci_routes ( aml_namespace & ns, aml_node * bridge, pci_route * routes, unsigned capacity ) -> unsigned ;
+
+  //! Device current resources from _CRS, as buffer.
+  //!
+  //! Buffers built by methods live in the arena: release them with aml_namespace::release when done.
+
+  auto current_resources ( aml_namespace & ns, aml_node * device, aml_value & result ) -> aml_status ;
+
+  //! Resource descriptor type: small item names below 0x10, large item names above 0x80.
+
+  enum class resource_type : ps::size1
+  {
+    irq              = 0x04,
+    dma              = 0x05,
+    io               = 0x08,
+    fixed_io         = 0x09,
+    end              = 0x0F,
+    memory24         = 0x81,
+    generic_register = 0x82,
+    memory32         = 0x85,
+    fixed_memory32   = 0x86,
+    dword_address    = 0x87,
+    word_address     = 0x88,
+    extended_irq     = 0x89,
+    qword_address    = 0x8A,
+    extended_address = 0x8B,
+  };
+
+  //! Resource descriptor.
+
+  struct aml_resource
+  {
+    resource_type     type;
+    ps::size2         length;
+    ps::size1 const * data;
+  };
+
+  //! Split resource template into descriptors; returns number found, which may exceed capacity.
+
+  auto resources ( aml_value const & buffer, aml_resource * descriptors, unsigned capacity ) -> unsigned ;
+
+  //! Interrupts of IRQ or extended IRQ descriptor; returns number found, which may exceed capacity.
+
+  auto resource_interrupts ( aml_resource const & x, ps::size4 * interrupts, unsigned capacity ) -> unsigned ;
+
+  //! Resource range; space is 0 for memory, 1 for I/O, 2 for bus numbers, as in address descriptors.
+
+  struct resource_range
+  {
+    ps::size1 space;
+    ps::size8 base;
+    ps::size8 length;
+  };
+
+  //! Range of I/O, memory or address space descriptor; false for other descriptors.
+
+  auto resource_range_of ( aml_resource const & x, resource_range & range ) -> bool ;
+
+  //! Processor performance state, from _PSS.
+
+  struct performance_state
+  {
+    ps::size4 frequency;
+    ps::size4 power;
+    ps::size4 latency;
+    ps::size4 bus_master_latency;
+    ps::size4 control;
+    ps::size4 status;
+  };
+
+  //! Collect processor performance states; returns number found, which may exceed capacity.
+
+  auto performance_states ( aml_namespace & ns, aml_node * processor, performance_state * states, unsigned capacity ) -> unsigned ;
+
+  //! Processor power state, from _CST.
+
+  struct power_state
+  {
+    generic_address entry;
+    ps::size1       type;
+    ps::size2       latency;
+    ps::size4       power;
+  };
+
+  //! Collect processor power states; returns number found, which may exceed capacity.
+
+  auto power_states ( aml_namespace & ns, aml_node * processor, power_state * states, unsigned capacity ) -> unsigned ;
+
+  //! Sleep type values for PM1a and PM1b control SLP_TYP, from \_Sx.
+
+  struct sleep_type
+  {
+    ps::size1 a;
+    ps::size1 b;
+  };
+
+  //! Sleep type values for sleep state 0 to 5; not found if state is not supported.
+
+  auto sleep_type_of ( aml_namespace & ns, unsigned state, sleep_type & result ) -> aml_status ;
+}
+
+//! Inline procedure definitions
+
+namespace acpi
+{
+  inline
+  aml_arena::aml_arena ( void * memory, ps::size size ) :
+    _next { static_cast<ps::size1 *>(memory) },
+    _end { static_cast<ps::size1 *>(memory) + size }
+  { }
+
+  template <typename T>
+  inline
+  auto aml_arena::allocate ( ps::size count ) -> T *
+  {
+    auto const align = ps::size(alignof(T));
+    auto const next = (reinterpret_cast<ps::size>(_next) + align - 1) & ~(align - 1);
+    auto const end = reinterpret_cast<ps::size>(_end);
+    if (next > end || (end - next) / sizeof(T) < count) return nullptr;
+    auto const bytes = reinterpret_cast<ps::size1 *>(next);
+    _next = bytes + count * sizeof(T);
+    for (auto i = bytes; i != _next; ++i) *i = 0;
+    return reinterpret_cast<T *>(bytes);
+  }
+}
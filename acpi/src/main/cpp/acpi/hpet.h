@@ -0,0 +1,50 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <acpi/system_description.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace acpi
+{
+  //! High Precision Event Timer description
+
+  struct [[gnu::packed]] hpet_description
+  {
+    system_description base;
+
+    ps::size4       event_timer_block_id;
+    generic_address address;
+    ps::size1       number;
+    ps::size2       minimum_tick;
+    ps::size1       page_protection;
+  };
+
+  //! Number of comparators in the timer block.
+
+  auto comparators ( hpet_description const & x ) -> unsigned ;
+
+  //! Test if timer block is capable of legacy replacement routing.
+
+  auto is_legacy_capable ( hpet_description const & x ) -> bool ;
+}
+
+//! Inline procedure definitions
+
+namespace acpi
+{
+  inline
+  auto comparators ( hpet_description const & x ) -> unsigned
+  {
+    return ((x.event_timer_block_id >> 8) & 0x1F) + 1;
+  }
+
+  inline
+  auto is_legacy_capable ( hpet_description const & x ) -> bool
+  {
+    return (x.event_timer_block_id & (1 << 15)) != 0;
+  }
+}
@@ -0,0 +1,153 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <acpi/system_description.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace acpi
+{
+  //! Structure type and length for MADT entry type.
+
+  template <typename T> struct apic_structure_of;
+
+  template <> struct apic_structure_of<local_apic_description> { static constexpr auto type = apic_structure_type::local_apic; static constexpr ps::size1 length = 8; };
+  template <> struct apic_structure_of<io_apic_description> { static constexpr auto type = apic_structure_type::io_apic; static constexpr ps::size1 length = 12; };
+  template <> struct apic_structure_of<input_source_override_description> { static constexpr auto type = apic_structure_type::input_source_override; static constexpr ps::size1 length = 10; };
+  template <> struct apic_structure_of<nmi_source_description> { static constexpr auto type = apic_structure_type::non_maskable_interrupt; static constexpr ps::size1 length = 8; };
+  template <> struct apic_structure_of<local_apic_nmi_description> { static constexpr auto type = apic_structure_type::local_apic_nmi; static constexpr ps::size1 length = 6; };
+  template <> struct apic_structure_of<local_apic_override_description> { static constexpr auto type = apic_structure_type::local_apic_override; static constexpr ps::size1 length = 12; };
+  template <> struct apic_structure_of<local_x2apic_description> { static constexpr auto type = apic_structure_type::local_x2apic; static constexpr ps::size1 length = 16; };
+  template <> struct apic_structure_of<local_x2apic_nmi_description> { static constexpr auto type = apic_structure_type::local_x2apic_nmi; static constexpr ps::size1 length = 12; };
+
+  //! MADT entry as type, or null if entry has other type or is too short.
+
+  template <typename T>
+  auto apic_structure_cast ( apic_description const & x ) -> T const * ;
+
+  //! MADT entry iterator, over entries of type T, or all entries if T is apic_description.
+  //!
+  //! Iteration stops at the first malformed entry.
+
+  template <typename T>
+  class apic_iterator
+  {
+    ps::size1 const * _position;
+    ps::size1 const * _end;
+
+    void skip ()
+    {
+      while (_position != _end)
+      {
+        auto const entry = reinterpret_cast<apic_description const *>(_position);
+        auto const remaining = ps::size(_end - _position);
+        if (remaining < sizeof(apic_description) || entry->length < sizeof(apic_description) || entry->length > remaining) {
+          _position = _end;
+          return;
+        }
+        if constexpr (__is_same(T, apic_description)) return;
+        else if (apic_structure_cast<T>(*entry) != nullptr) return;
+        _position += entry->length;
+      }
+    }
+
+  public:
+
+    apic_iterator ( ps::size1 const * position, ps::size1 const * end ) : _position { position }, _end { end } { skip(); }
+
+    auto operator* () const -> T const & { return * reinterpret_cast<T const *>(_position); }
+
+    auto operator-> () const -> T const * { return reinterpret_cast<T const *>(_position); }
+
+    auto operator++ () -> apic_iterator &
+    {
+      _position += reinterpret_cast<apic_description const *>(_position)->length;
+      skip();
+      return *this;
+    }
+
+    auto operator== ( apic_iterator const & other ) const -> bool { return _position == other._position; }
+  };
+
+  //! MADT entries of type T, or all entries if T is apic_description.
+
+  template <typename T = apic_description>
+  class apic_structures
+  {
+    ps::size1 const * _begin;
+    ps::size1 const * _end;
+
+  public:
+
+    explicit
+    apic_structures ( apic_system_description const & x ) :
+      _begin { reinterpret_cast<ps::size1 const *>(& x) + sizeof(apic_system_description) },
+      _end { reinterpret_cast<ps::size1 const *>(& x) + x.base.length }
+    {
+      if (x.base.length < sizeof(apic_system_description)) _end = _begin;
+    }
+
+    auto begin () const -> apic_iterator<T> { return { _begin, _end }; }
+
+    auto end () const -> apic_iterator<T> { return { _end, _end }; }
+  };
+
+  //! Collect APIC ids of enabled processors, from local APIC and local x2APIC entries.
+  //!
+  //! Returns number of enabled processors, which may exceed capacity.
+
+  auto enabled_processors ( apic_system_description const & x, ps::size4 * ids, unsigned capacity ) -> unsigned ;
+
+  //! Local APIC physical address, with override applied.
+
+  auto local_apic_address ( apic_system_description const & x ) -> ps::size8 ;
+}
+
+//! Inline procedure definitions
+
+namespace acpi
+{
+  template <typename T>
+  inline
+  auto apic_structure_cast ( apic_description const & x ) -> T const *
+  {
+    if (x.type != ps::size1(apic_structure_of<T>::type)) return nullptr;
+    if (x.length < apic_structure_of<T>::length) return nullptr;
+    return reinterpret_cast<T const *>(& x);
+  }
+
+  inline
+  auto enabled_processors ( apic_system_description const & x, ps::size4 * ids, unsigned capacity ) -> unsigned
+  {
+    unsigned count = 0;
+    for (auto & entry : apic_structures<>(x))
+    {
+      ps::size4 id, flags;
+      if (auto const local = apic_structure_cast<local_apic_description>(entry)) {
+        id = local->id;
+        flags = local->flags;
+      }
+      else if (auto const local = apic_structure_cast<local_x2apic_description>(entry)) {
+        id = local->id;
+        flags = local->flags;
+      }
+      else continue;
+
+      if ((flags & 1) == 0) continue;
+      if (count < capacity) ids[count] = id;
+      ++count;
+    }
+    return count;
+  }
+
+  inline
+  auto local_apic_address ( apic_system_description const & x ) -> ps::size8
+  {
+    for (auto & entry : apic_structures<local_apic_override_description>(x))
+      return entry.address;
+    return x.local_apic_address;
+  }
+}
@@ -0,0 +1,68 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <acpi/system_description.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace acpi
+{
+  //! PCI Express memory mapped configuration space description
+
+  struct [[gnu::packed]] pci_configuration_description
+  {
+    system_description base;
+
+    ps::size8 reserved;
+  };
+
+  struct [[gnu::packed]] pci_segment_description
+  {
+    ps::size8 address;
+    ps::size2 segment;
+    ps::size1 start_bus;
+    ps::size1 end_bus;
+    ps::size4 reserved;
+  };
+
+  //! Enhanced configuration access mechanism region.
+  //!
+  //! Address is the physical address of bus zero, even if start bus is not zero.
+
+  struct pci_segment
+  {
+    ps::size8 address;
+    ps::size2 segment;
+    ps::size1 start_bus;
+    ps::size1 end_bus;
+  };
+
+  //! Collect configuration space regions; returns number found, which may exceed capacity.
+
+  auto pci_segments ( pci_configuration_description const & x, pci_segment * segments, unsigned capacity ) -> unsigned ;
+}
+
+//! Inline procedure definitions
+
+namespace acpi
+{
+  inline
+  auto pci_segments ( pci_configuration_description const & x, pci_segment * segments, unsigned capacity ) -> unsigned
+  {
+    if (x.base.length < sizeof(pci_configuration_description)) return 0;
+    auto const count = (x.base.length - sizeof(pci_configuration_description)) / sizeof(pci_segment_description);
+    auto const entries = reinterpret_cast<pci_segment_description const *>(reinterpret_cast<ps::size1 const *>(& x) + sizeof(pci_configuration_description));
+    unsigned found = 0;
+    for (unsigned i = 0; i != count; ++i)
+    {
+      auto const & entry = entries[i];
+      if (entry.end_bus < entry.start_bus) continue;
+      if (found < capacity) segments[found] = { entry.address, entry.segment, entry.start_bus, entry.end_bus };
+      ++found;
+    }
+    return found;
+  }
+}
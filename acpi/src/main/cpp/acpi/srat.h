@@ -0,0 +1,198 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <acpi/system_description.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace acpi
+{
+  //! System Resource Affinity Table
+
+  struct [[gnu::packed]] resource_affinity_description
+  {
+    system_description base;
+
+    ps::size4 reserved0;
+    ps::size8 reserved1;
+  };
+
+  enum class affinity_structure_type : ps::size1
+  {
+    processor = 0,
+    memory    = 1,
+    x2apic    = 2,
+  };
+
+  struct [[gnu::packed]] processor_affinity_description
+  {
+    ps::size1 type;
+    ps::size1 length;
+    ps::size1 domain_low;
+    ps::size1 apic_id;
+    ps::size4 flags;
+    ps::size1 sapic_eid;
+    ps::size1 domain_high [3];
+    ps::size4 clock_domain;
+  };
+
+  struct [[gnu::packed]] memory_affinity_description
+  {
+    ps::size1 type;
+    ps::size1 length;
+    ps::size4 domain;
+    ps::size2 reserved0;
+    ps::size4 base_low;
+    ps::size4 base_high;
+    ps::size4 length_low;
+    ps::size4 length_high;
+    ps::size4 reserved1;
+    ps::size4 flags;
+    ps::size8 reserved2;
+  };
+
+  struct [[gnu::packed]] x2apic_affinity_description
+  {
+    ps::size1 type;
+    ps::size1 length;
+    ps::size2 reserved0;
+    ps::size4 domain;
+    ps::size4 x2apic_id;
+    ps::size4 flags;
+    ps::size4 clock_domain;
+    ps::size4 reserved1;
+  };
+
+  //! System Locality Information Table
+
+  struct [[gnu::packed]] locality_description
+  {
+    system_description base;
+
+    ps::size8 count;
+    ps::size1 distances [];
+  };
+
+  //! Processor proximity domain.
+
+  struct processor_affinity
+  {
+    ps::size4 apic_id;
+    ps::size4 domain;
+  };
+
+  //! Memory range proximity domain.
+
+  struct memory_affinity
+  {
+    ps::size8 base;
+    ps::size8 length;
+    ps::size4 domain;
+    bool      hotplug;
+  };
+
+  //! Collect enabled processor affinities; returns number found, which may exceed capacity.
+
+  auto processor_affinities ( resource_affinity_description const & x, processor_affinity * affinities, unsigned capacity ) -> unsigned ;
+
+  //! Collect enabled memory affinities; returns number found, which may exceed capacity.
+
+  auto memory_affinities ( resource_affinity_description const & x, memory_affinity * affinities, unsigned capacity ) -> unsigned ;
+
+  //! Number of localities.
+
+  auto localities ( locality_description const & x ) -> unsigned ;
+
+  //! Relative distance from locality i to locality j; local distance is 10, unreachable is 255.
+
+  auto distance ( locality_description const & x, unsigned i, unsigned j ) -> ps::size1 ;
+}
+
+//! Inline procedure definitions
+
+namespace acpi
+{
+  inline
+  auto processor_affinities ( resource_affinity_description const & x, processor_affinity * affinities, unsigned capacity ) -> unsigned
+  {
+    unsigned count = 0;
+    auto i = reinterpret_cast<ps::size1 const *>(& x) + sizeof(resource_affinity_description);
+    auto const j = reinterpret_cast<ps::size1 const *>(& x) + x.base.length;
+    while (j - i >= 2 && i[1] >= 2 && i[1] <= j - i)
+    {
+      processor_affinity affinity {};
+      auto enabled = false;
+      if (i[0] == ps::size1(affinity_structure_type::processor) && i[1] >= sizeof(processor_affinity_description))
+      {
+        auto const entry = reinterpret_cast<processor_affinity_description const *>(i);
+        auto const domain = ps::size4{entry->domain_low}
+                          | ps::size4{entry->domain_high[0]} << 8
+                          | ps::size4{entry->domain_high[1]} << 16
+                          | ps::size4{entry->domain_high[2]} << 24;
+        affinity = { entry->apic_id, domain };
+        enabled = (entry->flags & 1) != 0;
+      }
+      else if (i[0] == ps::size1(affinity_structure_type::x2apic) && i[1] >= sizeof(x2apic_affinity_description))
+      {
+        auto const entry = reinterpret_cast<x2apic_affinity_description const *>(i);
+        affinity = { entry->x2apic_id, entry->domain };
+        enabled = (entry->flags & 1) != 0;
+      }
+
+      if (enabled) {
+        if (count < capacity) affinities[count] = affinity;
+        ++count;
+      }
+
+      i += i[1];
+    }
+    return count;
+  }
+
+  inline
+  auto memory_affinities ( resource_affinity_description const & x, memory_affinity * affinities, unsigned capacity ) -> unsigned
+  {
+    unsigned count = 0;
+    auto i = reinterpret_cast<ps::size1 const *>(& x) + sizeof(resource_affinity_description);
+    auto const j = reinterpret_cast<ps::size1 const *>(& x) + x.base.length;
+    while (j - i >= 2 && i[1] >= 2 && i[1] <= j - i)
+    {
+      if (i[0] == ps::size1(affinity_structure_type::memory) && i[1] >= sizeof(memory_affinity_description))
+      {
+        auto const entry = reinterpret_cast<memory_affinity_description const *>(i);
+        if ((entry->flags & 1) != 0)
+        {
+          if (count < capacity) {
+            affinities[count] = {
+              ps::size8{entry->base_high} << 32 | entry->base_low,
+              ps::size8{entry->length_high} << 32 | entry->length_low,
+              entry->domain,
+              (entry->flags & 2) != 0
+            };
+          }
+          ++count;
+        }
+      }
+      i += i[1];
+    }
+    return count;
+  }
+
+  inline
+  auto localities ( locality_description const & x ) -> unsigned
+  {
+    return x.count;
+  }
+
+  inline
+  auto distance ( locality_description const & x, unsigned i, unsigned j ) -> ps::size1
+  {
+    auto const n = localities(x);
+    if (i >= n || j >= n) return 255;
+    if (sizeof(locality_description) + ps::size8(n) * n > x.base.length) return i == j ? 10 : 20;
+    return x.distances[i * n + j];
+  }
+}
@@ -89,9 +89,18 @@ namespace acpi
 
   auto end ( wide_root_system_description const & x ) -> ps::size8 const * ;
 
+  //! Generic address space
+
+  enum class address_space : ps::size1
+  {
+    system_memory     = 0,
+    system_io         = 1,
+    pci_configuration = 2,
+  };
+
   //! Generic memory address
 
-  struct generic_address
+  struct [[gnu::packed]] generic_address
   {
     ps::size1  space;
     ps::size1  width;
@@ -102,7 +111,7 @@ namespace acpi
 
   //! Fixed System Description
 
-  struct fixed_system_description
+  struct [[gnu::packed]] fixed_system_description
   {
       system_description base;
 
@@ -162,6 +171,22 @@ namespace acpi
       generic_address X_GPE1Block;
   };
 
+  //! Power management timer register address, from X_PMTimerBlock if present, else PMTimerBlock.
+  //!
+  //! Address is zero if there is no power management timer.
+
+  auto pm_timer_address ( fixed_system_description const & x ) -> generic_address ;
+
+  //! True if power management timer counter is 32-bit wide, false if 24-bit wide.
+
+  auto is_pm_timer_32bit ( fixed_system_description const & x ) -> bool ;
+
+  //! Power management 1 control register address, from X_PM1xControlBlock if present, else PM1xControlBlock.
+  //!
+  //! Address is zero if there is no such register; block b is optional.
+
+  auto pm1_control_address ( fixed_system_description const & x, bool b = false ) -> generic_address ;
+
   //! Multiple APIC system description
 
   struct apic_system_description
@@ -178,7 +203,10 @@ namespace acpi
     io_apic                = 1,
     input_source_override  = 2,
     non_maskable_interrupt = 3,
-    local_apic_nmi         = 4
+    local_apic_nmi         = 4,
+    local_apic_override    = 5,
+    local_x2apic           = 9,
+    local_x2apic_nmi       = 10,
   };
 
   struct apic_description
@@ -224,7 +252,7 @@ namespace acpi
     ps::size4 global_system_interrupt_vector;
   };
 
-  struct local_apic_nmi_description
+  struct [[gnu::packed]] local_apic_nmi_description
   {
     apic_description base;
 
@@ -233,6 +261,34 @@ namespace acpi
     ps::size1  pin;
   };
 
+  struct [[gnu::packed]] local_apic_override_description
+  {
+    apic_description base;
+
+    ps::size2 reserved0;
+    ps::size8 address;
+  };
+
+  struct local_x2apic_description
+  {
+    apic_description base;
+
+    ps::size2 reserved0;
+    ps::size4 id;
+    ps::size4 flags;
+    ps::size4 processor;
+  };
+
+  struct local_x2apic_nmi_description
+  {
+    apic_description base;
+
+    ps::size2 flags;
+    ps::size4 processor;
+    ps::size1  pin;
+    ps::size1  reserved0 [3];
+  };
+
 }
 
 
@@ -334,5 +390,40 @@ namespace acpi
     return x.pointers + count;
   }
 
+  inline
+  auto pm_timer_address ( fixed_system_description const & x ) -> generic_address
+  {
+    constexpr auto extended = __builtin_offsetof(fixed_system_description, X_PMTimerBlock) + sizeof(generic_address);
+    if (x.base.length >= extended && x.X_PMTimerBlock.address != 0) {
+      return x.X_PMTimerBlock;
+    }
+    if (x.PMTimerLength < 4) {
+      return {};
+    }
+    return { ps::size1(address_space::system_io), 32, 0, 3, x.PMTimerBlock };
+  }
+
+  inline
+  auto is_pm_timer_32bit ( fixed_system_description const & x ) -> bool
+  {
+    constexpr auto flags = __builtin_offsetof(fixed_system_description, Flags) + sizeof(ps::size4);
+    return x.base.length >= flags && (x.Flags & (1 << 8)) != 0;
+  }
+
+  inline
+  auto pm1_control_address ( fixed_system_description const & x, bool b ) -> generic_address
+  {
+    constexpr auto extended = __builtin_offsetof(fixed_system_description, X_PM1bControlBlock) + sizeof(generic_address);
+    auto const & wide = b ? x.X_PM1bControlBlock : x.X_PM1aControlBlock;
+    if (x.base.length >= extended && wide.address != 0) {
+      return wide;
+    }
+    auto const narrow = b ? x.PM1bControlBlock : x.PM1aControlBlock;
+    if (x.PM1ControlLength < 2 || narrow == 0) {
+      return {};
+    }
+    return { ps::size1(address_space::system_io), 16, 0, 2, narrow };
+  }
+
 }
 
@@ -0,0 +1,282 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <acpi/system_description.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace acpi
+{
+  //! Sum of bytes, modulo 256; valid tables sum to zero.
+  //!
+  //! Sums eight bytes at a time in 16-bit lanes.
+
+  auto checksum ( void const * address, ps::size length ) -> ps::size1 ;
+
+  //! Table signature as little-endian integer.
+
+  constexpr
+  auto make_signature ( char const * signature ) -> ps::size4 ;
+
+  //! Table index entry.
+
+  struct table_entry
+  {
+    ps::size4 signature;
+    ps::size4 length;
+    ps::size8 address;
+  };
+
+  //! Range of table index entries.
+
+  struct table_range
+  {
+    table_entry const * first;
+    table_entry const * last;
+
+    auto begin () const -> table_entry const * { return first; }
+    auto end () const -> table_entry const * { return last; }
+    auto size () const -> unsigned { return last - first; }
+  };
+
+  //! System description table index.
+  //!
+  //! Built once from the root pointer: validates every table and sorts entries by signature;
+  //! lookup by signature hashes into the sorted array.
+  //! Tables are accessed at physical address plus mapping offset.
+
+  class table_index
+  {
+  public:
+
+    static constexpr unsigned capacity = 64;
+
+  private:
+
+    struct slot
+    {
+      ps::size4 signature;
+      ps::size1 first;
+      ps::size1 count;
+    };
+
+    static constexpr unsigned slots = 128;
+
+    table_entry _entries [capacity] {};
+    unsigned    _count {};
+    unsigned    _rejected {};
+    slot        _slots [slots] {};
+    ps::size    _mapping {};
+
+    static constexpr
+    auto hash ( ps::size4 signature ) -> unsigned
+    {
+      return (unsigned(signature) * 0x9E3779B1u) >> 25;
+    }
+
+    void add ( ps::size8 address ) ;
+
+    void build () ;
+
+  public:
+
+    //! Object
+    //! @{
+
+    constexpr
+    table_index () = default;
+
+    explicit
+    table_index ( root_system_description_pointer const & root, ps::size mapping = 0 ) ;
+
+    //! @}
+
+    //! Properties
+    //! @{
+
+    auto begin () const -> table_entry const * { return _entries; }
+
+    auto end () const -> table_entry const * { return _entries + _count; }
+
+    auto size () const -> unsigned { return _count; }
+
+    //! Number of tables rejected for invalid checksum or lack of capacity.
+
+    auto rejected () const -> unsigned { return _rejected; }
+
+    //! @}
+
+    //! Lookup
+    //! @{
+
+    //! All tables with signature.
+
+    auto find_all ( char const * signature ) const -> table_range ;
+
+    //! First table with signature, or null.
+
+    auto find ( char const * signature ) const -> system_description const * ;
+
+    //! Table for entry.
+
+    auto table ( table_entry const & entry ) const -> system_description const * ;
+
+    //! @}
+  };
+}
+
+//! Inline procedure definitions
+
+namespace acpi
+{
+  inline constexpr
+  auto make_signature ( char const * signature ) -> ps::size4
+  {
+    return ps::size4(ps::size1(signature[0]))
+         | ps::size4(ps::size1(signature[1])) << 8
+         | ps::size4(ps::size1(signature[2])) << 16
+         | ps::size4(ps::size1(signature[3])) << 24;
+  }
+
+  inline
+  auto checksum ( void const * address, ps::size length ) -> ps::size1
+  {
+    auto i = static_cast<ps::size1 const *>(address);
+    auto const e = i + length;
+
+    unsigned sum = 0;
+
+    // Head: bytes until word aligned.
+    for (; i != e && (reinterpret_cast<ps::size>(i) & 7) != 0; ++i) sum += *i;
+
+    // Body: each 16-bit lane accumulates at most 2 * 255 per word; fold before lanes overflow.
+    constexpr unsigned long long lanes = 0x00FF00FF00FF00FFULL;
+    while (e - i >= 8)
+    {
+      unsigned long long acc = 0;
+      for (unsigned n = 0; n != 128 && e - i >= 8; ++n, i += 8)
+      {
+        unsigned long long word;
+        __builtin_memcpy(&word, i, 8);
+        acc += (word & lanes) + ((word >> 8) & lanes);
+      }
+      acc = (acc & 0x0000FFFF0000FFFFULL) + ((acc >> 16) & 0x0000FFFF0000FFFFULL);
+      acc = acc + (acc >> 32);
+      sum += unsigned(acc);
+    }
+
+    // Tail.
+    for (; i != e; ++i) sum += *i;
+
+    return sum & 0xFF;
+  }
+
+  inline
+  table_index::table_index ( root_system_description_pointer const & root, ps::size mapping ) : _mapping { mapping }
+  {
+    if (root.revision >= 2 && root.extended_address != 0)
+    {
+      auto const xsdt = reinterpret_cast<wide_root_system_description const *>(ps::size(root.extended_address) + mapping);
+      if (checksum(xsdt, xsdt->header.length) == 0)
+      {
+        // Pointers in the XSDT are not naturally aligned.
+        auto const count = (xsdt->header.length - sizeof(system_description)) / 8;
+        auto const pointers = reinterpret_cast<ps::size1 const *>(xsdt) + sizeof(system_description);
+        for (unsigned i = 0; i != count; ++i)
+        {
+          ps::size8 address {};
+          __builtin_memcpy(&address, pointers + i * 8, 8);
+          add(address);
+        }
+        build();
+        return;
+      }
+    }
+
+    auto const rsdt = reinterpret_cast<narrow_root_system_description const *>(ps::size(root.address) + mapping);
+    if (checksum(rsdt, rsdt->header.length) == 0)
+    {
+      for (auto i = acpi::begin(*rsdt), j = acpi::end(*rsdt); i != j; ++i)
+        add(*i);
+    }
+    build();
+  }
+
+  inline
+  void table_index::add ( ps::size8 address )
+  {
+    if (address == 0) return;
+
+    auto const table = reinterpret_cast<system_description const *>(ps::size(address) + _mapping);
+    if (_count == capacity || table->length < sizeof(system_description) || checksum(table, table->length) != 0) {
+      ++_rejected;
+      return;
+    }
+
+    _entries[_count++] = { make_signature(table->signature), table->length, address };
+
+    // The DSDT is referenced by the FADT, not by the root table.
+    if (make_signature(table->signature) == make_signature("FACP"))
+    {
+      auto const fadt = reinterpret_cast<fixed_system_description const *>(table);
+      ps::size8 dsdt = fadt->Dsdt;
+      if (table->length >= __builtin_offsetof(fixed_system_description, X_Dsdt) + 8 && fadt->X_Dsdt != 0) dsdt = fadt->X_Dsdt;
+      add(dsdt);
+    }
+  }
+
+  inline
+  void table_index::build ()
+  {
+    // Insertion sort by signature is stable: tables with equal signature keep root table order.
+    for (unsigned i = 1; i < _count; ++i)
+    {
+      auto const entry = _entries[i];
+      auto j = i;
+      for (; j != 0 && _entries[j - 1].signature > entry.signature; --j)
+        _entries[j] = _entries[j - 1];
+      _entries[j] = entry;
+    }
+
+    for (unsigned i = 0; i != _count; )
+    {
+      auto j = i + 1;
+      while (j != _count && _entries[j].signature == _entries[i].signature) ++j;
+
+      auto h = hash(_entries[i].signature);
+      while (_slots[h].count != 0) h = (h + 1) % slots;
+      _slots[h] = { _entries[i].signature, ps::size1(i), ps::size1(j - i) };
+
+      i = j;
+    }
+  }
+
+  inline
+  auto table_index::find_all ( char const * signature ) const -> table_range
+  {
+    auto const key = make_signature(signature);
+    for (auto h = hash(key); _slots[h].count != 0; h = (h + 1) % slots)
+    {
+      if (_slots[h].signature == key)
+        return { _entries + _slots[h].first, _entries + _slots[h].first + _slots[h].count };
+    }
+    return { _entries, _entries };
+  }
+
+  inline
+  auto table_index::find ( char const * signature ) const -> system_description const *
+  {
+    auto const range = find_all(signature);
+    if (range.size() == 0) return nullptr;
+    return table(*range.first);
+  }
+
+  inline
+  auto table_index::table ( table_entry const & entry ) const -> system_description const *
+  {
+    return reinterpret_cast<system_description const *>(ps::size(entry.address) + _mapping);
+  }
+}
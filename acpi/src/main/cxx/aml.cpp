@@ -0,0 +1,1303 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#include <acpi/aml.h>
+
+namespace acpi
+{
+  namespace
+  {
+    using code = ps::size1 const *;
+
+    constexpr
+    auto is_lead ( ps::size1 c ) -> bool { return (c >= 'A' && c <= 'Z') || c == '_'; }
+
+    constexpr
+    auto is_name ( ps::size1 c ) -> bool { return is_lead(c) || c == '\\' || c == '^' || c == 0x2E || c == 0x2F; }
+
+    auto read ( code p, unsigned bytes ) -> ps::size8
+    {
+      ps::size8 value = 0;
+      for (unsigned i = 0; i != bytes; ++i) value |= ps::size8{p[i]} << (8 * i);
+      return value;
+    }
+
+    auto advance ( code & p, code end, ps::size count ) -> bool
+    {
+      if (ps::size(end - p) < count) return false;
+      p += count;
+      return true;
+    }
+
+    // Package length value; in field lists this is a bit count rather than an extent.
+
+    auto package_length ( code & p, code end, ps::size4 & length ) -> bool
+    {
+      if (p == end) return false;
+      auto const lead = *p++;
+      auto const extra = unsigned(lead >> 6);
+      if (extra == 0) {
+        length = lead & 0x3F;
+        return true;
+      }
+      if (ps::size(end - p) < extra) return false;
+      length = lead & 0x0F;
+      for (unsigned i = 0; i != extra; ++i) length |= ps::size4{*p++} << (4 + 8 * i);
+      return true;
+    }
+
+    // End of package whose length starts at p; advances p past the length.
+
+    auto package_end ( code & p, code end ) -> code
+    {
+      auto const start = p;
+      ps::size4 length;
+      if (! package_length(p, end, length)) return nullptr;
+      if (length < ps::size4(p - start) || length > ps::size(end - start)) return nullptr;
+      return start + length;
+    }
+
+    struct name_path
+    {
+      bool     absolute;
+      unsigned parents;
+      unsigned count;
+      code     segments;
+    };
+
+    auto parse_name ( code & p, code end, name_path & name ) -> bool
+    {
+      name = {};
+      if (p != end && *p == '\\') { name.absolute = true; ++p; }
+      else while (p != end && *p == '^') { ++name.parents; ++p; }
+      if (p == end) return false;
+      if (*p == 0x00) { ++p; name.count = 0; }
+      else if (*p == 0x2E) { ++p; name.count = 2; }
+      else if (*p == 0x2F) {
+        ++p;
+        if (p == end) return false;
+        name.count = *p++;
+      }
+      else name.count = 1;
+      name.segments = p;
+      return advance(p, end, name.count * 4);
+    }
+
+    auto segment ( name_path const & name, unsigned i ) -> ps::size4
+    {
+      return ps::size4(read(name.segments + i * 4, 4));
+    }
+
+    // Operand and target count of expression opcodes, or -1.
+
+    auto arity ( ps::size1 op ) -> int
+    {
+      switch (op)
+      {
+      case 0x71: case 0x75: case 0x76: case 0x83: case 0x87: case 0x8E: case 0x92:
+        return 1;
+      case 0x70: case 0x80: case 0x81: case 0x82: case 0x90: case 0x91: case 0x93: case 0x94: case 0x95:
+      case 0x96: case 0x97: case 0x98: case 0x99: case 0x9D:
+        return 2;
+      case 0x72: case 0x73: case 0x74: case 0x77: case 0x79: case 0x7A: case 0x7B: case 0x7C: case 0x7D:
+      case 0x7E: case 0x7F: case 0x84: case 0x85: case 0x88: case 0x9C:
+        return 3;
+      case 0x78: case 0x9E:
+        return 4;
+      default:
+        return -1;
+      }
+    }
+
+    // Skip term without evaluating; names are skipped without arguments.
+
+    auto skip ( code & p, code end ) -> bool
+    {
+      if (p == end) return false;
+      if (is_name(*p)) {
+        name_path name;
+        return parse_name(p, end, name);
+      }
+      auto const op = *p++;
+      switch (op)
+      {
+      case 0x00: case 0x01: case 0xFF:
+        return true;
+      case 0x0A:
+        return advance(p, end, 1);
+      case 0x0B:
+        return advance(p, end, 2);
+      case 0x0C:
+        return advance(p, end, 4);
+      case 0x0E:
+        return advance(p, end, 8);
+      case 0x0D:
+        while (p != end && *p != 0) ++p;
+        return advance(p, end, 1);
+      case 0x11: case 0x12: case 0x13: {
+        auto const block = package_end(p, end);
+        if (block == nullptr) return false;
+        p = block;
+        return true;
+      }
+      case 0x5B: {
+        if (p == end) return false;
+        auto const ext = *p++;
+        if (ext == 0x30 || ext == 0x31) return true;
+        if (ext == 0x12) return skip(p, end) && skip(p, end);
+        if (ext == 0x23) return skip(p, end) && advance(p, end, 2);
+        return false;
+      }
+      default:
+        if (op >= 0x60 && op <= 0x6E) return true;
+        auto const count = arity(op);
+        if (count < 0) return false;
+        for (int i = 0; i != count; ++i)
+          if (! skip(p, end)) return false;
+        return true;
+      }
+    }
+
+    auto make_integer ( ps::size8 value ) -> aml_value
+    {
+      aml_value result {};
+      result.type = aml_type::integer;
+      result.integer = value;
+      return result;
+    }
+
+    auto make_reference ( aml_node * node ) -> aml_value
+    {
+      aml_value result {};
+      result.type = aml_type::reference;
+      result.node = node;
+      return result;
+    }
+
+    auto to_integer ( aml_value const & value, ps::size8 & result ) -> bool
+    {
+      switch (value.type)
+      {
+      case aml_type::integer:
+        result = value.integer;
+        return true;
+      case aml_type::buffer:
+        result = read(value.data, value.length < 8 ? unsigned(value.length) : 8);
+        return true;
+      case aml_type::string: {
+        // Implicit conversion reads hexadecimal digits.
+        result = 0;
+        unsigned i = 0;
+        if (value.length >= 2 && value.data[0] == '0' && (value.data[1] == 'x' || value.data[1] == 'X')) i = 2;
+        for (; i < value.length; ++i) {
+          auto const c = value.data[i];
+          if (c >= '0' && c <= '9') result = (result << 4) | (c - '0');
+          else if (c >= 'a' && c <= 'f') result = (result << 4) | (c - 'a' + 10);
+          else if (c >= 'A' && c <= 'F') result = (result << 4) | (c - 'A' + 10);
+          else break;
+        }
+        return true;
+      }
+      default:
+        return false;
+      }
+    }
+
+    // Three-way comparison; false if operands are not comparable.
+
+    auto compare ( aml_value const & a, aml_value const & b, int & result ) -> bool
+    {
+      if (a.type == aml_type::integer) {
+        ps::size8 y;
+        if (! to_integer(b, y)) return false;
+        result = a.integer < y ? -1 : a.integer > y ? 1 : 0;
+        return true;
+      }
+      if ((a.type != aml_type::string && a.type != aml_type::buffer) || b.type != a.type) return false;
+      auto const length = a.length < b.length ? a.length : b.length;
+      for (ps::size4 i = 0; i != length; ++i) {
+        if (a.data[i] != b.data[i]) {
+          result = a.data[i] < b.data[i] ? -1 : 1;
+          return true;
+        }
+      }
+      result = a.length < b.length ? -1 : a.length > b.length ? 1 : 0;
+      return true;
+    }
+
+    auto make_segment ( char const * & path, ps::size4 & segment ) -> bool
+    {
+      segment = 0;
+      unsigned i = 0;
+      for (; i != 4 && *path != 0 && *path != '.'; ++i, ++path)
+        segment |= ps::size4(ps::size1(*path)) << (8 * i);
+      if (i == 0 || (*path != 0 && *path != '.')) return false;
+      for (; i != 4; ++i) segment |= ps::size4('_') << (8 * i);
+      if (*path == '.') ++path;
+      return true;
+    }
+  }
+
+  struct aml_interpreter
+  {
+    struct frame
+    {
+      aml_node * scope;
+      unsigned   depth;
+      aml_value  arguments [7];
+      aml_value  locals [8];
+      aml_value  result;
+      bool       returning;
+      bool       breaking;
+      bool       continuing;
+    };
+
+    aml_namespace & ns;
+
+    static
+    auto child ( aml_node const * scope, ps::size4 name ) -> aml_node *
+    {
+      for (auto i = scope->child; i != nullptr; i = i->sibling)
+        if (i->name == name) return i;
+      return nullptr;
+    }
+
+    auto create ( aml_node * scope, ps::size4 name, aml_object type ) -> aml_node *
+    {
+      if (auto const existing = child(scope, name)) {
+        // Scope placeholders become the object later defined there.
+        if (existing->type == aml_object::scope) existing->type = type;
+        return existing;
+      }
+      auto const node = ns._arena.allocate<aml_node>();
+      if (node == nullptr) return nullptr;
+      node->name = name;
+      node->type = type;
+      node->parent = scope;
+      auto link = & scope->child;
+      while (*link != nullptr) link = & (*link)->sibling;
+      *link = node;
+      ++ns._count;
+      pin();
+      return node;
+    }
+
+    // Keep arena memory allocated so far: namespace nodes and named values refer to it.
+
+    void pin ()
+    {
+      ns._pinned = ns._arena.mark();
+    }
+
+    auto start ( aml_node * scope, name_path const & name ) -> aml_node *
+    {
+      if (name.absolute) return ns._root;
+      for (unsigned i = 0; i != name.parents && scope != nullptr; ++i) scope = scope->parent;
+      return scope;
+    }
+
+    auto define ( aml_node * scope, name_path const & name, aml_object type ) -> aml_node *
+    {
+      scope = start(scope, name);
+      if (scope == nullptr || name.count == 0) return nullptr;
+      for (unsigned i = 0; i + 1 < name.count && scope != nullptr; ++i)
+        scope = create(scope, segment(name, i), aml_object::scope);
+      if (scope == nullptr) return nullptr;
+      return create(scope, segment(name, name.count - 1), type);
+    }
+
+    auto lookup ( aml_node * scope, name_path const & name ) -> aml_node *
+    {
+      if (name.count == 0) return nullptr;
+      if (! name.absolute && name.parents == 0 && name.count == 1) {
+        // Single segment names search enclosing scopes up to the root.
+        for (auto i = scope; i != nullptr; i = i->parent)
+          if (auto const found = child(i, segment(name, 0))) return found;
+        return nullptr;
+      }
+      scope = start(scope, name);
+      for (unsigned i = 0; i != name.count && scope != nullptr; ++i)
+        scope = child(scope, segment(name, i));
+      return scope;
+    }
+
+    // Loading.
+
+    auto load ( aml_node * scope, code p, code end ) -> aml_status
+    {
+      while (p != end)
+      {
+        auto const op = *p++;
+        name_path name;
+        switch (op)
+        {
+        case 0x10:   // Scope
+        case 0x14: { // Method
+          auto const block = package_end(p, end);
+          if (block == nullptr || ! parse_name(p, block, name)) return aml_status::malformed;
+          if (op == 0x10) {
+            auto const node = define(scope, name, aml_object::scope);
+            if (node == nullptr) return aml_status::exhausted;
+            auto const status = load(node, p, block);
+            if (status != aml_status::ok) return status;
+          }
+          else {
+            if (p == block) return aml_status::malformed;
+            auto const node = define(scope, name, aml_object::method);
+            if (node == nullptr) return aml_status::exhausted;
+            node->arguments = *p & 7;
+            node->code = p + 1;
+            node->end = block;
+          }
+          p = block;
+          break;
+        }
+        case 0x08: { // Name
+          if (! parse_name(p, end, name)) return aml_status::malformed;
+          auto const node = define(scope, name, aml_object::name);
+          if (node == nullptr) return aml_status::exhausted;
+          node->code = p;
+          if (! skip(p, end)) return aml_status::malformed;
+          node->end = p;
+          break;
+        }
+        case 0x06: { // Alias
+          auto const source = p;
+          if (! parse_name(p, end, name) || ! parse_name(p, end, name)) return aml_status::malformed;
+          auto const node = define(scope, name, aml_object::alias);
+          if (node == nullptr) return aml_status::exhausted;
+          node->code = source;
+          node->end = p;
+          break;
+        }
+        case 0x15: { // External
+          if (! parse_name(p, end, name) || ! advance(p, end, 2)) return aml_status::malformed;
+          break;
+        }
+        case 0xA0:   // If
+        case 0xA1: { // Else
+          auto const block = package_end(p, end);
+          if (block == nullptr) return aml_status::malformed;
+          p = block;
+          break;
+        }
+        case 0x8A: case 0x8B: case 0x8C: case 0x8D: case 0x8F: { // Create*Field
+          if (! skip(p, end) || ! skip(p, end) || ! parse_name(p, end, name)) return aml_status::malformed;
+          if (define(scope, name, aml_object::field) == nullptr) return aml_status::exhausted;
+          break;
+        }
+        case 0x5B: {
+          if (p == end) return aml_status::malformed;
+          auto const status = load_extended(scope, p, end);
+          if (status != aml_status::ok) return status;
+          break;
+        }
+        default:
+          return aml_status::unsupported;
+        }
+      }
+      return aml_status::ok;
+    }
+
+    auto load_extended ( aml_node * scope, code & p, code end ) -> aml_status
+    {
+      auto const op = *p++;
+      name_path name;
+      switch (op)
+      {
+      case 0x01:   // Mutex
+      case 0x02: { // Event
+        if (! parse_name(p, end, name)) return aml_status::malformed;
+        if (op == 0x01 && ! advance(p, end, 1)) return aml_status::malformed;
+        if (define(scope, name, op == 0x01 ? aml_object::mutex : aml_object::event) == nullptr) return aml_status::exhausted;
+        return aml_status::ok;
+      }
+      case 0x13: { // CreateField
+        if (! skip(p, end) || ! skip(p, end) || ! skip(p, end) || ! parse_name(p, end, name)) return aml_status::malformed;
+        if (define(scope, name, aml_object::field) == nullptr) return aml_status::exhausted;
+        return aml_status::ok;
+      }
+      case 0x80: { // OperationRegion
+        if (! parse_name(p, end, name) || ! advance(p, end, 1) || ! skip(p, end) || ! skip(p, end)) return aml_status::malformed;
+        if (define(scope, name, aml_object::region) == nullptr) return aml_status::exhausted;
+        return aml_status::ok;
+      }
+      case 0x81:   // Field
+      case 0x86:   // IndexField
+      case 0x87: { // BankField
+        auto const block = package_end(p, end);
+        if (block == nullptr || ! parse_name(p, block, name)) return aml_status::malformed;
+        if (op != 0x81 && ! parse_name(p, block, name)) return aml_status::malformed;
+        if (op == 0x87 && ! skip(p, block)) return aml_status::malformed;
+        if (! advance(p, block, 1)) return aml_status::malformed;
+        auto const status = load_fields(scope, p, block);
+        p = block;
+        return status;
+      }
+      case 0x82:   // Device
+      case 0x83:   // Processor
+      case 0x84:   // PowerResource
+      case 0x85: { // ThermalZone
+        auto const block = package_end(p, end);
+        if (block == nullptr || ! parse_name(p, block, name)) return aml_status::malformed;
+        auto type = aml_object::device;
+        if (op == 0x83) {
+          type = aml_object::processor;
+          if (! advance(p, block, 6)) return aml_status::malformed;
+        }
+        else if (op == 0x84) {
+          type = aml_object::power_resource;
+          if (! advance(p, block, 3)) return aml_status::malformed;
+        }
+        else if (op == 0x85) type = aml_object::thermal_zone;
+        auto const node = define(scope, name, type);
+        if (node == nullptr) return aml_status::exhausted;
+        auto const status = load(node, p, block);
+        p = block;
+        return status;
+      }
+      default:
+        return aml_status::unsupported;
+      }
+    }
+
+    auto load_fields ( aml_node * scope, code p, code end ) -> aml_status
+    {
+      while (p != end)
+      {
+        ps::size4 length;
+        auto const op = *p;
+        if (op == 0x00) { // ReservedField
+          ++p;
+          if (! package_length(p, end, length)) return aml_status::malformed;
+        }
+        else if (op == 0x01) { // AccessField
+          if (! advance(p, end, 3)) return aml_status::malformed;
+        }
+        else if (op == 0x03) { // ExtendedAccessField
+          if (! advance(p, end, 4)) return aml_status::malformed;
+        }
+        else if (op == 0x02) { // ConnectField
+          ++p;
+          if (! skip(p, end)) return aml_status::malformed;
+        }
+        else if (is_lead(op)) { // NamedField
+          name_path name { false, 0, 1, p };
+          if (! advance(p, end, 4) || ! package_length(p, end, length)) return aml_status::malformed;
+          if (define(scope, name, aml_object::field) == nullptr) return aml_status::exhausted;
+        }
+        else return aml_status::malformed;
+      }
+      return aml_status::ok;
+    }
+
+    // Evaluation.
+
+    auto step () -> bool
+    {
+      if (ns._steps == 0) return false;
+      --ns._steps;
+      return true;
+    }
+
+    auto integer ( frame & f, code & p, code end, ps::size8 & result ) -> aml_status
+    {
+      aml_value value;
+      auto const status = term(f, p, end, value);
+      if (status != aml_status::ok) return status;
+      if (! to_integer(value, result)) return aml_status::unsupported;
+      result &= ns._ones;
+      return aml_status::ok;
+    }
+
+    auto resolve ( aml_node * node ) -> aml_node *
+    {
+      for (unsigned i = 0; node != nullptr && node->type == aml_object::alias && i != 8; ++i) {
+        auto p = node->code;
+        name_path name;
+        if (! parse_name(p, node->end, name)) return nullptr;
+        node = lookup(node->parent, name);
+      }
+      if (node != nullptr && node->type == aml_object::alias) return nullptr;
+      return node;
+    }
+
+    auto invoke ( aml_node * method, aml_value const * arguments, unsigned count, aml_value & result, unsigned depth ) -> aml_status
+    {
+      if (depth >= aml_namespace::max_depth) return aml_status::exhausted;
+      frame f {};
+      f.scope = method;
+      f.depth = depth;
+      for (unsigned i = 0; i != count && i != 7; ++i) f.arguments[i] = arguments[i];
+      auto const status = execute(f, method->code, method->end);
+      if (status != aml_status::ok) return status;
+      result = f.returning ? f.result : aml_value {};
+      return aml_status::ok;
+    }
+
+    auto object ( aml_node * node, aml_value & result, unsigned depth ) -> aml_status
+    {
+      node = resolve(node);
+      if (node == nullptr) return aml_status::not_found;
+      switch (node->type)
+      {
+      case aml_object::method:
+        return invoke(node, nullptr, 0, result, depth);
+      case aml_object::name: {
+        if (node->value != nullptr) {
+          result = *node->value;
+          return aml_status::ok;
+        }
+        if (depth >= aml_namespace::max_depth) return aml_status::exhausted;
+        frame f {};
+        f.scope = node->parent;
+        f.depth = depth;
+        auto p = node->code;
+        auto const status = term(f, p, node->end, result);
+        if (status != aml_status::ok) return status;
+        // Named objects hold data: keep the value instead of building it again on every lookup.
+        node->value = ns._arena.allocate<aml_value>();
+        if (node->value != nullptr) {
+          *node->value = result;
+          pin();
+        }
+        return aml_status::ok;
+      }
+      case aml_object::field:
+      case aml_object::region:
+        return aml_status::unsupported;
+      default:
+        result = make_reference(node);
+        return aml_status::ok;
+      }
+    }
+
+    auto execute ( frame & f, code p, code end ) -> aml_status
+    {
+      while (p != end && ! f.returning && ! f.breaking && ! f.continuing)
+      {
+        if (! step()) return aml_status::exhausted;
+        auto status = aml_status::ok;
+        switch (*p)
+        {
+        case 0xA3: // Noop
+          ++p;
+          break;
+        case 0xA4: // Return
+          ++p;
+          status = term(f, p, end, f.result);
+          f.returning = true;
+          break;
+        case 0xA5: // Break
+          ++p;
+          f.breaking = true;
+          break;
+        case 0x9F: // Continue
+          ++p;
+          f.continuing = true;
+          break;
+        case 0xA0: // If
+          status = execute_if(f, p, end);
+          break;
+        case 0xA2: // While
+          status = execute_while(f, p, end);
+          break;
+        case 0x86: { // Notify
+          ++p;
+          aml_value value;
+          if (! skip(p, end)) return aml_status::malformed;
+          status = term(f, p, end, value);
+          break;
+        }
+        case 0x08: { // Name, defined at run time
+          ++p;
+          name_path name;
+          if (! parse_name(p, end, name)) return aml_status::malformed;
+          auto const node = define(f.scope, name, aml_object::name);
+          if (node == nullptr) return aml_status::exhausted;
+          if (node->value == nullptr) node->value = ns._arena.allocate<aml_value>();
+          if (node->value == nullptr) return aml_status::exhausted;
+          status = term(f, p, end, *node->value);
+          pin();
+          break;
+        }
+        case 0x5B: {
+          if (end - p < 2) return aml_status::malformed;
+          auto const ext = p[1];
+          if (ext == 0x21 || ext == 0x22) { // Stall, Sleep: no hardware to wait for
+            p += 2;
+            ps::size8 ignore;
+            status = integer(f, p, end, ignore);
+          }
+          else if (ext == 0x24 || ext == 0x26 || ext == 0x27) { // Signal, Reset, Release: evaluation is single threaded
+            p += 2;
+            if (! skip(p, end)) return aml_status::malformed;
+          }
+          else {
+            aml_value ignore;
+            status = term(f, p, end, ignore);
+          }
+          break;
+        }
+        default: {
+          aml_value ignore;
+          status = term(f, p, end, ignore);
+          break;
+        }
+        }
+        if (status != aml_status::ok) return status;
+      }
+      return aml_status::ok;
+    }
+
+    auto execute_if ( frame & f, code & p, code end ) -> aml_status
+    {
+      ++p;
+      auto const block = package_end(p, end);
+      if (block == nullptr) return aml_status::malformed;
+      ps::size8 predicate;
+      auto status = integer(f, p, block, predicate);
+      if (status != aml_status::ok) return status;
+      auto const body = p;
+      p = block;
+
+      code alternative = nullptr, alternative_end = nullptr;
+      if (p != end && *p == 0xA1) {
+        ++p;
+        alternative_end = package_end(p, end);
+        if (alternative_end == nullptr) return aml_status::malformed;
+        alternative = p;
+        p = alternative_end;
+      }
+
+      if (predicate != 0) return execute(f, body, block);
+      if (alternative != nullptr) return execute(f, alternative, alternative_end);
+      return aml_status::ok;
+    }
+
+    auto execute_while ( frame & f, code & p, code end ) -> aml_status
+    {
+      ++p;
+      auto const block = package_end(p, end);
+      if (block == nullptr) return aml_status::malformed;
+      auto const condition = p;
+      p = block;
+      while (true)
+      {
+        if (! step()) return aml_status::exhausted;
+        auto q = condition;
+        ps::size8 predicate;
+        auto const status = integer(f, q, block, predicate);
+        if (status != aml_status::ok) return status;
+        if (predicate == 0) return aml_status::ok;
+        auto const result = execute(f, q, block);
+        if (result != aml_status::ok) return result;
+        f.continuing = false;
+        if (f.breaking) { f.breaking = false; return aml_status::ok; }
+        if (f.returning) return aml_status::ok;
+      }
+    }
+
+    auto store ( frame & f, code & p, code end, aml_value const & value ) -> aml_status
+    {
+      if (p == end) return aml_status::malformed;
+      auto const op = *p;
+      if (op == 0x00) { ++p; return aml_status::ok; }
+      if (op >= 0x60 && op <= 0x67) { ++p; f.locals[op - 0x60] = value; return aml_status::ok; }
+      if (op >= 0x68 && op <= 0x6E) { ++p; f.arguments[op - 0x68] = value; return aml_status::ok; }
+      if (op == 0x5B && end - p >= 2 && p[1] == 0x31) { p += 2; return aml_status::ok; }
+      if (! is_name(op)) return aml_status::unsupported;
+
+      name_path name;
+      if (! parse_name(p, end, name)) return aml_status::malformed;
+      auto const node = resolve(lookup(f.scope, name));
+      if (node == nullptr) return aml_status::not_found;
+      if (node->type != aml_object::name) return aml_status::unsupported;
+      if (node->value == nullptr) node->value = ns._arena.allocate<aml_value>();
+      if (node->value == nullptr) return aml_status::exhausted;
+      *node->value = value;
+      pin();
+      return aml_status::ok;
+    }
+
+    auto reference ( frame & f, code & p, code end, aml_value & result ) -> aml_status
+    {
+      name_path name;
+      if (! parse_name(p, end, name)) return aml_status::malformed;
+      auto const node = resolve(lookup(f.scope, name));
+      if (node == nullptr) return aml_status::not_found;
+      if (node->type != aml_object::method) return object(node, result, f.depth);
+
+      aml_value arguments [7] {};
+      for (unsigned i = 0; i != node->arguments; ++i) {
+        auto const status = term(f, p, end, arguments[i]);
+        if (status != aml_status::ok) return status;
+      }
+      return invoke(node, arguments, node->arguments, result, f.depth + 1);
+    }
+
+    auto buffer ( frame & f, code & p, code end, aml_value & result ) -> aml_status
+    {
+      auto const block = package_end(p, end);
+      if (block == nullptr) return aml_status::malformed;
+      ps::size8 size;
+      auto const status = integer(f, p, block, size);
+      if (status != aml_status::ok) return status;
+      auto const initializer = ps::size8(block - p);
+      result = {};
+      result.type = aml_type::buffer;
+      result.length = ps::size4(size);
+      if (size == initializer) result.data = p;
+      else {
+        // Declared size differs from initializer: copy into zero filled arena memory.
+        auto const data = ns._arena.allocate<ps::size1>(ps::size(size));
+        if (data == nullptr) return aml_status::exhausted;
+        for (ps::size8 i = 0; i != size && i != initializer; ++i) data[i] = p[i];
+        result.data = data;
+      }
+      p = block;
+      return aml_status::ok;
+    }
+
+    auto package ( frame & f, code & p, code end, bool variable, aml_value & result ) -> aml_status
+    {
+      auto const block = package_end(p, end);
+      if (block == nullptr) return aml_status::malformed;
+      ps::size8 count;
+      if (variable) {
+        auto const status = integer(f, p, block, count);
+        if (status != aml_status::ok) return status;
+      }
+      else {
+        if (p == block) return aml_status::malformed;
+        count = *p++;
+      }
+      if (count > 0xFFFF) return aml_status::unsupported;
+
+      auto const elements = ns._arena.allocate<aml_value>(ps::size(count));
+      if (elements == nullptr && count != 0) return aml_status::exhausted;
+      for (ps::size8 i = 0; p != block; ++i)
+      {
+        if (i == count) return aml_status::malformed;
+        if (is_name(*p)) {
+          // Names in packages are references, resolved but not evaluated.
+          name_path name;
+          if (! parse_name(p, block, name)) return aml_status::malformed;
+          elements[i] = make_reference(resolve(lookup(f.scope, name)));
+        }
+        else {
+          auto const status = term(f, p, block, elements[i]);
+          if (status != aml_status::ok) return status;
+        }
+      }
+
+      result = {};
+      result.type = aml_type::package;
+      result.length = ps::size4(count);
+      result.elements = elements;
+      p = block;
+      return aml_status::ok;
+    }
+
+    auto binary ( frame & f, ps::size1 op, code & p, code end, aml_value & result ) -> aml_status
+    {
+      ps::size8 a, b;
+      auto status = integer(f, p, end, a);
+      if (status != aml_status::ok) return status;
+      status = integer(f, p, end, b);
+      if (status != aml_status::ok) return status;
+
+      ps::size8 value;
+      switch (op)
+      {
+      case 0x72: value = a + b; break;
+      case 0x74: value = a - b; break;
+      case 0x77: value = a * b; break;
+      case 0x79: value = b < 64 ? a << b : 0; break;
+      case 0x7A: value = b < 64 ? a >> b : 0; break;
+      case 0x7B: value = a & b; break;
+      case 0x7C: value = ~(a & b); break;
+      case 0x7D: value = a | b; break;
+      case 0x7E: value = ~(a | b); break;
+      case 0x7F: value = a ^ b; break;
+      case 0x85:
+        if (b == 0) return aml_status::malformed;
+        value = a % b;
+        break;
+      default: return aml_status::unsupported;
+      }
+
+      result = make_integer(value & ns._ones);
+      return store(f, p, end, result);
+    }
+
+    auto logical ( frame & f, ps::size1 op, code & p, code end, aml_value & result ) -> aml_status
+    {
+      bool value;
+      if (op == 0x90 || op == 0x91) {
+        ps::size8 a, b;
+        auto status = integer(f, p, end, a);
+        if (status != aml_status::ok) return status;
+        status = integer(f, p, end, b);
+        if (status != aml_status::ok) return status;
+        value = op == 0x90 ? (a != 0 && b != 0) : (a != 0 || b != 0);
+      }
+      else {
+        aml_value a, b;
+        auto status = term(f, p, end, a);
+        if (status != aml_status::ok) return status;
+        status = term(f, p, end, b);
+        if (status != aml_status::ok) return status;
+        int order;
+        if (! compare(a, b, order)) return aml_status::unsupported;
+        value = op == 0x93 ? order == 0 : op == 0x94 ? order > 0 : order < 0;
+      }
+      result = make_integer(value ? ns._ones : 0);
+      return aml_status::ok;
+    }
+
+    auto index ( frame & f, code & p, code end, aml_value & result ) -> aml_status
+    {
+      aml_value source;
+      auto status = term(f, p, end, source);
+      if (status != aml_status::ok) return status;
+      ps::size8 i;
+      status = integer(f, p, end, i);
+      if (status != aml_status::ok) return status;
+      if (i >= source.length) return aml_status::malformed;
+      switch (source.type)
+      {
+      case aml_type::package:
+        result = source.elements[i];
+        break;
+      case aml_type::buffer:
+      case aml_type::string:
+        result = make_integer(source.data[i]);
+        break;
+      default:
+        return aml_status::unsupported;
+      }
+      return store(f, p, end, result);
+    }
+
+    auto term ( frame & f, code & p, code end, aml_value & result ) -> aml_status
+    {
+      if (p == end) return aml_status::malformed;
+      if (! step()) return aml_status::exhausted;
+      if (is_name(*p)) return reference(f, p, end, result);
+
+      auto const op = *p++;
+      switch (op)
+      {
+      case 0x00: result = make_integer(0); return aml_status::ok;
+      case 0x01: result = make_integer(1); return aml_status::ok;
+      case 0xFF: result = make_integer(ns._ones); return aml_status::ok;
+      case 0x0A: case 0x0B: case 0x0C: case 0x0E: {
+        auto const bytes = op == 0x0A ? 1u : op == 0x0B ? 2u : op == 0x0C ? 4u : 8u;
+        if (ps::size(end - p) < bytes) return aml_status::malformed;
+        result = make_integer(read(p, bytes));
+        p += bytes;
+        return aml_status::ok;
+      }
+      case 0x0D: { // String
+        auto const start = p;
+        while (p != end && *p != 0) ++p;
+        if (p == end) return aml_status::malformed;
+        result = {};
+        result.type = aml_type::string;
+        result.data = start;
+        result.length = ps::size4(p - start);
+        ++p;
+        return aml_status::ok;
+      }
+      case 0x11:
+        return buffer(f, p, end, result);
+      case 0x12:
+      case 0x13:
+        return package(f, p, end, op == 0x13, result);
+      case 0x70: { // Store
+        auto const status = term(f, p, end, result);
+        if (status != aml_status::ok) return status;
+        return store(f, p, end, result);
+      }
+      case 0x72: case 0x74: case 0x77: case 0x79: case 0x7A: case 0x7B: case 0x7C: case 0x7D: case 0x7E: case 0x7F: case 0x85:
+        return binary(f, op, p, end, result);
+      case 0x75:   // Increment
+      case 0x76: { // Decrement
+        auto target = p;
+        ps::size8 value;
+        auto const status = integer(f, p, end, value);
+        if (status != aml_status::ok) return status;
+        result = make_integer((op == 0x75 ? value + 1 : value - 1) & ns._ones);
+        return store(f, target, end, result);
+      }
+      case 0x78: { // Divide
+        ps::size8 a, b;
+        auto status = integer(f, p, end, a);
+        if (status != aml_status::ok) return status;
+        status = integer(f, p, end, b);
+        if (status != aml_status::ok) return status;
+        if (b == 0) return aml_status::malformed;
+        status = store(f, p, end, make_integer(a % b));
+        if (status != aml_status::ok) return status;
+        result = make_integer(a / b);
+        return store(f, p, end, result);
+      }
+      case 0x80: { // Not
+        ps::size8 value;
+        auto const status = integer(f, p, end, value);
+        if (status != aml_status::ok) return status;
+        result = make_integer(~value & ns._ones);
+        return store(f, p, end, result);
+      }
+      case 0x83: // DerefOf: Index yields the element itself
+        return term(f, p, end, result);
+      case 0x87: { // SizeOf
+        aml_value value;
+        auto const status = term(f, p, end, value);
+        if (status != aml_status::ok) return status;
+        if (value.type != aml_type::string && value.type != aml_type::buffer && value.type != aml_type::package) return aml_status::unsupported;
+        result = make_integer(value.length);
+        return aml_status::ok;
+      }
+      case 0x88:
+        return index(f, p, end, result);
+      case 0x90: case 0x91: case 0x93: case 0x94: case 0x95:
+        return logical(f, op, p, end, result);
+      case 0x92: { // LNot
+        ps::size8 value;
+        auto const status = integer(f, p, end, value);
+        if (status != aml_status::ok) return status;
+        result = make_integer(value == 0 ? ns._ones : 0);
+        return aml_status::ok;
+      }
+      case 0x99: { // ToInteger
+        ps::size8 value;
+        auto const status = integer(f, p, end, value);
+        if (status != aml_status::ok) return status;
+        result = make_integer(value);
+        return store(f, p, end, result);
+      }
+      case 0x5B: {
+        if (p == end) return aml_status::malformed;
+        auto const ext = *p++;
+        if (ext == 0x12) { // CondRefOf
+          name_path name;
+          if (! parse_name(p, end, name) || ! skip(p, end)) return aml_status::malformed;
+          result = make_integer(lookup(f.scope, name) != nullptr ? ns._ones : 0);
+          return aml_status::ok;
+        }
+        if (ext == 0x23) { // Acquire: evaluation is single threaded, always succeeds
+          if (! skip(p, end) || ! advance(p, end, 2)) return aml_status::malformed;
+          result = make_integer(0);
+          return aml_status::ok;
+        }
+        if (ext == 0x30) { // Revision
+          result = make_integer(2);
+          return aml_status::ok;
+        }
+        return aml_status::unsupported;
+      }
+      default:
+        if (op >= 0x60 && op <= 0x67) { result = f.locals[op - 0x60]; return aml_status::ok; }
+        if (op >= 0x68 && op <= 0x6E) { result = f.arguments[op - 0x68]; return aml_status::ok; }
+        return aml_status::unsupported;
+      }
+    }
+  };
+
+  aml_namespace::aml_namespace ( void * memory, ps::size size ) : _arena { memory, size }
+  {
+    _root = _arena.allocate<aml_node>();
+    if (_root == nullptr) return;
+    _root->name = '\\' | ps::size4('_') << 8 | ps::size4('_') << 16 | ps::size4('_') << 24;
+    _root->type = aml_object::scope;
+    _count = 1;
+
+    char const * const predefined [] { "_GPE", "_PR_", "_SB_", "_SI_", "_TZ_" };
+    aml_interpreter interpreter { *this };
+    for (auto path : predefined) {
+      ps::size4 name;
+      make_segment(path, name);
+      interpreter.create(_root, name, aml_object::scope);
+    }
+  }
+
+  auto aml_namespace::load ( system_description const & table ) -> aml_status
+  {
+    if (_root == nullptr) return aml_status::exhausted;
+    if (table.length < sizeof(system_description)) return aml_status::malformed;
+    auto const dsdt = table.signature[0] == 'D' && table.signature[1] == 'S' && table.signature[2] == 'D' && table.signature[3] == 'T';
+    if (dsdt && table.revision < 2) _ones = 0xFFFFFFFF;
+    auto const begin = reinterpret_cast<ps::size1 const *>(& table);
+    aml_interpreter interpreter { *this };
+    return interpreter.load(_root, begin + sizeof(system_description), begin + table.length);
+  }
+
+  auto aml_namespace::find ( char const * path, aml_node const * scope ) const -> aml_node *
+  {
+    auto node = const_cast<aml_node *>(scope != nullptr ? scope : _root);
+    if (*path == '\\') {
+      node = _root;
+      ++path;
+    }
+    while (*path == '^' && node != nullptr) {
+      node = node->parent;
+      ++path;
+    }
+    while (*path != 0 && node != nullptr) {
+      ps::size4 name;
+      if (! make_segment(path, name)) return nullptr;
+      node = aml_interpreter::child(node, name);
+    }
+    return node;
+  }
+
+  auto aml_namespace::evaluate ( aml_node * node, aml_value & result, aml_value const * arguments, unsigned count ) -> aml_status
+  {
+    if (node == nullptr) return aml_status::not_found;
+    _steps = max_steps;
+    aml_interpreter interpreter { *this };
+    node = interpreter.resolve(node);
+    if (node == nullptr) return aml_status::not_found;
+    if (node->type == aml_object::method) return interpreter.invoke(node, arguments, count, result, 0);
+    return interpreter.object(node, result, 0);
+  }
+
+  auto aml_namespace::evaluate ( aml_node const * scope, char const * path, aml_value & result ) -> aml_status
+  {
+    return evaluate(find(path, scope), result);
+  }
+
+  auto device_status ( aml_namespace & ns, aml_node * device ) -> ps::size4
+  {
+    auto const node = ns.find("_STA", device);
+    if (node == nullptr) return 0x0F;
+    auto const mark = ns.arena().mark();
+    aml_value value;
+    auto const status = ns.evaluate(node, value);
+    ns.release(mark);
+    if (status != aml_status::ok || value.type != aml_type::integer) return 0;
+    return ps::size4(value.integer);
+  }
+
+  auto pci_routes ( aml_namespace & ns, aml_node * bridge, pci_route * routes, unsigned capacity ) -> unsigned
+  {
+    auto const mark = ns.arena().mark();
+    aml_value table;
+    if (ns.evaluate(bridge, "_PRT", table) != aml_status::ok || table.type != aml_type::package) {
+      ns.release(mark);
+      return 0;
+    }
+
+    unsigned count = 0;
+    for (ps::size4 i = 0; i != table.length; ++i)
+    {
+      auto const & entry = table.elements[i];
+      if (entry.type != aml_type::package || entry.length < 4) continue;
+      auto const & address = entry.elements[0];
+      auto const & pin = entry.elements[1];
+      auto const & source = entry.elements[2];
+      auto const & index = entry.elements[3];
+      if (address.type != aml_type::integer || pin.type != aml_type::integer || index.type != aml_type::integer) continue;
+      if (source.type != aml_type::integer && (source.type != aml_type::reference || source.node == nullptr)) continue;
+
+      if (count < capacity) {
+        routes[count] = {
+          ps::size4(address.integer),
+          ps::size1(pin.integer),
+          source.type == aml_type::reference ? source.node : nullptr,
+          ps::size4(index.integer)
+        };
+      }
+      ++count;
+    }
+    ns.release(mark);
+    return count;
+  }
+
+  auto current_resources ( aml_namespace & ns, aml_node * device, aml_value & result ) -> aml_status
+  {
+    auto const status = ns.evaluate(device, "_CRS", result);
+    if (status != aml_status::ok) return status;
+    if (result.type != aml_type::buffer) return aml_status::malformed;
+    return aml_status::ok;
+  }
+
+  auto resources ( aml_value const & buffer, aml_resource * descriptors, unsigned capacity ) -> unsigned
+  {
+    if (buffer.type != aml_type::buffer) return 0;
+
+    unsigned count = 0;
+    auto p = buffer.data;
+    auto const end = buffer.data + buffer.length;
+    while (p != end)
+    {
+      aml_resource descriptor;
+      if ((*p & 0x80) == 0) {
+        descriptor = { resource_type((*p >> 3) & 0x0F), ps::size2(*p & 0x07), p + 1 };
+        if (descriptor.type == resource_type::end) break;
+      }
+      else {
+        if (end - p < 3) break;
+        descriptor = { resource_type(*p), ps::size2(read(p + 1, 2)), p + 3 };
+      }
+      if (descriptor.length > ps::size(end - descriptor.data)) break;
+
+      if (count < capacity) descriptors[count] = descriptor;
+      ++count;
+      p = descriptor.data + descriptor.length;
+    }
+    return count;
+  }
+
+  auto resource_interrupts ( aml_resource const & x, ps::size4 * interrupts, unsigned capacity ) -> unsigned
+  {
+    unsigned count = 0;
+    if (x.type == resource_type::irq && x.length >= 2) {
+      auto const mask = read(x.data, 2);
+      for (unsigned i = 0; i != 16; ++i) {
+        if ((mask & (1 << i)) == 0) continue;
+        if (count < capacity) interrupts[count] = i;
+        ++count;
+      }
+    }
+    else if (x.type == resource_type::extended_irq && x.length >= 2) {
+      auto const table = unsigned(x.data[1]);
+      for (unsigned i = 0; i != table && 2 + 4 * (i + 1) <= x.length; ++i) {
+        if (count < capacity) interrupts[count] = ps::size4(read(x.data + 2 + 4 * i, 4));
+        ++count;
+      }
+    }
+    return count;
+  }
+
+  auto resource_range_of ( aml_resource const & x, resource_range & range ) -> bool
+  {
+    auto const d = x.data;
+    switch (x.type)
+    {
+    case resource_type::io:
+      if (x.length < 7) return false;
+      range = { 1, read(d + 1, 2), d[6] };
+      return true;
+    case resource_type::fixed_io:
+      if (x.length < 3) return false;
+      range = { 1, read(d, 2) & 0x3FF, d[2] };
+      return true;
+    case resource_type::memory32:
+      if (x.length < 17) return false;
+      range = { 0, read(d + 1, 4), read(d + 13, 4) };
+      return true;
+    case resource_type::fixed_memory32:
+      if (x.length < 9) return false;
+      range = { 0, read(d + 1, 4), read(d + 5, 4) };
+      return true;
+    case resource_type::word_address:
+      if (x.length < 13) return false;
+      range = { d[0], read(d + 5, 2), read(d + 11, 2) };
+      return true;
+    case resource_type::dword_address:
+      if (x.length < 23) return false;
+      range = { d[0], read(d + 7, 4), read(d + 19, 4) };
+      return true;
+    case resource_type::qword_address:
+      if (x.length < 43) return false;
+      range = { d[0], read(d + 11, 8), read(d + 35, 8) };
+      return true;
+    case resource_type::extended_address:
+      if (x.length < 53) return false;
+      range = { d[0], read(d + 13, 8), read(d + 37, 8) };
+      return true;
+    default:
+      return false;
+    }
+  }
+
+  auto performance_states ( aml_namespace & ns, aml_node * processor, performance_state * states, unsigned capacity ) -> unsigned
+  {
+    auto const mark = ns.arena().mark();
+    aml_value table;
+    if (ns.evaluate(processor, "_PSS", table) != aml_status::ok || table.type != aml_type::package) {
+      ns.release(mark);
+      return 0;
+    }
+
+    unsigned count = 0;
+    for (ps::size4 i = 0; i != table.length; ++i)
+    {
+      auto const & entry = table.elements[i];
+      if (entry.type != aml_type::package || entry.length < 6) continue;
+      ps::size4 fields [6];
+      auto valid = true;
+      for (unsigned j = 0; j != 6; ++j) {
+        valid = valid && entry.elements[j].type == aml_type::integer;
+        fields[j] = ps::size4(entry.elements[j].integer);
+      }
+      if (! valid) continue;
+      if (count < capacity) states[count] = { fields[0], fields[1], fields[2], fields[3], fields[4], fields[5] };
+      ++count;
+    }
+    ns.release(mark);
+    return count;
+  }
+
+  auto power_states ( aml_namespace & ns, aml_node * processor, power_state * states, unsigned capacity ) -> unsigned
+  {
+    auto const mark = ns.arena().mark();
+    aml_value table;
+    if (ns.evaluate(processor, "_CST", table) != aml_status::ok || table.type != aml_type::package) {
+      ns.release(mark);
+      return 0;
+    }
+
+    // First element is the state count, followed by one package per state.
+    unsigned count = 0;
+    for (ps::size4 i = 1; i < table.length; ++i)
+    {
+      auto const & entry = table.elements[i];
+      if (entry.type != aml_type::package || entry.length < 4) continue;
+      auto const & type = entry.elements[1];
+      auto const & latency = entry.elements[2];
+      auto const & power = entry.elements[3];
+      if (type.type != aml_type::integer || latency.type != aml_type::integer || power.type != aml_type::integer) continue;
+
+      aml_resource descriptor;
+      if (resources(entry.elements[0], & descriptor, 1) == 0) continue;
+      if (descriptor.type != resource_type::generic_register || descriptor.length < 12) continue;
+      auto const d = descriptor.data;
+
+      if (count < capacity) {
+        states[count] = {
+          { d[0], d[1], d[2], d[3], read(d + 4, 8) },
+          ps::size1(type.integer),
+          ps::size2(latency.integer),
+          ps::size4(power.integer)
+        };
+      }
+      ++count;
+    }
+    ns.release(mark);
+    return count;
+  }
+
+  auto sleep_type_of ( aml_namespace & ns, unsigned state, sleep_type & result ) -> aml_status
+  {
+    if (state > 5) return aml_status::not_found;
+    char const path [] { '\\', '_', 'S', char('0' + state), '_', 0 };
+    auto const node = ns.find(path);
+    if (node == nullptr) return aml_status::not_found;
+
+    // Package of SLP_TYPa and SLP_TYPb, possibly followed by reserved elements.
+    auto const mark = ns.arena().mark();
+    aml_value value;
+    auto status = ns.evaluate(node, value);
+    if (status == aml_status::ok && (value.type != aml_type::package || value.length < 1 || value.elements[0].type != aml_type::integer)) status = aml_status::malformed;
+    if (status == aml_status::ok) {
+      result.a = ps::size1(value.elements[0].integer & 0x7);
+      result.b = result.a;
+      if (value.length >= 2 && value.elements[1].type == aml_type::integer) result.b = ps::size1(value.elements[1].integer & 0x7);
+    }
+    ns.release(mark);
+    return status;
+  }
+}
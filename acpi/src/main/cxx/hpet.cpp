@@ -0,0 +1,3 @@
+#include <acpi/hpet.h>
+
+static_assert(sizeof(acpi::hpet_description) == 56, "unexpected size of acpi::hpet_description");
@@ -0,0 +1,5 @@
+#include <acpi/mcfg.h>
+
+static_assert(sizeof(acpi::pci_configuration_description) == 44, "unexpected size of acpi::pci_configuration_description");
+
+static_assert(sizeof(acpi::pci_segment_description) == 16, "unexpected size of acpi::pci_segment_description");
@@ -0,0 +1,11 @@
+#include <acpi/srat.h>
+
+static_assert(sizeof(acpi::resource_affinity_description) == 48, "unexpected size of acpi::resource_affinity_description");
+
+static_assert(sizeof(acpi::processor_affinity_description) == 16, "unexpected size of acpi::processor_affinity_description");
+
+static_assert(sizeof(acpi::memory_affinity_description) == 40, "unexpected size of acpi::memory_affinity_description");
+
+static_assert(sizeof(acpi::x2apic_affinity_description) == 24, "unexpected size of acpi::x2apic_affinity_description");
+
+static_assert(sizeof(acpi::locality_description) == 44, "unexpected size of acpi::locality_description");
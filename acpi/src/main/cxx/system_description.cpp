@@ -18,3 +18,19 @@ static_assert(__is_standard_layout(acpi::apic_description), "acpi::apic_descript
 static_assert(__is_standard_layout(acpi::local_apic_description), "acpi::local_apic_description is not standard layout");
 
 static_assert(__is_standard_layout(acpi::io_apic_description), "acpi::io_apic_description is not standard layout");
+
+static_assert(sizeof(acpi::generic_address) == 12, "unexpected size of acpi::generic_address");
+
+static_assert(__builtin_offsetof(acpi::fixed_system_description, Flags) == 112, "unexpected offset of acpi::fixed_system_description::Flags");
+
+static_assert(__builtin_offsetof(acpi::fixed_system_description, X_Dsdt) == 140, "unexpected offset of acpi::fixed_system_description::X_Dsdt");
+
+static_assert(sizeof(acpi::fixed_system_description) == 244, "unexpected size of acpi::fixed_system_description");
+
+static_assert(sizeof(acpi::local_apic_nmi_description) == 6, "unexpected size of acpi::local_apic_nmi_description");
+
+static_assert(sizeof(acpi::local_apic_override_description) == 12, "unexpected size of acpi::local_apic_override_description");
+
+static_assert(sizeof(acpi::local_x2apic_description) == 16, "unexpected size of acpi::local_x2apic_description");
+
+static_assert(sizeof(acpi::local_x2apic_nmi_description) == 12, "unexpected size of acpi::local_x2apic_nmi_description");
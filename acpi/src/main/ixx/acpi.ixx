@@ -0,0 +1,11 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+export module br.dev.pedrolamarao.metal.acpi;
+
+export import :aml;
+export import :hpet;
+export import :madt;
+export import :mcfg;
+export import :srat;
+export import :system_description;
+export import :table_index;
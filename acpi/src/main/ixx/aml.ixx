@@ -0,0 +1,34 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <acpi/aml.h>
+
+export module br.dev.pedrolamarao.metal.acpi:aml;
+
+export namespace acpi
+{
+    using ::acpi::aml_status;
+    using ::acpi::aml_object;
+    using ::acpi::aml_type;
+    using ::acpi::aml_value;
+    using ::acpi::aml_node;
+    using ::acpi::aml_arena;
+    using ::acpi::aml_namespace;
+    using ::acpi::device_status;
+    using ::acpi::pci_route;
+    using ::acpi::pci_routes;
+    using ::acpi::current_resources;
+    using ::acpi::resource_type;
+    using ::acpi::aml_resource;
+    using ::acpi::resources;
+    using ::acpi::resource_interrupts;
+    using ::acpi::resource_range;
+    using ::acpi::resource_range_of;
+    using ::acpi::performance_state;
+    using ::acpi::performance_states;
+    using ::acpi::power_state;
+    using ::acpi::power_states;
+    using ::acpi::sleep_type;
+    using ::acpi::sleep_type_of;
+}
@@ -0,0 +1,14 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <acpi/hpet.h>
+
+export module br.dev.pedrolamarao.metal.acpi:hpet;
+
+export namespace acpi
+{
+    using ::acpi::hpet_description;
+    using ::acpi::comparators;
+    using ::acpi::is_legacy_capable;
+}
@@ -0,0 +1,17 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <acpi/madt.h>
+
+export module br.dev.pedrolamarao.metal.acpi:madt;
+
+export namespace acpi
+{
+    using ::acpi::apic_structure_of;
+    using ::acpi::apic_structure_cast;
+    using ::acpi::apic_iterator;
+    using ::acpi::apic_structures;
+    using ::acpi::enabled_processors;
+    using ::acpi::local_apic_address;
+}
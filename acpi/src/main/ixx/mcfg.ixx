@@ -0,0 +1,15 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <acpi/mcfg.h>
+
+export module br.dev.pedrolamarao.metal.acpi:mcfg;
+
+export namespace acpi
+{
+    using ::acpi::pci_configuration_description;
+    using ::acpi::pci_segment_description;
+    using ::acpi::pci_segment;
+    using ::acpi::pci_segments;
+}
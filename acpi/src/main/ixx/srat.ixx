@@ -0,0 +1,23 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <acpi/srat.h>
+
+export module br.dev.pedrolamarao.metal.acpi:srat;
+
+export namespace acpi
+{
+    using ::acpi::resource_affinity_description;
+    using ::acpi::affinity_structure_type;
+    using ::acpi::processor_affinity_description;
+    using ::acpi::memory_affinity_description;
+    using ::acpi::x2apic_affinity_description;
+    using ::acpi::locality_description;
+    using ::acpi::processor_affinity;
+    using ::acpi::memory_affinity;
+    using ::acpi::processor_affinities;
+    using ::acpi::memory_affinities;
+    using ::acpi::localities;
+    using ::acpi::distance;
+}
@@ -0,0 +1,38 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <acpi/system_description.h>
+
+export module br.dev.pedrolamarao.metal.acpi:system_description;
+
+export namespace acpi
+{
+    using ::acpi::root_system_description_pointer;
+    using ::acpi::revision;
+    using ::acpi::is_valid;
+    using ::acpi::narrow_root_system_description;
+    using ::acpi::narrow_address;
+    using ::acpi::wide_root_system_description;
+    using ::acpi::wide_address;
+    using ::acpi::system_description;
+    using ::acpi::begin;
+    using ::acpi::end;
+    using ::acpi::address_space;
+    using ::acpi::generic_address;
+    using ::acpi::fixed_system_description;
+    using ::acpi::pm_timer_address;
+    using ::acpi::is_pm_timer_32bit;
+    using ::acpi::pm1_control_address;
+    using ::acpi::apic_system_description;
+    using ::acpi::apic_structure_type;
+    using ::acpi::apic_description;
+    using ::acpi::local_apic_description;
+    using ::acpi::io_apic_description;
+    using ::acpi::input_source_override_description;
+    using ::acpi::nmi_source_description;
+    using ::acpi::local_apic_nmi_description;
+    using ::acpi::local_apic_override_description;
+    using ::acpi::local_x2apic_description;
+    using ::acpi::local_x2apic_nmi_description;
+}
@@ -0,0 +1,16 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <acpi/table_index.h>
+
+export module br.dev.pedrolamarao.metal.acpi:table_index;
+
+export namespace acpi
+{
+    using ::acpi::checksum;
+    using ::acpi::make_signature;
+    using ::acpi::table_entry;
+    using ::acpi::table_range;
+    using ::acpi::table_index;
+}
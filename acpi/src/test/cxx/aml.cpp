@@ -0,0 +1,365 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Definition block assembled in memory; package lengths always take two bytes.
+
+    struct assembler
+    {
+        alignas(8) ps::size1 bytes [2048] {};
+        unsigned size { sizeof(acpi::system_description) };
+
+        template <typename... T>
+        void emit (T... values) { ((bytes[size++] = ps::size1(values)), ...); }
+
+        void name (char const * segment) { for (int i = 0; i != 4; ++i) emit(segment[i]); }
+
+        auto open () -> unsigned { auto const mark = size; size += 2; return mark; }
+
+        void close (unsigned mark)
+        {
+            auto const length = size - mark;
+            bytes[mark] = ps::size1(0x40 | (length & 0x0F));
+            bytes[mark + 1] = ps::size1(length >> 4);
+        }
+
+        auto table (char const * signature, unsigned revision) -> acpi::system_description const &
+        {
+            auto & header = * reinterpret_cast<acpi::system_description *>(bytes);
+            for (int i = 0; i != 4; ++i) header.signature[i] = signature[i];
+            header.length = size;
+            header.revision = revision;
+            return header;
+        }
+    };
+
+    auto make_dsdt (assembler & a) -> acpi::system_description const &
+    {
+        // Scope (\_SB)
+        a.emit(0x10); auto const sb = a.open(); a.emit('\\'); a.name("_SB_");
+        {
+            // OperationRegion (GNVS, SystemMemory, 0x1000, 0x10)
+            a.emit(0x5B, 0x80); a.name("GNVS"); a.emit(0x00, 0x0B, 0x00, 0x10, 0x0A, 0x10);
+            // Field (GNVS, AnyAcc, NoLock, Preserve) { FLD1, 8, , 8, FLD2, 16 }
+            a.emit(0x5B, 0x81); auto const field = a.open(); a.name("GNVS"); a.emit(0x00);
+            a.name("FLD1"); a.emit(0x08); a.emit(0x00, 0x08); a.name("FLD2"); a.emit(0x10);
+            a.close(field);
+
+            // Device (PCI0)
+            a.emit(0x5B, 0x82); auto const pci = a.open(); a.name("PCI0");
+            {
+                // Name (_ADR, Zero)
+                a.emit(0x08); a.name("_ADR"); a.emit(0x00);
+
+                // Name (_PRT, Package { Package { 0x0001FFFF, Zero, LNKA, Zero }, Package { 0x0002FFFF, One, Zero, 17 } })
+                a.emit(0x08); a.name("_PRT"); a.emit(0x12); auto const prt = a.open(); a.emit(2);
+                a.emit(0x12); auto const first = a.open(); a.emit(4, 0x0C, 0xFF, 0xFF, 0x01, 0x00, 0x00); a.name("LNKA"); a.emit(0x00); a.close(first);
+                a.emit(0x12); auto const second = a.open(); a.emit(4, 0x0C, 0xFF, 0xFF, 0x02, 0x00, 0x01, 0x00, 0x0A, 17); a.close(second);
+                a.close(prt);
+
+                // Method (_STA) { Local0 = 0x0B; If (Local0 < 0x0F) { Local0 |= 4 }; Return (Local0) }
+                a.emit(0x14); auto const sta = a.open(); a.name("_STA"); a.emit(0x00);
+                a.emit(0x70, 0x0A, 0x0B, 0x60);
+                a.emit(0xA0); auto const branch = a.open(); a.emit(0x95, 0x60, 0x0A, 0x0F, 0x7D, 0x60, 0x0A, 0x04, 0x60); a.close(branch);
+                a.emit(0xA4, 0x60);
+                a.close(sta);
+
+                // Device (LNKA)
+                a.emit(0x5B, 0x82); auto const link = a.open(); a.name("LNKA");
+                {
+                    // Name (_CRS, ResourceTemplate { IRQ (Level, ActiveLow, Shared) { 10 } })
+                    a.emit(0x08); a.name("_CRS"); a.emit(0x11); auto const crs = a.open();
+                    a.emit(0x0A, 6, 0x23, 0x00, 0x04, 0x18, 0x79, 0x00);
+                    a.close(crs);
+
+                    // Method (_STA) { Local0 = Zero; While (Local0 < 9) { Local0++ }; Return (Local0) }
+                    a.emit(0x14); auto const status = a.open(); a.name("_STA"); a.emit(0x00);
+                    a.emit(0x70, 0x00, 0x60);
+                    a.emit(0xA2); auto const loop = a.open(); a.emit(0x95, 0x60, 0x0A, 0x09, 0x75, 0x60); a.close(loop);
+                    a.emit(0xA4, 0x60);
+                    a.close(status);
+                }
+                a.close(link);
+            }
+            a.close(pci);
+
+            // Device (DEV1)
+            a.emit(0x5B, 0x82); auto const dev = a.open(); a.name("DEV1");
+            {
+                // Method (_CRS) { Return (RES1) }, referring to a name defined later
+                a.emit(0x14); auto const crs = a.open(); a.name("_CRS"); a.emit(0x00, 0xA4); a.name("RES1"); a.close(crs);
+
+                // Name (RES1, ResourceTemplate { Memory32Fixed (ReadWrite, 0xFED00000, 0x400); IO (Decode16, 0x60, 0x60, 1, 1) })
+                a.emit(0x08); a.name("RES1"); a.emit(0x11); auto const res = a.open(); a.emit(0x0A, 22);
+                a.emit(0x86, 0x09, 0x00, 0x01, 0x00, 0x00, 0xD0, 0xFE, 0x00, 0x04, 0x00, 0x00);
+                a.emit(0x47, 0x01, 0x60, 0x00, 0x60, 0x00, 0x01, 0x01);
+                a.emit(0x79, 0x00);
+                a.close(res);
+            }
+            a.close(dev);
+
+            // Method (ADD2, 2) { Return (Arg0 + Arg1) }
+            a.emit(0x14); auto const add = a.open(); a.name("ADD2"); a.emit(0x02, 0xA4, 0x72, 0x68, 0x69, 0x00); a.close(add);
+
+            // Method (CALL) { Return (ADD2 (3, 4)) }
+            a.emit(0x14); auto const call = a.open(); a.name("CALL"); a.emit(0x00, 0xA4); a.name("ADD2"); a.emit(0x0A, 3, 0x0A, 4); a.close(call);
+
+            // Name (CNT_, 5); Method (BUMP) { CNT_++; Return (CNT_) }
+            a.emit(0x08); a.name("CNT_"); a.emit(0x0A, 5);
+            a.emit(0x14); auto const bump = a.open(); a.name("BUMP"); a.emit(0x00, 0x75); a.name("CNT_"); a.emit(0xA4); a.name("CNT_"); a.close(bump);
+
+            // Method (RDF1) { Return (FLD1) }
+            a.emit(0x14); auto const field_read = a.open(); a.name("RDF1"); a.emit(0x00, 0xA4); a.name("FLD1"); a.close(field_read);
+
+            // Method (SPIN) { While (One) { Noop } }
+            a.emit(0x14); auto const spin = a.open(); a.name("SPIN"); a.emit(0x00, 0xA2, 0x03, 0x01, 0xA3); a.close(spin);
+
+            // Method (ONES) { Return (~Zero) }
+            a.emit(0x14); auto const ones = a.open(); a.name("ONES"); a.emit(0x00, 0xA4, 0x80, 0x00, 0x00); a.close(ones);
+        }
+        a.close(sb);
+
+        // Scope (\_PR) { Processor (CPU0, 1, 0x410, 6) { ... } }
+        a.emit(0x10); auto const pr = a.open(); a.emit('\\'); a.name("_PR_");
+        {
+            a.emit(0x5B, 0x83); auto const cpu = a.open(); a.name("CPU0"); a.emit(0x01, 0x10, 0x04, 0x00, 0x00, 0x06);
+            {
+                // Name (_PSS, Package { Package { 2000, 35000, 10, 10, 0x1A00, 0x1A00 }, Package { 1000, 15000, 10, 10, 0x0D00, 0x0D00 } })
+                a.emit(0x08); a.name("_PSS"); a.emit(0x12); auto const pss = a.open(); a.emit(2);
+                a.emit(0x12); auto const high = a.open();
+                a.emit(6, 0x0B, 0xD0, 0x07, 0x0B, 0xB8, 0x88, 0x0A, 10, 0x0A, 10, 0x0B, 0x00, 0x1A, 0x0B, 0x00, 0x1A);
+                a.close(high);
+                a.emit(0x12); auto const low = a.open();
+                a.emit(6, 0x0B, 0xE8, 0x03, 0x0B, 0x98, 0x3A, 0x0A, 10, 0x0A, 10, 0x0B, 0x00, 0x0D, 0x0B, 0x00, 0x0D);
+                a.close(low);
+                a.close(pss);
+
+                // Method (_CST) { Return (Package { 2, Package { Register (FFixedHW, 1, 2, 0, 1), 1, 1, 1000 }, Package { Register (SystemIO, 8, 0, 0x414), 2, 100, 500 } }) }
+                a.emit(0x14); auto const cst = a.open(); a.name("_CST"); a.emit(0x00, 0xA4);
+                a.emit(0x12); auto const states = a.open(); a.emit(3, 0x0A, 2);
+                a.emit(0x12); auto const c1 = a.open(); a.emit(4);
+                a.emit(0x11); auto const r1 = a.open(); a.emit(0x0A, 17, 0x82, 0x0C, 0x00, 0x7F, 0x01, 0x02, 0x01, 0, 0, 0, 0, 0, 0, 0, 0, 0x79, 0x00); a.close(r1);
+                a.emit(0x01, 0x01, 0x0B, 0xE8, 0x03);
+                a.close(c1);
+                a.emit(0x12); auto const c2 = a.open(); a.emit(4);
+                a.emit(0x11); auto const r2 = a.open(); a.emit(0x0A, 17, 0x82, 0x0C, 0x00, 0x01, 0x08, 0x00, 0x00, 0x14, 0x04, 0, 0, 0, 0, 0, 0, 0x79, 0x00); a.close(r2);
+                a.emit(0x0A, 2, 0x0A, 100, 0x0B, 0xF4, 0x01);
+                a.close(c2);
+                a.close(states);
+                a.close(cst);
+            }
+            a.close(cpu);
+        }
+        a.close(pr);
+
+        // Name (\_S5, Package { 7, 5, Zero, Zero })
+        a.emit(0x08, '\\'); a.name("_S5_"); a.emit(0x12); auto const s5 = a.open(); a.emit(4, 0x0A, 7, 0x0A, 5, 0x00, 0x00); a.close(s5);
+
+        return a.table("DSDT", 2);
+    }
+
+    alignas(16) ps::size1 memory [0x8000];
+
+    TEST(aml, namespace)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+        ASSERT_EQ(ns.load(make_dsdt(a)), acpi::aml_status::ok);
+
+        auto const pci = ns.find("\\_SB.PCI0");
+        ASSERT_NE(pci, nullptr);
+        ASSERT_EQ(pci->type, acpi::aml_object::device);
+        ASSERT_EQ(ns.find("LNKA", pci), ns.find("\\_SB.PCI0.LNKA"));
+        ASSERT_EQ(ns.find("^DEV1", pci), ns.find("\\_SB_.DEV1"));
+        ASSERT_EQ(ns.find("\\_SB.FLD2")->type, acpi::aml_object::field);
+        ASSERT_EQ(ns.find("\\_PR.CPU0")->type, acpi::aml_object::processor);
+        ASSERT_EQ(ns.find("\\_SB.NONE"), nullptr);
+
+        // No upward search in find.
+        ASSERT_EQ(ns.find("ADD2", pci), nullptr);
+    }
+
+    TEST(aml, evaluate)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+        ASSERT_EQ(ns.load(make_dsdt(a)), acpi::aml_status::ok);
+
+        acpi::aml_value result;
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.CALL", result), acpi::aml_status::ok);
+        ASSERT_EQ(result.type, acpi::aml_type::integer);
+        ASSERT_EQ(result.integer, 7);
+
+        acpi::aml_value arguments [2] {};
+        arguments[0].type = acpi::aml_type::integer;
+        arguments[0].integer = 40;
+        arguments[1].type = acpi::aml_type::integer;
+        arguments[1].integer = 2;
+        ASSERT_EQ(ns.evaluate(ns.find("\\_SB.ADD2"), result, arguments, 2), acpi::aml_status::ok);
+        ASSERT_EQ(result.integer, 42);
+
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.BUMP", result), acpi::aml_status::ok);
+        ASSERT_EQ(result.integer, 6);
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.BUMP", result), acpi::aml_status::ok);
+        ASSERT_EQ(result.integer, 7);
+
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.ONES", result), acpi::aml_status::ok);
+        ASSERT_EQ(result.integer, 0xFFFFFFFFFFFFFFFF);
+
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.RDF1", result), acpi::aml_status::unsupported);
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.SPIN", result), acpi::aml_status::exhausted);
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.NONE", result), acpi::aml_status::not_found);
+    }
+
+    TEST(aml, integer_width)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+        make_dsdt(a);
+        ASSERT_EQ(ns.load(a.table("DSDT", 1)), acpi::aml_status::ok);
+
+        acpi::aml_value result;
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.ONES", result), acpi::aml_status::ok);
+        ASSERT_EQ(result.integer, 0xFFFFFFFF);
+    }
+
+    TEST(aml, devices)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+        ASSERT_EQ(ns.load(make_dsdt(a)), acpi::aml_status::ok);
+
+        auto const pci = ns.find("\\_SB.PCI0");
+        auto const link = ns.find("\\_SB.PCI0.LNKA");
+        ASSERT_EQ(acpi::device_status(ns, pci), 0x0F);
+        ASSERT_EQ(acpi::device_status(ns, link), 0x09);
+        ASSERT_EQ(acpi::device_status(ns, ns.find("\\_SB.DEV1")), 0x0F);
+
+        acpi::pci_route routes [4] {};
+        ASSERT_EQ(acpi::pci_routes(ns, pci, routes, 4), 2);
+        ASSERT_EQ(routes[0].address, 0x0001FFFF);
+        ASSERT_EQ(routes[0].pin, 0);
+        ASSERT_EQ(routes[0].source, link);
+        ASSERT_EQ(routes[1].address, 0x0002FFFF);
+        ASSERT_EQ(routes[1].pin, 1);
+        ASSERT_EQ(routes[1].source, nullptr);
+        ASSERT_EQ(routes[1].index, 17);
+
+        acpi::aml_value buffer;
+        ASSERT_EQ(acpi::current_resources(ns, link, buffer), acpi::aml_status::ok);
+        acpi::aml_resource descriptors [4];
+        ASSERT_EQ(acpi::resources(buffer, descriptors, 4), 1);
+        ASSERT_EQ(descriptors[0].type, acpi::resource_type::irq);
+        ps::size4 interrupts [4];
+        ASSERT_EQ(acpi::resource_interrupts(descriptors[0], interrupts, 4), 1);
+        ASSERT_EQ(interrupts[0], 10);
+
+        ASSERT_EQ(acpi::current_resources(ns, ns.find("\\_SB.DEV1"), buffer), acpi::aml_status::ok);
+        ASSERT_EQ(acpi::resources(buffer, descriptors, 4), 2);
+        acpi::resource_range range;
+        ASSERT_TRUE(acpi::resource_range_of(descriptors[0], range));
+        ASSERT_EQ(range.space, 0);
+        ASSERT_EQ(range.base, 0xFED00000);
+        ASSERT_EQ(range.length, 0x400);
+        ASSERT_TRUE(acpi::resource_range_of(descriptors[1], range));
+        ASSERT_EQ(range.space, 1);
+        ASSERT_EQ(range.base, 0x60);
+        ASSERT_EQ(range.length, 1);
+    }
+
+    TEST(aml, processor)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+        ASSERT_EQ(ns.load(make_dsdt(a)), acpi::aml_status::ok);
+        auto const cpu = ns.find("\\_PR.CPU0");
+
+        acpi::performance_state performance [4] {};
+        ASSERT_EQ(acpi::performance_states(ns, cpu, performance, 4), 2);
+        ASSERT_EQ(performance[0].frequency, 2000);
+        ASSERT_EQ(performance[0].power, 35000);
+        ASSERT_EQ(performance[0].control, 0x1A00);
+        ASSERT_EQ(performance[1].frequency, 1000);
+        ASSERT_EQ(performance[1].status, 0x0D00);
+
+        acpi::power_state power [4] {};
+        ASSERT_EQ(acpi::power_states(ns, cpu, power, 4), 2);
+        ASSERT_EQ(power[0].entry.space, 0x7F);
+        ASSERT_EQ(power[0].type, 1);
+        ASSERT_EQ(power[0].latency, 1);
+        ASSERT_EQ(power[0].power, 1000);
+        ASSERT_EQ(power[1].entry.space, 1);
+        ASSERT_EQ(power[1].entry.address, 0x414);
+        ASSERT_EQ(power[1].type, 2);
+        ASSERT_EQ(power[1].latency, 100);
+        ASSERT_EQ(power[1].power, 500);
+    }
+
+    TEST(aml, sleep)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+        ASSERT_EQ(ns.load(make_dsdt(a)), acpi::aml_status::ok);
+
+        acpi::sleep_type type {};
+        ASSERT_EQ(acpi::sleep_type_of(ns, 5, type), acpi::aml_status::ok);
+        ASSERT_EQ(type.a, 7);
+        ASSERT_EQ(type.b, 5);
+        ASSERT_EQ(acpi::sleep_type_of(ns, 3, type), acpi::aml_status::not_found);
+        ASSERT_EQ(acpi::sleep_type_of(ns, 6, type), acpi::aml_status::not_found);
+    }
+
+    TEST(aml, arena)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+        ASSERT_EQ(ns.load(make_dsdt(a)), acpi::aml_status::ok);
+        auto const pci = ns.find("\\_SB.PCI0");
+        auto const cpu = ns.find("\\_PR.CPU0");
+
+        // First lookups keep named values; later ones allocate nothing.
+        acpi::pci_route routes [4] {};
+        acpi::performance_state performance [4] {};
+        acpi::power_state power [4] {};
+        acpi::sleep_type type {};
+        ASSERT_EQ(acpi::pci_routes(ns, pci, routes, 4), 2);
+        ASSERT_EQ(acpi::performance_states(ns, cpu, performance, 4), 2);
+        ASSERT_EQ(acpi::sleep_type_of(ns, 5, type), acpi::aml_status::ok);
+        auto const available = ns.arena().available();
+        for (unsigned i = 0; i != 100; ++i) {
+            ASSERT_EQ(acpi::pci_routes(ns, pci, routes, 4), 2);
+            ASSERT_EQ(acpi::performance_states(ns, cpu, performance, 4), 2);
+            ASSERT_EQ(acpi::power_states(ns, cpu, power, 4), 2);
+            ASSERT_EQ(acpi::sleep_type_of(ns, 5, type), acpi::aml_status::ok);
+            ASSERT_EQ(acpi::device_status(ns, pci), 0x0F);
+        }
+        ASSERT_EQ(ns.arena().available(), available);
+
+        // Values stored to names survive release.
+        acpi::aml_value result;
+        auto const mark = ns.arena().mark();
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.BUMP", result), acpi::aml_status::ok);
+        ns.release(mark);
+        ASSERT_EQ(ns.evaluate(nullptr, "\\_SB.BUMP", result), acpi::aml_status::ok);
+        ASSERT_EQ(result.integer, 7);
+    }
+
+    TEST(aml, malformed)
+    {
+        static assembler a;
+        acpi::aml_namespace ns { memory, sizeof(memory) };
+
+        // Scope whose package length overruns the table.
+        a.emit(0x10, 0x3F); a.name("_SB_");
+        ASSERT_EQ(ns.load(a.table("SSDT", 2)), acpi::aml_status::malformed);
+
+        // Arena too small for any node.
+        ps::size1 tiny [8];
+        acpi::aml_namespace empty { tiny, sizeof(tiny) };
+        ASSERT_EQ(empty.root(), nullptr);
+        ASSERT_EQ(empty.load(a.table("SSDT", 2)), acpi::aml_status::exhausted);
+    }
+}
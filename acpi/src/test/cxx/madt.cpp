@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // MADT with: local APIC 0 enabled, local APIC 1 disabled, I/O APIC, local APIC NMI, local x2APIC 0x100 enabled,
+    // local APIC address override.
+
+    alignas(8) ps::size1 table [44 + 8 + 8 + 12 + 6 + 16 + 12] {};
+
+    auto make_madt () -> acpi::apic_system_description const &
+    {
+        auto & madt = * reinterpret_cast<acpi::apic_system_description *>(table);
+        madt.base.length = sizeof(table);
+        madt.local_apic_address = 0xFEE00000;
+
+        ps::size1 const entries [] = {
+            0, 8, 0, 0, 1, 0, 0, 0,
+            0, 8, 1, 1, 0, 0, 0, 0,
+            1, 12, 2, 0, 0x00, 0x00, 0xC0, 0xFE, 0, 0, 0, 0,
+            4, 6, 0xFF, 0x05, 0x00, 1,
+            9, 16, 0, 0, 0x00, 0x01, 0, 0, 1, 0, 0, 0, 2, 0, 0, 0,
+            5, 12, 0, 0, 0x00, 0x00, 0xD0, 0xFE, 0, 0, 0, 0,
+        };
+        for (unsigned i = 0; i != sizeof(entries); ++i) table[44 + i] = entries[i];
+        return madt;
+    }
+
+    TEST(madt, iterate)
+    {
+        auto & madt = make_madt();
+
+        unsigned count = 0;
+        for (auto & entry : acpi::apic_structures<>(madt)) { (void) entry; ++count; }
+        ASSERT_EQ(count, 6);
+
+        count = 0;
+        for (auto & entry : acpi::apic_structures<acpi::local_apic_description>(madt)) {
+            ASSERT_EQ(entry.id, count);
+            ++count;
+        }
+        ASSERT_EQ(count, 2);
+
+        for (auto & entry : acpi::apic_structures<acpi::io_apic_description>(madt)) {
+            ASSERT_EQ(entry.id, 2);
+            ASSERT_EQ(entry.address, 0xFEC00000);
+        }
+
+        for (auto & entry : acpi::apic_structures<acpi::local_apic_nmi_description>(madt)) {
+            ASSERT_EQ(entry.processor, 0xFF);
+            ASSERT_EQ(entry.flags, 5);
+            ASSERT_EQ(entry.pin, 1);
+        }
+
+        ASSERT_EQ(acpi::local_apic_address(madt), 0xFED00000);
+    }
+
+    TEST(madt, enabled_processors)
+    {
+        auto & madt = make_madt();
+
+        ps::size4 ids [4] {};
+        ASSERT_EQ(acpi::enabled_processors(madt, ids, 4), 2);
+        ASSERT_EQ(ids[0], 0);
+        ASSERT_EQ(ids[1], 0x100);
+
+        ASSERT_EQ(acpi::enabled_processors(madt, ids, 1), 2);
+    }
+
+    TEST(madt, malformed)
+    {
+        auto & madt = make_madt();
+
+        // Zero length entry stops iteration.
+        table[44 + 8 + 1] = 0;
+        unsigned count = 0;
+        for (auto & entry : acpi::apic_structures<>(madt)) { (void) entry; ++count; }
+        ASSERT_EQ(count, 1);
+
+        // Entry overrunning the table stops iteration.
+        table[44 + 8 + 1] = 200;
+        count = 0;
+        for (auto & entry : acpi::apic_structures<>(madt)) { (void) entry; ++count; }
+        ASSERT_EQ(count, 1);
+    }
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    TEST(srat, affinities)
+    {
+        alignas(8) ps::size1 table [48 + 16 + 16 + 40 + 40 + 24] {};
+
+        auto & srat = * reinterpret_cast<acpi::resource_affinity_description *>(table);
+        srat.base.length = sizeof(table);
+
+        ps::size1 const entries [] = {
+            // processor: APIC 0 in domain 0, enabled
+            0, 16, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            // processor: APIC 2 in domain 0x101, enabled
+            0, 16, 1, 2, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+            // memory: [0x100000000, 0x140000000) in domain 1, enabled, hot pluggable
+            1, 40, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0x40, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            // memory: disabled
+            1, 40, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+            // x2apic: id 0x100 in domain 1, enabled
+            2, 24, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        };
+        for (unsigned i = 0; i != sizeof(entries); ++i) table[48 + i] = entries[i];
+
+        acpi::processor_affinity processors [4] {};
+        ASSERT_EQ(acpi::processor_affinities(srat, processors, 4), 3);
+        ASSERT_EQ(processors[0].apic_id, 0);
+        ASSERT_EQ(processors[0].domain, 0);
+        ASSERT_EQ(processors[1].apic_id, 2);
+        ASSERT_EQ(processors[1].domain, 0x101);
+        ASSERT_EQ(processors[2].apic_id, 0x100);
+        ASSERT_EQ(processors[2].domain, 1);
+
+        acpi::memory_affinity memory [4] {};
+        ASSERT_EQ(acpi::memory_affinities(srat, memory, 4), 1);
+        ASSERT_EQ(memory[0].base, 0x100000000);
+        ASSERT_EQ(memory[0].length, 0x40000000);
+        ASSERT_EQ(memory[0].domain, 1);
+        ASSERT_TRUE(memory[0].hotplug);
+    }
+
+    TEST(slit, distance)
+    {
+        alignas(8) ps::size1 table [44 + 4] {};
+
+        auto & slit = * reinterpret_cast<acpi::locality_description *>(table);
+        slit.base.length = sizeof(table);
+        slit.count = 2;
+        ps::size1 const distances [] = { 10, 21, 21, 10 };
+        for (unsigned i = 0; i != 4; ++i) table[44 + i] = distances[i];
+
+        ASSERT_EQ(acpi::localities(slit), 2);
+        ASSERT_EQ(acpi::distance(slit, 0, 0), 10);
+        ASSERT_EQ(acpi::distance(slit, 0, 1), 21);
+        ASSERT_EQ(acpi::distance(slit, 2, 0), 255);
+    }
+}
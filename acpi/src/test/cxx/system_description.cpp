@@ -1,7 +1,7 @@
-#include <acpi/system_description.h>
-
 #include <gtest/gtest.h>
 
+import br.dev.pedrolamarao.metal.acpi;
+
 namespace
 {
     TEST(system_description, smoke)
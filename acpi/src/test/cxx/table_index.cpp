@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Tables simulated by memory, addressed by offset into an arena at mapping offset.
+
+    alignas(8) ps::size1 arena [0x1000] {};
+
+    auto at (unsigned offset) -> ps::size1 * { return arena + offset; }
+
+    void fix (unsigned offset, unsigned checksum_offset, unsigned length)
+    {
+        at(offset)[checksum_offset] = 0;
+        at(offset)[checksum_offset] = ps::size1(0x100 - acpi::checksum(at(offset), length));
+    }
+
+    void make_table (unsigned offset, char const * signature, unsigned length)
+    {
+        auto & table = * reinterpret_cast<acpi::system_description *>(at(offset));
+        for (int i = 0; i != 4; ++i) table.signature[i] = signature[i];
+        table.length = length;
+        for (unsigned i = sizeof(acpi::system_description); i != length; ++i) at(offset)[i] = i;
+        fix(offset, 9, length);
+    }
+
+    TEST(checksum, word_at_a_time)
+    {
+        ps::size1 bytes [1500] {};
+        unsigned expected = 0;
+        for (unsigned i = 0; i != sizeof(bytes); ++i) {
+            bytes[i] = ps::size1(i * 7 + 3);
+            expected += unsigned(bytes[i]);
+        }
+        for (unsigned start = 0; start != 8; ++start)
+        {
+            unsigned sum = 0;
+            for (unsigned i = start; i != sizeof(bytes); ++i) sum += unsigned(bytes[i]);
+            ASSERT_EQ(acpi::checksum(bytes + start, sizeof(bytes) - start), sum & 0xFF);
+        }
+        ASSERT_EQ(acpi::checksum(bytes, sizeof(bytes)), expected & 0xFF);
+        ASSERT_EQ(acpi::checksum(bytes, 0), 0);
+    }
+
+    TEST(table_index, xsdt)
+    {
+        for (auto & byte : arena) byte = 0;
+
+        make_table(0x100, "APIC", 60);
+        make_table(0x200, "SSDT", 50);
+        make_table(0x300, "SSDT", 70);
+        make_table(0x400, "HPET", 56);
+        make_table(0x500, "BAD!", 40);
+        at(0x500)[20] ^= 1;
+
+        // FADT referencing DSDT through X_Dsdt.
+        make_table(0x700, "DSDT", 80);
+        make_table(0x800, "FACP", 244);
+        auto & fadt = * reinterpret_cast<acpi::fixed_system_description *>(at(0x800));
+        fadt.Dsdt = 0;
+        fadt.X_Dsdt = 0x700;
+        fix(0x800, 9, 244);
+
+        // XSDT with unaligned pointers.
+        ps::size8 const pointers [] = { 0x100, 0x200, 0x800, 0x400, 0x300, 0x500 };
+        make_table(0x900, "XSDT", 36 + sizeof(pointers));
+        __builtin_memcpy(at(0x900 + 36), pointers, sizeof(pointers));
+        fix(0x900, 9, 36 + sizeof(pointers));
+
+        auto & root = * reinterpret_cast<acpi::root_system_description_pointer *>(at(0));
+        root.revision = 2;
+        root.extended_address = 0x900;
+
+        auto const mapping = reinterpret_cast<ps::size>(arena);
+        acpi::table_index index { root, mapping };
+        ASSERT_EQ(index.size(), 6);
+        ASSERT_EQ(index.rejected(), 1);
+
+        ASSERT_EQ(index.find("APIC"), reinterpret_cast<acpi::system_description const *>(at(0x100)));
+        ASSERT_EQ(index.find("HPET"), reinterpret_cast<acpi::system_description const *>(at(0x400)));
+        ASSERT_EQ(index.find("DSDT"), reinterpret_cast<acpi::system_description const *>(at(0x700)));
+        ASSERT_EQ(index.find("MCFG"), nullptr);
+        ASSERT_EQ(index.find("BAD!"), nullptr);
+
+        auto const ssdt = index.find_all("SSDT");
+        ASSERT_EQ(ssdt.size(), 2);
+        ASSERT_EQ(ssdt.begin()[0].address, 0x200);
+        ASSERT_EQ(ssdt.begin()[1].address, 0x300);
+        ASSERT_EQ(ssdt.begin()[1].length, 70);
+
+        for (auto i = index.begin() + 1; i != index.end(); ++i)
+            ASSERT_LE(i[-1].signature, i->signature);
+    }
+}
@@ -8,12 +8,15 @@ allprojects {
 }
 
 dependencies {
+    commands(project(":acpi"))
     commands(project(":elf"))
     commands(project(":multiboot2:foo"))
     commands(project(":multiboot2:start"))
     commands(project(":pc"))
+    commands(project(":pci"))
     commands(project(":psys"))
     commands(project(":psys:start"))
+    commands(project(":smbios"))
     commands(project(":x86"))
 }
 
@@ -0,0 +1,155 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <elf/lz4.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+namespace elf
+{
+    //! Compressed module magic: "PSZ4", little endian.
+
+    constexpr ps::size4 compressed_magic = 0x345A5350;
+
+    //! Compressed module header; frames follow.
+    //!
+    //! Length is the size of the uncompressed image.
+
+    struct compressed_header
+    {
+        ps::size4 magic;
+        ps::size4 frame_count;
+        ps::size8 length;
+    };
+
+    static_assert(sizeof(compressed_header) == 16, "unexpected size of compressed_header");
+
+    //! Compressed module frame header; LZ4 block follows, padded to 8 bytes.
+    //!
+    //! Frame decodes to size bytes at offset of the uncompressed image.
+    //! Frames are independent of each other: they may be decoded in any order, by any processor.
+
+    struct compressed_frame
+    {
+        ps::size8 offset;
+        ps::size4 size;
+        ps::size4 compressed_size;
+    };
+
+    static_assert(sizeof(compressed_frame) == 16, "unexpected size of compressed_frame");
+
+    //! True if module of length at address starts with compressed module magic.
+
+    auto is_compressed ( ps::size address, ps::size length ) -> bool;
+
+    //! Validated compressed module of length at address.
+    //!
+    //! Construction checks that every frame header and block lies inside length
+    //! and that frames are ordered by offset, without overlap, inside the uncompressed image;
+    //! accessors require a valid module.
+
+    class compressed_module
+    {
+        ps::size  _address {};
+        ps::size8 _end {};
+        bool      _valid {};
+
+    public:
+
+        constexpr
+        compressed_module () = default;
+
+        compressed_module ( ps::size address, ps::size length );
+
+        auto is_valid () const -> bool { return _valid; }
+
+        auto header () const -> compressed_header const & { return * reinterpret_cast<compressed_header const *>(_address); }
+
+        //! Uncompressed image length.
+
+        auto length () const -> ps::size8 { return header().length; }
+
+        auto frame_count () const -> ps::size { return header().frame_count; }
+
+        //! First frame; null if none.
+
+        auto first () const -> compressed_frame const *;
+
+        //! Frame after frame; null if last.
+
+        auto next ( compressed_frame const * frame ) const -> compressed_frame const *;
+
+        //! Decode frame into target of target size; false if block is malformed or does not decode to frame size.
+
+        auto decode ( compressed_frame const & frame, void * target, ps::size target_size ) const -> bool;
+    };
+}
+
+// Definitions.
+
+namespace elf
+{
+    namespace internal
+    {
+        // Frame header plus block, padded so the next frame header is aligned.
+
+        inline
+        auto frame_extent ( compressed_frame const & frame ) -> ps::size8
+        {
+            return sizeof(compressed_frame) + ((ps::size8(frame.compressed_size) + 7) & ~ps::size8(7));
+        }
+    }
+
+    inline
+    auto is_compressed ( ps::size address, ps::size length ) -> bool
+    {
+        return length >= sizeof(compressed_header) && reinterpret_cast<compressed_header const *>(address)->magic == compressed_magic;
+    }
+
+    inline
+    compressed_module::compressed_module ( ps::size address, ps::size length ) : _address { address }
+    {
+        if (! is_compressed(address, length) || address % alignof(compressed_header) != 0) return;
+
+        ps::size8 position = sizeof(compressed_header);
+        ps::size8 previous = 0;
+        for (ps::size i = 0; i != header().frame_count; ++i)
+        {
+            if (position > length || sizeof(compressed_frame) > length - position) return;
+            auto const & frame = * reinterpret_cast<compressed_frame const *>(address + ps::size(position));
+            // Last block may end unpadded.
+            if (frame.compressed_size > length - position - sizeof(compressed_frame)) return;
+            if (frame.offset < previous || frame.offset > header().length || frame.size > header().length - frame.offset) return;
+            previous = frame.offset + frame.size;
+            position += internal::frame_extent(frame);
+        }
+
+        _end = address + position;
+        _valid = true;
+    }
+
+    inline
+    auto compressed_module::first () const -> compressed_frame const *
+    {
+        if (header().frame_count == 0) return nullptr;
+        return reinterpret_cast<compressed_frame const *>(_address + sizeof(compressed_header));
+    }
+
+    inline
+    auto compressed_module::next ( compressed_frame const * frame ) const -> compressed_frame const *
+    {
+        auto const following = reinterpret_cast<ps::size>(frame) + internal::frame_extent(*frame);
+        if (following >= _end) return nullptr;
+        return reinterpret_cast<compressed_frame const *>(ps::size(following));
+    }
+
+    inline
+    auto compressed_module::decode ( compressed_frame const & frame, void * target, ps::size target_size ) const -> bool
+    {
+        if (target_size < frame.size) return false;
+        ps::size written {};
+        auto const block = reinterpret_cast<ps::size1 const *>(& frame + 1);
+        return lz4_decode(block, frame.compressed_size, target, frame.size, written) && written == frame.size;
+    }
+}
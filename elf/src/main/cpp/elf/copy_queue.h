@@ -0,0 +1,123 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.psys;
+
+namespace elf
+{
+    //! Segment copy job: copy bytes from source to destination, then zero fill bytes after them.
+
+    struct copy_job
+    {
+        ps::size destination;
+        ps::size source;
+        ps::size copy_size;
+        ps::size zero_size;
+    };
+
+    //! Queue of segment copy jobs, executed in fixed size chunks by any number of workers.
+    //!
+    //! One processor adds jobs; then every worker calls run, claiming chunks atomically
+    //! across job boundaries, so large and small segments spread evenly; wait spins until all chunks are done.
+
+    template <unsigned Capacity = 64>
+    class copy_queue
+    {
+        copy_job _jobs [Capacity] {};
+        ps::size _ends [Capacity] {};
+        unsigned _count {};
+        ps::size _chunk_size;
+        unsigned _chunks {};
+        unsigned _next {};
+        unsigned _done {};
+
+        void process (ps::size begin, ps::size end)
+        {
+            // First job ending after begin.
+            unsigned low = 0, high = _count;
+            while (low < high) {
+                auto const middle = (low + high) / 2;
+                if (_ends[middle] <= begin) low = middle + 1;
+                else high = middle;
+            }
+
+            for (auto i = low; i != _count && begin < end; ++i)
+            {
+                auto const & job = _jobs[i];
+                auto const start = i == 0 ? 0 : _ends[i - 1];
+                auto const from = begin - start;
+                auto const to = (end < _ends[i] ? end : _ends[i]) - start;
+
+                auto const destination = reinterpret_cast<ps::size1 *>(job.destination);
+                auto const source = reinterpret_cast<ps::size1 const *>(job.source);
+                for (auto j = from; j < to && j < job.copy_size; ++j)
+                    destination[j] = source[j];
+                for (auto j = from > job.copy_size ? from : job.copy_size; j < to; ++j)
+                    destination[j] = 0;
+
+                begin = start + to;
+            }
+        }
+
+    public:
+
+        static constexpr unsigned capacity = Capacity;
+
+        //! Queue with chunk size in bytes.
+
+        explicit
+        copy_queue (ps::size chunk_size = 0x10000) : _chunk_size { chunk_size } { }
+
+        copy_queue (copy_queue const &) = delete;
+
+        //! Add job; false if full or already running.
+
+        auto add (copy_job const & job) -> bool
+        {
+            if (_count == Capacity || __atomic_load_n(& _next, __ATOMIC_RELAXED) != 0) return false;
+            auto const bytes = job.copy_size + job.zero_size;
+            if (bytes == 0) return true;
+            _jobs[_count] = job;
+            _ends[_count] = (_count == 0 ? 0 : _ends[_count - 1]) + bytes;
+            ++_count;
+            _chunks = unsigned((_ends[_count - 1] + _chunk_size - 1) / _chunk_size);
+            return true;
+        }
+
+        auto size () const -> unsigned { return _count; }
+
+        //! Total bytes to copy or zero.
+
+        auto bytes () const -> ps::size { return _count == 0 ? 0 : _ends[_count - 1]; }
+
+        auto chunks () const -> unsigned { return _chunks; }
+
+        //! Execute chunks until none is left; returns number of chunks executed by this worker.
+
+        auto run () -> unsigned
+        {
+            unsigned executed = 0;
+            while (true)
+            {
+                auto const chunk = __atomic_fetch_add(& _next, 1u, __ATOMIC_ACQ_REL);
+                if (chunk >= _chunks) break;
+                auto const begin = ps::size(chunk) * _chunk_size;
+                auto const end = begin + _chunk_size < bytes() ? begin + _chunk_size : bytes();
+                process(begin, end);
+                __atomic_fetch_add(& _done, 1u, __ATOMIC_RELEASE);
+                ++executed;
+            }
+            return executed;
+        }
+
+        auto is_done () const -> bool { return __atomic_load_n(& _done, __ATOMIC_ACQUIRE) == _chunks; }
+
+        //! Wait for all chunks.
+
+        void wait () const
+        {
+            while (! is_done()) __builtin_ia32_pause();
+        }
+    };
+}
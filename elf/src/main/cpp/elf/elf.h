@@ -20,11 +20,29 @@ namespace elf
         EM_X86_64 = 62,
     };
 
+    //! ELF file type.
+
+    enum class file_type : size2
+    {
+        ET_EXEC = 2,
+        ET_DYN  = 3,
+    };
+
     //! ELF segment type.
 
     enum class segment : size4
     {
-        load = 1,
+        load    = 1,
+        dynamic = 2,
+    };
+
+    //! ELF segment flags.
+
+    enum segment_flags : size4
+    {
+        execute = 1,
+        write   = 2,
+        read    = 4,
     };
 
     //! ELF header prologue.
@@ -120,4 +138,781 @@ namespace elf
     };
 
     static_assert(sizeof(segment_64) == 56, "unexpected size of segment_64");
-};
\ No newline at end of file
+
+    //! ELF loadable segment placement by pages.
+    //!
+    //! Whole pages of file data are mapped in place from the module.
+    //! If file data ends inside a page followed by zero fill, that page is fresh:
+    //! copy size bytes from copy source to copy address, zero the rest.
+    //! Pages after file data up to memory size are fresh zero pages.
+
+    struct segment_plan
+    {
+        size8 map_address;
+        size8 map_source;
+        size8 map_pages;
+        bool  copy;
+        size8 copy_address;
+        size8 copy_source;
+        size8 copy_size;
+        size8 zero_address;
+        size8 zero_pages;
+        bool  writable;
+        bool  executable;
+    };
+
+    //! Plan loadable segment of module at address with page size, a power of two.
+    //!
+    //! False if segment file offset and virtual address are not congruent modulo page size:
+    //! such segments must be copied.
+
+    template <typename Segment>
+    auto plan_segment ( size8 module, Segment const & segment, size8 page_size, segment_plan & plan ) -> bool;
+
+    //! ELF image validation status.
+
+    enum class image_status : size1
+    {
+        valid,
+        truncated,
+        bad_identity,
+        bad_type,
+        bad_machine,
+        bad_segment_table,
+        bad_segment,
+        segment_outside,
+        segment_overlap,
+        bad_entry,
+    };
+
+    //! Validated ELF image of length at address.
+    //!
+    //! Construction validates header, program header table and segment ranges against length
+    //! in a single pass without allocation, cheapest checks first; accessors require a valid image.
+    //! Loadable segments must be ordered by virtual address, as ELF requires,
+    //! so overlap is checked against the previous loadable segment only.
+
+    template <typename Header, typename Segment>
+    class image
+    {
+        size         _address {};
+        image_status _status { image_status::truncated };
+        size8        _low {};
+        size8        _high {};
+
+    public:
+
+        constexpr
+        image () = default;
+
+        image ( size address, size length );
+
+        auto status () const -> image_status { return _status; }
+
+        auto is_valid () const -> bool { return _status == image_status::valid; }
+
+        auto address () const -> size { return _address; }
+
+        auto header () const -> Header const & { return * reinterpret_cast<Header const *>(_address); }
+
+        auto segment_count () const -> size { return header().phnum; }
+
+        //! Program header at index, less than segment count.
+
+        auto segment_at ( size index ) const -> Segment const &
+        {
+            return * reinterpret_cast<Segment const *>(_address + size(header().phoff) + index * header().phentsize);
+        }
+
+        //! Lowest virtual address of loadable segments.
+
+        auto low () const -> size8 { return _low; }
+
+        //! Virtual address after highest loadable segment; equal to low if none.
+
+        auto high () const -> size8 { return _high; }
+    };
+
+    using image_32 = image<header_32, segment_32>;
+
+    using image_64 = image<header_64, segment_64>;
+
+    //! ELF dynamic section tag.
+
+    enum class dynamic_tag : size4
+    {
+        DT_NULL     = 0,
+        DT_STRTAB   = 5,
+        DT_SYMTAB   = 6,
+        DT_RELA     = 7,
+        DT_RELASZ   = 8,
+        DT_RELAENT  = 9,
+        DT_REL      = 17,
+        DT_RELSZ    = 18,
+        DT_RELENT   = 19,
+        DT_RELRSZ   = 35,
+        DT_RELR     = 36,
+        DT_RELRENT  = 37,
+        DT_GNU_HASH = 0x6FFFFEF5,
+    };
+
+    //! ELF 32-bit dynamic section entry.
+
+    struct dynamic_32
+    {
+        size4 tag;
+        size4 value;
+    };
+
+    static_assert(sizeof(dynamic_32) == 8, "unexpected size of dynamic_32");
+
+    //! ELF 64-bit dynamic section entry.
+
+    struct dynamic_64
+    {
+        size8 tag;
+        size8 value;
+    };
+
+    static_assert(sizeof(dynamic_64) == 16, "unexpected size of dynamic_64");
+
+    //! ELF 32-bit relocation, addend in place.
+
+    struct rel_32
+    {
+        size4 offset;
+        size4 info;
+    };
+
+    static_assert(sizeof(rel_32) == 8, "unexpected size of rel_32");
+
+    //! ELF 32-bit relocation with addend.
+
+    struct rela_32
+    {
+        size4 offset;
+        size4 info;
+        size4 addend;
+    };
+
+    static_assert(sizeof(rela_32) == 12, "unexpected size of rela_32");
+
+    //! ELF 64-bit relocation with addend.
+
+    struct rela_64
+    {
+        size8 offset;
+        size8 info;
+        size8 addend;
+    };
+
+    static_assert(sizeof(rela_64) == 24, "unexpected size of rela_64");
+
+    //! ELF relocation types supported for position independent loading.
+
+    enum class relocation : size4
+    {
+        R_386_NONE        = 0,
+        R_386_RELATIVE    = 8,
+        R_X86_64_NONE     = 0,
+        R_X86_64_RELATIVE = 8,
+    };
+
+    //! Relocation tables of loaded image: addresses and sizes in bytes, zero if absent.
+
+    struct relocations
+    {
+        size8 rel;
+        size8 rel_size;
+        size8 rela;
+        size8 rela_size;
+        size8 relr;
+        size8 relr_size;
+    };
+
+    //! Find relocation tables from dynamic section of count entries of image loaded with bias.
+    //!
+    //! Entries after DT_NULL or past count are ignored.
+
+    template <typename Dynamic>
+    auto find_relocations ( Dynamic const * dynamic, size count, size8 bias ) -> relocations;
+
+    //! Apply relocations of 32-bit image from low to high loaded with bias;
+    //! false if some table or relocation is not inside the image, or some relocation is not relative.
+
+    auto relocate_32 ( relocations const & tables, size8 low, size8 high, size4 bias ) -> bool;
+
+    //! Apply relocations of 64-bit image from low to high loaded with bias;
+    //! false if some table or relocation is not inside the image, or some relocation is not relative.
+
+    auto relocate_64 ( relocations const & tables, size8 low, size8 high, size8 bias ) -> bool;
+
+    //! Apply relocations of 64-bit image from low to high running with bias, written through alias bias;
+    //! false if some table or relocation is not inside the image, or some relocation is not relative.
+    //!
+    //! Alias bias places the image in the current address space, which may differ from the one it runs in;
+    //! tables must be found with alias bias.
+
+    auto relocate_64 ( relocations const & tables, size8 low, size8 high, size8 bias, size8 alias ) -> bool;
+
+    //! Apply compact relative relocations of image from low to high: even entries are addresses, odd entries bitmaps of following words;
+    //! false if some relocation is not inside the image or a bitmap comes before any address.
+
+    template <typename Word>
+    auto relocate_relr ( Word const * relr, size count, size8 low, size8 high, Word bias ) -> bool;
+
+    //! Apply compact relative relocations of image from low to high running with bias, written through alias bias.
+
+    template <typename Word>
+    auto relocate_relr ( Word const * relr, size count, size8 low, size8 high, Word bias, Word alias ) -> bool;
+
+    //! ELF section type.
+
+    enum class section : size4
+    {
+        SHT_NULL     = 0,
+        SHT_PROGBITS = 1,
+        SHT_SYMTAB   = 2,
+        SHT_STRTAB   = 3,
+        SHT_RELA     = 4,
+        SHT_NOBITS   = 8,
+        SHT_REL      = 9,
+        SHT_DYNSYM   = 11,
+        SHT_GNU_HASH = 0x6FFFFFF6,
+    };
+
+    //! ELF 32-bit section header.
+
+    struct section_32
+    {
+        size4   name;
+        section type;
+        size4   flags;
+        size4   addr;
+        size4   offset;
+        size4   size;
+        size4   link;
+        size4   info;
+        size4   addralign;
+        size4   entsize;
+    };
+
+    static_assert(sizeof(section_32) == 40, "unexpected size of section_32");
+
+    //! ELF 64-bit section header.
+
+    struct section_64
+    {
+        size4   name;
+        section type;
+        size8   flags;
+        size8   addr;
+        size8   offset;
+        size8   size;
+        size4   link;
+        size4   info;
+        size8   addralign;
+        size8   entsize;
+    };
+
+    static_assert(sizeof(section_64) == 64, "unexpected size of section_64");
+
+    //! ELF 32-bit symbol.
+
+    struct symbol_32
+    {
+        size4 name;
+        size4 value;
+        size4 size;
+        size1 info;
+        size1 other;
+        size2 shndx;
+    };
+
+    static_assert(sizeof(symbol_32) == 16, "unexpected size of symbol_32");
+
+    //! ELF 64-bit symbol.
+
+    struct symbol_64
+    {
+        size4 name;
+        size1 info;
+        size1 other;
+        size2 shndx;
+        size8 value;
+        size8 size;
+    };
+
+    static_assert(sizeof(symbol_64) == 24, "unexpected size of symbol_64");
+
+    //! ELF symbol type, in the low nibble of symbol info.
+
+    enum class symbol_type : size1
+    {
+        STT_NOTYPE = 0,
+        STT_OBJECT = 1,
+        STT_FUNC   = 2,
+    };
+
+    //! Section header at index of module at address; null if out of range.
+
+    template <typename Header, typename Section>
+    auto find_section ( size address, Header const & header, size index ) -> Section const *;
+
+    //! First section header of type of module at address; null if none.
+
+    template <typename Header, typename Section>
+    auto find_section ( size address, Header const & header, section type ) -> Section const *;
+
+    //! Section name of module at address, from section header string table; null if none.
+
+    template <typename Header, typename Section>
+    auto section_name ( size address, Header const & header, Section const & section ) -> char const *;
+
+    //! Symbol table with string table.
+
+    template <typename Symbol>
+    struct symbol_table
+    {
+        Symbol const * symbols;
+        size           count;
+        char const *   strings;
+        size           strings_size;
+
+        //! Symbol name, or null if out of range.
+
+        auto name ( Symbol const & symbol ) const -> char const *;
+
+        //! Symbol with name, by linear search; null if none.
+
+        auto find ( char const * name ) const -> Symbol const *;
+
+        //! Function or object symbol containing address, nearest below if none contains it; null if none.
+
+        auto symbolize ( size8 address ) const -> Symbol const *;
+    };
+
+    //! Symbol table of type, symtab or dynsym, of module at address; empty if none.
+
+    template <typename Header, typename Section, typename Symbol>
+    auto find_symbol_table ( size address, Header const & header, section type ) -> symbol_table<Symbol>;
+
+    //! GNU hash of name.
+
+    constexpr
+    auto gnu_hash ( char const * name ) -> size4;
+
+    //! GNU hash table over symbol table: bloom filter, then bucket chain walk.
+    //!
+    //! Word is the bloom filter word, 32 or 64 bits wide as the ELF class.
+
+    template <typename Word, typename Symbol>
+    class gnu_hash_table
+    {
+        size4         _bucket_count {};
+        size4         _symbol_offset {};
+        size4         _bloom_count {};
+        size4         _bloom_shift {};
+        Word const *  _bloom {};
+        size4 const * _buckets {};
+        size4 const * _chains {};
+
+    public:
+
+        constexpr
+        gnu_hash_table () = default;
+
+        //! Hash table from section or DT_GNU_HASH contents.
+
+        explicit
+        gnu_hash_table ( void const * data );
+
+        auto is_valid () const -> bool { return _bucket_count != 0 && _bloom_count != 0; }
+
+        //! Symbol with name and hash; null if none.
+
+        auto find ( symbol_table<Symbol> const & table, char const * name, size4 hash ) const -> Symbol const *;
+
+        //! Symbol with name; null if none.
+
+        auto find ( symbol_table<Symbol> const & table, char const * name ) const -> Symbol const *
+        {
+            return find(table, name, gnu_hash(name));
+        }
+    };
+}
+
+// Definitions.
+
+namespace elf
+{
+    template <typename Segment>
+    auto plan_segment ( size8 module, Segment const & segment, size8 page_size, segment_plan & plan ) -> bool
+    {
+        auto const mask   = page_size - 1;
+        auto const source = module + segment.offset;
+        if (((source ^ segment.vaddr) & mask) != 0) return false;
+
+        auto const start    = size8(segment.vaddr) & ~mask;
+        auto const file_end = size8(segment.vaddr) + segment.filesz;
+        auto const mem_end  = size8(segment.vaddr) + segment.memsz;
+        auto const up       = [mask] (size8 x) { return (x + mask) & ~mask; };
+
+        plan = {};
+        plan.writable   = (segment.flags & size4(segment_flags::write)) != 0;
+        plan.executable = (segment.flags & size4(segment_flags::execute)) != 0;
+        plan.map_address = start;
+        plan.map_source  = source - (segment.vaddr - start);
+
+        // Without zero fill, the last partial page is mapped in place too.
+        auto const mapped_end = segment.memsz <= segment.filesz ? up(file_end) : (file_end & ~mask);
+        plan.map_pages = (mapped_end - start) / page_size;
+
+        if (segment.memsz > segment.filesz && (file_end & mask) != 0) {
+            plan.copy = true;
+            plan.copy_address = mapped_end > segment.vaddr ? mapped_end : size8(segment.vaddr);
+            plan.copy_source  = source + (plan.copy_address - segment.vaddr);
+            plan.copy_size    = file_end - plan.copy_address;
+        }
+
+        plan.zero_address = up(file_end);
+        plan.zero_pages = up(mem_end) > plan.zero_address ? (up(mem_end) - plan.zero_address) / page_size : 0;
+
+        return true;
+    }
+}
+
+namespace elf
+{
+    template <typename Dynamic>
+    auto find_relocations ( Dynamic const * dynamic, size count, size8 bias ) -> relocations
+    {
+        relocations tables {};
+        for (auto i = dynamic; i != dynamic + count && i->tag != size4(dynamic_tag::DT_NULL); ++i)
+        {
+            switch (dynamic_tag(size4(i->tag)))
+            {
+            case dynamic_tag::DT_REL:    tables.rel = bias + i->value; break;
+            case dynamic_tag::DT_RELSZ:  tables.rel_size = i->value; break;
+            case dynamic_tag::DT_RELA:   tables.rela = bias + i->value; break;
+            case dynamic_tag::DT_RELASZ: tables.rela_size = i->value; break;
+            case dynamic_tag::DT_RELR:   tables.relr = bias + i->value; break;
+            case dynamic_tag::DT_RELRSZ: tables.relr_size = i->value; break;
+            default: break;
+            }
+        }
+        return tables;
+    }
+
+    namespace internal
+    {
+        // Relocated word at offset lies inside image from low to high.
+
+        template <typename Word>
+        auto is_inside ( size8 offset, size8 low, size8 high ) -> bool
+        {
+            return offset >= low && high >= sizeof(Word) && offset <= high - sizeof(Word);
+        }
+
+        // Table at address loaded with bias lies inside image from low to high; absent tables do.
+
+        inline
+        auto is_inside ( size8 address, size8 length, size8 bias, size8 low, size8 high ) -> bool
+        {
+            if (length == 0) return true;
+            auto const offset = address - bias;
+            return offset >= low && offset <= high && length <= high - offset;
+        }
+    }
+
+    template <typename Word>
+    auto relocate_relr ( Word const * relr, size count, size8 low, size8 high, Word bias ) -> bool
+    {
+        return relocate_relr(relr, count, low, high, bias, bias);
+    }
+
+    template <typename Word>
+    auto relocate_relr ( Word const * relr, size count, size8 low, size8 high, Word bias, Word alias ) -> bool
+    {
+        constexpr auto bits = sizeof(Word) * 8;
+        bool started = false;
+        size8 next = 0;
+        for (size i = 0; i != count; ++i)
+        {
+            auto const entry = relr[i];
+            if ((entry & 1) == 0) {
+                if (! internal::is_inside<Word>(entry, low, high)) return false;
+                *reinterpret_cast<Word *>(size(entry + alias)) += bias;
+                next = size8(entry) + sizeof(Word);
+                started = true;
+                continue;
+            }
+            if (! started) return false;
+            auto bitmap = entry >> 1;
+            for (size j = 0; bitmap != 0; ++j, bitmap >>= 1) {
+                if ((bitmap & 1) == 0) continue;
+                auto const offset = next + j * sizeof(Word);
+                if (! internal::is_inside<Word>(offset, low, high)) return false;
+                *reinterpret_cast<Word *>(size(Word(offset) + alias)) += bias;
+            }
+            next += (bits - 1) * sizeof(Word);
+        }
+        return true;
+    }
+
+    inline
+    auto relocate_32 ( relocations const & tables, size8 low, size8 high, size4 bias ) -> bool
+    {
+        if (! internal::is_inside(tables.rel, tables.rel_size, bias, low, high)) return false;
+        if (! internal::is_inside(tables.rela, tables.rela_size, bias, low, high)) return false;
+        if (! internal::is_inside(tables.relr, tables.relr_size, bias, low, high)) return false;
+
+        auto rel = reinterpret_cast<rel_32 const *>(size(tables.rel));
+        auto const rel_count = size(tables.rel_size / sizeof(rel_32));
+        for (size i = 0; i != rel_count; ++i) {
+            auto const type = rel[i].info & 0xFF;
+            if (type == size4(relocation::R_386_NONE)) continue;
+            if (type != size4(relocation::R_386_RELATIVE) || ! internal::is_inside<size4>(rel[i].offset, low, high)) return false;
+            *reinterpret_cast<size4 *>(size(rel[i].offset + bias)) += bias;
+        }
+
+        auto rela = reinterpret_cast<rela_32 const *>(size(tables.rela));
+        auto const rela_count = size(tables.rela_size / sizeof(rela_32));
+        for (size i = 0; i != rela_count; ++i) {
+            auto const type = rela[i].info & 0xFF;
+            if (type == size4(relocation::R_386_NONE)) continue;
+            if (type != size4(relocation::R_386_RELATIVE) || ! internal::is_inside<size4>(rela[i].offset, low, high)) return false;
+            *reinterpret_cast<size4 *>(size(rela[i].offset + bias)) = rela[i].addend + bias;
+        }
+
+        return relocate_relr(reinterpret_cast<size4 const *>(size(tables.relr)), size(tables.relr_size / sizeof(size4)), low, high, bias);
+    }
+
+    inline
+    auto relocate_64 ( relocations const & tables, size8 low, size8 high, size8 bias ) -> bool
+    {
+        return relocate_64(tables, low, high, bias, bias);
+    }
+
+    inline
+    auto relocate_64 ( relocations const & tables, size8 low, size8 high, size8 bias, size8 alias ) -> bool
+    {
+        if (! internal::is_inside(tables.rela, tables.rela_size, alias, low, high)) return false;
+        if (! internal::is_inside(tables.relr, tables.relr_size, alias, low, high)) return false;
+
+        auto rela = reinterpret_cast<rela_64 const *>(size(tables.rela));
+        auto const rela_count = size(tables.rela_size / sizeof(rela_64));
+        for (size i = 0; i != rela_count; ++i) {
+            auto const type = rela[i].info & 0xFFFFFFFF;
+            if (type == size4(relocation::R_X86_64_NONE)) continue;
+            if (type != size4(relocation::R_X86_64_RELATIVE) || ! internal::is_inside<size8>(rela[i].offset, low, high)) return false;
+            *reinterpret_cast<size8 *>(size(rela[i].offset + alias)) = rela[i].addend + bias;
+        }
+
+        return relocate_relr(reinterpret_cast<size8 const *>(size(tables.relr)), size(tables.relr_size / sizeof(size8)), low, high, bias, alias);
+    }
+}
+
+namespace elf
+{
+    template <typename Header, typename Section>
+    auto find_section ( size address, Header const & header, size index ) -> Section const *
+    {
+        if (header.shoff == 0 || index >= header.shnum || header.shentsize < sizeof(Section)) return nullptr;
+        return reinterpret_cast<Section const *>(address + size(header.shoff) + index * header.shentsize);
+    }
+
+    template <typename Header, typename Section>
+    auto find_section ( size address, Header const & header, section type ) -> Section const *
+    {
+        for (size i = 0; i != header.shnum; ++i) {
+            auto const section = find_section<Header, Section>(address, header, i);
+            if (section != nullptr && section->type == type) return section;
+        }
+        return nullptr;
+    }
+
+    template <typename Header, typename Section>
+    auto section_name ( size address, Header const & header, Section const & section ) -> char const *
+    {
+        auto const strings = find_section<Header, Section>(address, header, size(header.shstrndx));
+        if (strings == nullptr || section.name >= strings->size) return nullptr;
+        return reinterpret_cast<char const *>(address + size(strings->offset) + section.name);
+    }
+
+    template <typename Symbol>
+    auto symbol_table<Symbol>::name ( Symbol const & symbol ) const -> char const *
+    {
+        if (symbol.name >= strings_size) return nullptr;
+        return strings + symbol.name;
+    }
+
+    template <typename Symbol>
+    auto symbol_table<Symbol>::find ( char const * name ) const -> Symbol const *
+    {
+        for (size i = 1; i < count; ++i) {
+            auto const other = this->name(symbols[i]);
+            if (other == nullptr) continue;
+            size j = 0;
+            while (name[j] != 0 && name[j] == other[j]) ++j;
+            if (name[j] == other[j]) return symbols + i;
+        }
+        return nullptr;
+    }
+
+    template <typename Symbol>
+    auto symbol_table<Symbol>::symbolize ( size8 address ) const -> Symbol const *
+    {
+        Symbol const * nearest = nullptr;
+        for (size i = 1; i < count; ++i) {
+            auto const & symbol = symbols[i];
+            auto const type = symbol_type(symbol.info & 0xF);
+            if (type != symbol_type::STT_FUNC && type != symbol_type::STT_OBJECT) continue;
+            if (symbol.shndx == 0 || symbol.value > address) continue;
+            if (address - symbol.value < symbol.size) return & symbol;
+            if (nearest == nullptr || symbol.value > nearest->value) nearest = & symbol;
+        }
+        return nearest;
+    }
+
+    template <typename Header, typename Section, typename Symbol>
+    auto find_symbol_table ( size address, Header const & header, section type ) -> symbol_table<Symbol>
+    {
+        auto const symbols = find_section<Header, Section>(address, header, type);
+        if (symbols == nullptr || symbols->entsize < sizeof(Symbol)) return {};
+        auto const strings = find_section<Header, Section>(address, header, size(symbols->link));
+        if (strings == nullptr || strings->type != section::SHT_STRTAB) return {};
+        return {
+            reinterpret_cast<Symbol const *>(address + size(symbols->offset)),
+            size(symbols->size / sizeof(Symbol)),
+            reinterpret_cast<char const *>(address + size(strings->offset)),
+            size(strings->size)
+        };
+    }
+
+    constexpr
+    auto gnu_hash ( char const * name ) -> size4
+    {
+        size4 hash = 5381;
+        for (; *name != 0; ++name) hash = hash * 33 + size1(*name);
+        return hash;
+    }
+
+    template <typename Word, typename Symbol>
+    gnu_hash_table<Word, Symbol>::gnu_hash_table ( void const * data )
+    {
+        auto const words = static_cast<size4 const *>(data);
+        _bucket_count  = words[0];
+        _symbol_offset = words[1];
+        _bloom_count   = words[2];
+        _bloom_shift   = words[3];
+        _bloom   = reinterpret_cast<Word const *>(words + 4);
+        _buckets = reinterpret_cast<size4 const *>(_bloom + _bloom_count);
+        _chains  = _buckets + _bucket_count;
+    }
+
+    template <typename Word, typename Symbol>
+    auto gnu_hash_table<Word, Symbol>::find ( symbol_table<Symbol> const & table, char const * name, size4 hash ) const -> Symbol const *
+    {
+        if (! is_valid()) return nullptr;
+
+        // Bloom filter: two bits per symbol; most absent names stop here.
+        constexpr size4 bits = sizeof(Word) * 8;
+        auto const word = _bloom[(hash / bits) % _bloom_count];
+        auto const mask = (Word(1) << (hash % bits)) | (Word(1) << ((hash >> _bloom_shift) % bits));
+        if ((word & mask) != mask) return nullptr;
+
+        auto index = _buckets[hash % _bucket_count];
+        if (index < _symbol_offset) return nullptr;
+
+        // Chain values are hashes with the low bit marking the end of the chain.
+        while (index < table.count) {
+            auto const chain = _chains[index - _symbol_offset];
+            if ((chain | 1) == (hash | 1)) {
+                auto const other = table.name(table.symbols[index]);
+                if (other != nullptr) {
+                    size j = 0;
+                    while (name[j] != 0 && name[j] == other[j]) ++j;
+                    if (name[j] == other[j]) return table.symbols + index;
+                }
+            }
+            if ((chain & 1) != 0) break;
+            ++index;
+        }
+        return nullptr;
+    }
+}
+
+namespace elf
+{
+    template <typename Header, typename Segment>
+    image<Header, Segment>::image ( size address, size length ) : _address { address }
+    {
+        using word = decltype(Segment::vaddr);
+        constexpr auto is_32 = sizeof(Segment) == sizeof(segment_32);
+
+        if (length < sizeof(Header)) return;
+
+        auto const & header = this->header();
+        auto const & ident = header.ident;
+        if (ident.mag0 != 0x7F || ident.mag1 != 'E' || ident.mag2 != 'L' || ident.mag3 != 'F'
+            || ident.type != (is_32 ? 1 : 2) || ident.data != 1 || ident.version != 1) {
+            _status = image_status::bad_identity;
+            return;
+        }
+        if (header.type != size2(file_type::ET_EXEC) && header.type != size2(file_type::ET_DYN)) {
+            _status = image_status::bad_type;
+            return;
+        }
+        if (header.machine != (is_32 ? machine::EM_386 : machine::EM_X86_64)) {
+            _status = image_status::bad_machine;
+            return;
+        }
+
+        // Program header table.
+        if (header.phnum != 0 && (header.phentsize < sizeof(Segment) || (address + size(header.phoff)) % alignof(Segment) != 0)) {
+            _status = image_status::bad_segment_table;
+            return;
+        }
+        if (header.phoff > length || size8(header.phnum) * header.phentsize > length - size8(header.phoff)) {
+            _status = image_status::truncated;
+            return;
+        }
+
+        // Segments.
+        bool   loadable = false;
+        size8  previous = 0;
+        for (size i = 0; i != header.phnum; ++i)
+        {
+            auto const & segment = segment_at(i);
+            if (segment.filesz > length || segment.offset > length - segment.filesz) {
+                _status = image_status::segment_outside;
+                return;
+            }
+            if (segment.type != elf::segment::load) continue;
+
+            auto const align = segment.align;
+            if (segment.filesz > segment.memsz
+                || segment.memsz > word(~word(0) - segment.vaddr)
+                || (align > 1 && ((align & (align - 1)) != 0 || ((segment.vaddr - segment.offset) & (align - 1)) != 0))) {
+                _status = image_status::bad_segment;
+                return;
+            }
+            if (loadable && segment.vaddr < previous) {
+                _status = image_status::segment_overlap;
+                return;
+            }
+            if (! loadable) _low = segment.vaddr;
+            loadable = true;
+            previous = size8(segment.vaddr) + segment.memsz;
+        }
+        _high = loadable ? previous : _low;
+
+        if (header.entry != 0 && (header.entry < _low || header.entry >= _high)) {
+            _status = image_status::bad_entry;
+            return;
+        }
+
+        _status = image_status::valid;
+    }
+}
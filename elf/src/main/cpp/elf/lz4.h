@@ -0,0 +1,78 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.psys;
+
+namespace elf
+{
+    //! Decode LZ4 block of source size into target of target size; false if malformed or target too small.
+    //!
+    //! Every length and match offset is checked against source and target before use:
+    //! malformed input never reads or writes out of bounds. Written is the decoded size.
+
+    auto lz4_decode ( void const * source, ps::size source_size, void * target, ps::size target_size, ps::size & written ) -> bool;
+}
+
+// Definitions.
+
+namespace elf
+{
+    inline
+    auto lz4_decode ( void const * source, ps::size source_size, void * target, ps::size target_size, ps::size & written ) -> bool
+    {
+        auto in = static_cast<ps::size1 const *>(source);
+        auto const in_end = in + source_size;
+        auto const out_begin = static_cast<ps::size1 *>(target);
+        auto out = out_begin;
+        auto const out_end = out + target_size;
+
+        // Lengths of 15 continue in following bytes, while they are 255.
+        auto const extend = [&] (ps::size & length) -> bool
+        {
+            if (length != 15) return true;
+            ps::size1 byte;
+            do {
+                if (in == in_end) return false;
+                byte = *in++;
+                length += byte;
+            } while (byte == 255);
+            return true;
+        };
+
+        while (in != in_end)
+        {
+            auto const token = *in++;
+
+            ps::size literals = token >> 4;
+            if (! extend(literals)) return false;
+            if (literals > ps::size(in_end - in) || literals > ps::size(out_end - out)) return false;
+            for (ps::size i = 0; i != literals; ++i)
+                out[i] = in[i];
+            in += literals;
+            out += literals;
+
+            // Last sequence has literals only.
+            if (in == in_end) break;
+
+            if (in_end - in < 2) return false;
+            auto const offset = ps::size(in[0]) | (ps::size(in[1]) << 8);
+            in += 2;
+            if (offset == 0 || offset > ps::size(out - out_begin)) return false;
+
+            ps::size match = token & 0xF;
+            if (! extend(match)) return false;
+            match += 4;
+            if (match > ps::size(out_end - out)) return false;
+
+            // Byte by byte: matches may overlap their own output.
+            auto const from = out - offset;
+            for (ps::size i = 0; i != match; ++i)
+                out[i] = from[i];
+            out += match;
+        }
+
+        written = ps::size(out - out_begin);
+        return true;
+    }
+}
@@ -1,16 +1,59 @@
 module;
 
+#include <elf/compressed.h>
+#include <elf/copy_queue.h>
 #include <elf/elf.h>
+#include <elf/lz4.h>
 
 export module br.dev.pedrolamarao.metal.elf;
 
 export namespace elf
 {
     using ::elf::machine;
+    using ::elf::file_type;
     using ::elf::segment;
+    using ::elf::segment_flags;
     using ::elf::prologue;
     using ::elf::header_32;
     using ::elf::segment_32;
     using ::elf::header_64;
     using ::elf::segment_64;
+    using ::elf::segment_plan;
+    using ::elf::plan_segment;
+    using ::elf::image_status;
+    using ::elf::image;
+    using ::elf::image_32;
+    using ::elf::image_64;
+    using ::elf::dynamic_tag;
+    using ::elf::dynamic_32;
+    using ::elf::dynamic_64;
+    using ::elf::rel_32;
+    using ::elf::rela_32;
+    using ::elf::rela_64;
+    using ::elf::relocation;
+    using ::elf::relocations;
+    using ::elf::find_relocations;
+    using ::elf::relocate_32;
+    using ::elf::relocate_64;
+    using ::elf::relocate_relr;
+    using ::elf::section;
+    using ::elf::section_32;
+    using ::elf::section_64;
+    using ::elf::symbol_32;
+    using ::elf::symbol_64;
+    using ::elf::symbol_type;
+    using ::elf::find_section;
+    using ::elf::section_name;
+    using ::elf::symbol_table;
+    using ::elf::find_symbol_table;
+    using ::elf::gnu_hash;
+    using ::elf::gnu_hash_table;
+    using ::elf::copy_job;
+    using ::elf::copy_queue;
+    using ::elf::lz4_decode;
+    using ::elf::compressed_magic;
+    using ::elf::compressed_header;
+    using ::elf::compressed_frame;
+    using ::elf::is_compressed;
+    using ::elf::compressed_module;
 }
\ No newline at end of file
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <thread>
+
 import br.dev.pedrolamarao.metal.elf;
 
 namespace elf
@@ -26,6 +29,659 @@ namespace elf
     }
 }
 
+namespace elf
+{
+    TEST(plan_segment, congruent)
+    {
+        // Text: file [0x1000, 0x3800) at 0x401000, no zero fill: last partial page mapped in place.
+        segment_64 text { segment::load, segment_flags::read | segment_flags::execute, 0x1000, 0x401000, 0x401000, 0x2800, 0x2800, 0x1000 };
+        segment_plan plan {};
+        ASSERT_TRUE(plan_segment(0x800000, text, 0x1000, plan));
+        ASSERT_EQ(plan.map_address, 0x401000);
+        ASSERT_EQ(plan.map_source, 0x801000);
+        ASSERT_EQ(plan.map_pages, 3);
+        ASSERT_FALSE(plan.copy);
+        ASSERT_EQ(plan.zero_pages, 0);
+        ASSERT_TRUE(plan.executable);
+        ASSERT_FALSE(plan.writable);
+
+        // Data: file [0x3800, 0x5200) at 0x404800, zero fill up to 0x408000.
+        segment_64 data { segment::load, segment_flags::read | segment_flags::write, 0x3800, 0x404800, 0x404800, 0x1A00, 0x3800, 0x1000 };
+        ASSERT_TRUE(plan_segment(0x800000, data, 0x1000, plan));
+        ASSERT_EQ(plan.map_address, 0x404000);
+        ASSERT_EQ(plan.map_source, 0x803000);
+        ASSERT_EQ(plan.map_pages, 2);
+        ASSERT_TRUE(plan.copy);
+        ASSERT_EQ(plan.copy_address, 0x406000);
+        ASSERT_EQ(plan.copy_source, 0x805000);
+        ASSERT_EQ(plan.copy_size, 0x200);
+        ASSERT_EQ(plan.zero_address, 0x407000);
+        ASSERT_EQ(plan.zero_pages, 1);
+        ASSERT_TRUE(plan.writable);
+    }
+
+    TEST(plan_segment, small)
+    {
+        // File data and zero fill inside one page: nothing mapped, one fresh page.
+        segment_32 data { segment::load, 0x2100, 0x402100, 0x402100, 0x10, 0x40, segment_flags::write, 0x1000 };
+        segment_plan plan {};
+        ASSERT_TRUE(plan_segment(0x100000, data, 0x1000, plan));
+        ASSERT_EQ(plan.map_pages, 0);
+        ASSERT_TRUE(plan.copy);
+        ASSERT_EQ(plan.copy_address, 0x402100);
+        ASSERT_EQ(plan.copy_source, 0x102100);
+        ASSERT_EQ(plan.copy_size, 0x10);
+        ASSERT_EQ(plan.zero_pages, 0);
+
+        // Zero fill only, page aligned.
+        segment_32 bss { segment::load, 0x3000, 0x403000, 0x403000, 0, 0x2001, segment_flags::write, 0x1000 };
+        ASSERT_TRUE(plan_segment(0x100000, bss, 0x1000, plan));
+        ASSERT_EQ(plan.map_pages, 0);
+        ASSERT_FALSE(plan.copy);
+        ASSERT_EQ(plan.zero_address, 0x403000);
+        ASSERT_EQ(plan.zero_pages, 3);
+    }
+
+    TEST(plan_segment, incongruent)
+    {
+        segment_64 text { segment::load, segment_flags::execute, 0x1000, 0x401000, 0x401000, 0x100, 0x100, 0x10 };
+        segment_plan plan {};
+        ASSERT_FALSE(plan_segment(0x800010, text, 0x1000, plan));
+    }
+}
+
+namespace elf
+{
+    TEST(relocate, relative_64)
+    {
+        // Image linked at zero: words at 0x00 to 0x78, relocations and dynamic section after.
+        alignas(8) size8 image [64] {};
+        auto const bias = size8(reinterpret_cast<size>(image));
+
+        // RELA: word 0 = bias + 0x100, word 1 = bias + 0x200.
+        auto rela = reinterpret_cast<rela_64 *>(image + 16);
+        rela[0] = { 0x00, size8(relocation::R_X86_64_RELATIVE), 0x100 };
+        rela[1] = { 0x08, size8(relocation::R_X86_64_RELATIVE), 0x200 };
+
+        // RELR: address 0x10, then bitmap for words 0x18 and 0x28.
+        image[2] = 0x300;
+        image[3] = 0x400;
+        image[5] = 0x500;
+        image[4] = 0x600;
+        image[24] = 0x10;
+        image[25] = (size8(0b101) << 1) | 1;
+
+        dynamic_64 const dynamic [] {
+            { size8(dynamic_tag::DT_RELA), 16 * 8 },
+            { size8(dynamic_tag::DT_RELASZ), 2 * sizeof(rela_64) },
+            { size8(dynamic_tag::DT_RELAENT), sizeof(rela_64) },
+            { size8(dynamic_tag::DT_RELR), 24 * 8 },
+            { size8(dynamic_tag::DT_RELRSZ), 2 * 8 },
+            { size8(dynamic_tag::DT_NULL), 0 },
+        };
+
+        auto const tables = find_relocations(dynamic, sizeof(dynamic) / sizeof(dynamic[0]), bias);
+        ASSERT_EQ(tables.rela, bias + 16 * 8);
+        ASSERT_EQ(tables.relr_size, 16);
+        ASSERT_EQ(tables.rel, 0);
+
+        ASSERT_TRUE(relocate_64(tables, 0, sizeof(image), bias));
+        ASSERT_EQ(image[0], bias + 0x100);
+        ASSERT_EQ(image[1], bias + 0x200);
+        ASSERT_EQ(image[2], bias + 0x300);
+        ASSERT_EQ(image[3], bias + 0x400);
+        ASSERT_EQ(image[4], 0x600);
+        ASSERT_EQ(image[5], bias + 0x500);
+
+        // Symbolic relocation is not supported.
+        rela[1].info = (size8(1) << 32) | 1;
+        ASSERT_FALSE(relocate_64(tables, 0, sizeof(image), bias));
+    }
+
+    TEST(relocate, bounds_64)
+    {
+        // Image linked at 0x1000: relocations outside it are rejected.
+        alignas(8) size8 image [32] {};
+        auto const bias = size8(reinterpret_cast<size>(image)) - 0x1000;
+
+        auto rela = reinterpret_cast<rela_64 *>(image + 8);
+        rela[0] = { 0x1000, size8(relocation::R_X86_64_RELATIVE), 0x100 };
+
+        dynamic_64 const dynamic [] {
+            { size8(dynamic_tag::DT_RELA), 0x1000 + 8 * 8 },
+            { size8(dynamic_tag::DT_RELASZ), sizeof(rela_64) },
+            { size8(dynamic_tag::DT_NULL), 0 },
+        };
+        auto const tables = find_relocations(dynamic, sizeof(dynamic) / sizeof(dynamic[0]), bias);
+
+        ASSERT_TRUE(relocate_64(tables, 0x1000, 0x1000 + sizeof(image), bias));
+        ASSERT_EQ(image[0], bias + 0x100);
+
+        // Below the image, past its end, and straddling its end.
+        rela[0].offset = 0xFF8;
+        ASSERT_FALSE(relocate_64(tables, 0x1000, 0x1000 + sizeof(image), bias));
+        rela[0].offset = 0x1000 + sizeof(image);
+        ASSERT_FALSE(relocate_64(tables, 0x1000, 0x1000 + sizeof(image), bias));
+        rela[0].offset = 0x1000 + sizeof(image) - 4;
+        ASSERT_FALSE(relocate_64(tables, 0x1000, 0x1000 + sizeof(image), bias));
+        ASSERT_EQ(image[31], 0);
+    }
+
+    TEST(relocate, tables_64)
+    {
+        // Image linked at zero: relocation tables outside it are rejected before reading them.
+        alignas(8) size8 image [32] {};
+        auto const bias = size8(reinterpret_cast<size>(image));
+
+        auto rela = reinterpret_cast<rela_64 *>(image + 8);
+        rela[0] = { 0x00, size8(relocation::R_X86_64_RELATIVE), 0x100 };
+
+        // No DT_NULL: the walk stops at the count.
+        dynamic_64 dynamic [] {
+            { size8(dynamic_tag::DT_RELA), 8 * 8 },
+            { size8(dynamic_tag::DT_RELASZ), sizeof(rela_64) },
+            { size8(dynamic_tag::DT_RELR), 0 },
+        };
+        auto tables = find_relocations(dynamic, 2, bias);
+        ASSERT_EQ(tables.relr, 0);
+        ASSERT_TRUE(relocate_64(tables, 0, sizeof(image), bias));
+        ASSERT_EQ(image[0], bias + 0x100);
+
+        // Table running past the image end.
+        dynamic[1].value = sizeof(image);
+        ASSERT_FALSE(relocate_64(find_relocations(dynamic, 2, bias), 0, sizeof(image), bias));
+
+        // Table size without table address.
+        dynamic[1] = { size8(dynamic_tag::DT_RELRSZ), 8 };
+        ASSERT_FALSE(relocate_64(find_relocations(dynamic + 1, 1, bias), 0, sizeof(image), bias));
+    }
+
+    TEST(relocate, alias_64)
+    {
+        // Image written here, but running in the high half.
+        alignas(8) size8 image [32] {};
+        auto const alias = size8(reinterpret_cast<size>(image));
+        auto const bias = size8(0xFFFFFFFF80200000);
+
+        auto rela = reinterpret_cast<rela_64 *>(image + 8);
+        rela[0] = { 0x00, size8(relocation::R_X86_64_RELATIVE), 0x100 };
+        image[1] = 0x200;
+        image[16] = 0x08;
+
+        dynamic_64 const dynamic [] {
+            { size8(dynamic_tag::DT_RELA), 8 * 8 },
+            { size8(dynamic_tag::DT_RELASZ), sizeof(rela_64) },
+            { size8(dynamic_tag::DT_RELR), 16 * 8 },
+            { size8(dynamic_tag::DT_RELRSZ), 8 },
+            { size8(dynamic_tag::DT_NULL), 0 },
+        };
+
+        ASSERT_TRUE(relocate_64(find_relocations(dynamic, sizeof(dynamic) / sizeof(dynamic[0]), alias), 0, sizeof(image), bias, alias));
+        ASSERT_EQ(image[0], bias + 0x100);
+        ASSERT_EQ(image[1], bias + 0x200);
+    }
+
+    TEST(relocate, relr_bitmap)
+    {
+        // Image linked at zero: address entry for word 0, then full bitmaps for words 1 to 63 and 64 to 126.
+        size8 words [128] {};
+        for (unsigned i = 0; i != 128; ++i) words[i] = i;
+        auto const bias = size8(reinterpret_cast<size>(words));
+        size8 const relr [] { 0x0, ~size8(0), ~size8(0) };
+        ASSERT_TRUE(relocate_relr(relr, 3, 0, sizeof(words), bias));
+        for (unsigned i = 0; i != 127; ++i) ASSERT_EQ(words[i], bias + i);
+        ASSERT_EQ(words[127], 127);
+    }
+
+    TEST(relocate, relr_invalid)
+    {
+        size8 words [64] {};
+        auto const bias = size8(reinterpret_cast<size>(words));
+
+        // Bitmap before any address.
+        size8 const leading [] { 0b11, 0x0 };
+        ASSERT_FALSE(relocate_relr(leading, 2, 0, sizeof(words), bias));
+        ASSERT_EQ(words[0], 0);
+
+        // Address past the image.
+        size8 const outside [] { sizeof(words) };
+        ASSERT_FALSE(relocate_relr(outside, 1, 0, sizeof(words), bias));
+
+        // Bitmap running past the image: words up to the end are relocated first.
+        size8 const running [] { 0x8, ~size8(0) };
+        ASSERT_FALSE(relocate_relr(running, 2, 0, sizeof(words), bias));
+        ASSERT_EQ(words[63], bias);
+    }
+}
+
+namespace elf
+{
+    // 64-bit image with sections: null, symtab, strtab, shstrtab, gnu hash.
+
+    struct symbol_image
+    {
+        alignas(8) size1 bytes [2048] {};
+
+        static constexpr unsigned symbols_offset  = 0x100;
+        static constexpr unsigned strings_offset  = 0x200;
+        static constexpr unsigned names_offset    = 0x280;
+        static constexpr unsigned hash_offset     = 0x300;
+        static constexpr unsigned sections_offset = 0x400;
+
+        symbol_image ()
+        {
+            auto & header = * reinterpret_cast<header_64 *>(bytes);
+            header.shoff = sections_offset;
+            header.shentsize = sizeof(section_64);
+            header.shnum = 5;
+            header.shstrndx = 3;
+
+            char const strings [] = "\0alpha\0beta\0gamma\0delta\0";
+            for (unsigned i = 0; i != sizeof(strings); ++i) bytes[strings_offset + i] = strings[i];
+            char const names [] = "\0.symtab\0.strtab\0.shstrtab\0.gnu.hash\0";
+            for (unsigned i = 0; i != sizeof(names); ++i) bytes[names_offset + i] = names[i];
+
+            // Symbols ordered by bucket, as the GNU hash table requires: two buckets, hashes alternate parity.
+            struct { unsigned name; size8 value; size8 size; } const entries [] {
+                { 1, 0x1000, 0x100 }, { 7, 0x1100, 0x80 }, { 12, 0x2000, 0x10 }, { 18, 0x1200, 0x40 }
+            };
+            unsigned order [4] {}, count = 0;
+            for (unsigned bucket = 0; bucket != 2; ++bucket)
+                for (unsigned i = 0; i != 4; ++i)
+                    if (gnu_hash(reinterpret_cast<char const *>(bytes + strings_offset + entries[i].name)) % 2 == bucket) order[count++] = i;
+
+            auto symbols = reinterpret_cast<symbol_64 *>(bytes + symbols_offset);
+            for (unsigned i = 0; i != 4; ++i) {
+                auto const & x = entries[order[i]];
+                symbols[i + 1] = { x.name, size1(x.value == 0x2000 ? 1 : 2), 0, 1, x.value, x.size };
+            }
+
+            // Hash table: 2 buckets, symbol offset 1, 1 bloom word, shift 6.
+            auto hash = reinterpret_cast<size4 *>(bytes + hash_offset);
+            hash[0] = 2; hash[1] = 1; hash[2] = 1; hash[3] = 6;
+            auto & bloom = * reinterpret_cast<size8 *>(hash + 4);
+            auto buckets = hash + 6;
+            auto chains = hash + 8;
+            for (unsigned i = 0; i != 4; ++i) {
+                auto const h = gnu_hash(reinterpret_cast<char const *>(bytes + strings_offset + symbols[i + 1].name));
+                bloom |= (size8(1) << (h % 64)) | (size8(1) << ((h >> 6) % 64));
+                if (buckets[h % 2] == 0) buckets[h % 2] = i + 1;
+                auto const last = i == 3 || gnu_hash(reinterpret_cast<char const *>(bytes + strings_offset + symbols[i + 2].name)) % 2 != h % 2;
+                chains[i] = (h & ~size4(1)) | (last ? 1 : 0);
+            }
+
+            auto sections = reinterpret_cast<section_64 *>(bytes + sections_offset);
+            sections[1] = { 1, section::SHT_SYMTAB, 0, 0, symbols_offset, 5 * sizeof(symbol_64), 2, 1, 8, sizeof(symbol_64) };
+            sections[2] = { 9, section::SHT_STRTAB, 0, 0, strings_offset, sizeof(strings), 0, 0, 1, 0 };
+            sections[3] = { 17, section::SHT_STRTAB, 0, 0, names_offset, sizeof(names), 0, 0, 1, 0 };
+            sections[4] = { 27, section::SHT_GNU_HASH, 0, 0, hash_offset, 0x40, 1, 0, 8, 0 };
+        }
+
+        auto address () const -> size { return reinterpret_cast<size>(bytes); }
+
+        auto header () const -> header_64 const & { return * reinterpret_cast<header_64 const *>(bytes); }
+    };
+
+    TEST(symbols, sections)
+    {
+        static symbol_image image;
+        auto const strings = find_section<header_64, section_64>(image.address(), image.header(), section::SHT_STRTAB);
+        ASSERT_NE(strings, nullptr);
+        ASSERT_STREQ(section_name(image.address(), image.header(), *strings), ".strtab");
+        auto const none = find_section<header_64, section_64>(image.address(), image.header(), size(5));
+        ASSERT_EQ(none, nullptr);
+        auto const dynamic = find_section<header_64, section_64>(image.address(), image.header(), section::SHT_DYNSYM);
+        ASSERT_EQ(dynamic, nullptr);
+    }
+
+    TEST(symbols, lookup)
+    {
+        static symbol_image image;
+        auto const table = find_symbol_table<header_64, section_64, symbol_64>(image.address(), image.header(), section::SHT_SYMTAB);
+        ASSERT_EQ(table.count, 5);
+
+        auto const hash_section = find_section<header_64, section_64>(image.address(), image.header(), section::SHT_GNU_HASH);
+        gnu_hash_table<size8, symbol_64> hash { reinterpret_cast<void const *>(image.address() + hash_section->offset) };
+        ASSERT_TRUE(hash.is_valid());
+
+        for (auto name : { "alpha", "beta", "gamma", "delta" }) {
+            auto const linear = table.find(name);
+            ASSERT_NE(linear, nullptr) << name;
+            ASSERT_STREQ(table.name(*linear), name);
+            ASSERT_EQ(hash.find(table, name), linear) << name;
+        }
+        ASSERT_EQ(table.find("epsilon"), nullptr);
+        ASSERT_EQ(hash.find(table, "epsilon"), nullptr);
+        ASSERT_EQ(hash.find(table, "alph"), nullptr);
+    }
+
+    TEST(symbols, symbolize)
+    {
+        static symbol_image image;
+        auto const table = find_symbol_table<header_64, section_64, symbol_64>(image.address(), image.header(), section::SHT_SYMTAB);
+        ASSERT_STREQ(table.name(* table.symbolize(0x1000)), "alpha");
+        ASSERT_STREQ(table.name(* table.symbolize(0x10FF)), "alpha");
+        ASSERT_STREQ(table.name(* table.symbolize(0x1140)), "beta");
+        ASSERT_STREQ(table.name(* table.symbolize(0x2008)), "gamma");
+        // Outside every symbol: nearest below.
+        ASSERT_STREQ(table.name(* table.symbolize(0x1300)), "delta");
+        ASSERT_EQ(table.symbolize(0x0FFF), nullptr);
+    }
+
+    TEST(symbols, gnu_hash)
+    {
+        ASSERT_EQ(gnu_hash(""), 5381);
+        ASSERT_EQ(gnu_hash("printf"), 0x156B2BB8);
+        ASSERT_EQ(gnu_hash("exit"), 0x7C967E3F);
+    }
+}
+
+namespace elf
+{
+    TEST(copy_queue, workers)
+    {
+        static size1 source [0x9000];
+        static size1 target [0x10000];
+        for (unsigned i = 0; i != sizeof(source); ++i) source[i] = size1(i * 7 + 1);
+        for (auto & x : target) x = 0xCC;
+
+        auto const from = [] (unsigned offset) { return reinterpret_cast<size>(source + offset); };
+        auto const to = [] (unsigned offset) { return reinterpret_cast<size>(target + offset); };
+
+        copy_queue<8> queue { 0x1000 };
+        ASSERT_TRUE(queue.add({ to(0x0000), from(0x0000), 0x8000, 0x0800 }));
+        ASSERT_TRUE(queue.add({ to(0x9000), from(0x8000), 0x0010, 0x0000 }));
+        ASSERT_TRUE(queue.add({ to(0xA000), from(0x0000), 0x0000, 0x0000 }));
+        ASSERT_TRUE(queue.add({ to(0xB000), from(0x8800), 0x0123, 0x2EDD }));
+        ASSERT_EQ(queue.size(), 3);
+        ASSERT_EQ(queue.bytes(), 0x8800 + 0x10 + 0x3000);
+        ASSERT_EQ(queue.chunks(), 12);
+
+        unsigned executed [4] {};
+        std::thread threads [4];
+        for (unsigned i = 0; i != 4; ++i) threads[i] = std::thread { [&, i] { executed[i] = queue.run(); } };
+        for (auto & thread : threads) thread.join();
+        queue.wait();
+        ASSERT_TRUE(queue.is_done());
+        ASSERT_EQ(executed[0] + executed[1] + executed[2] + executed[3], 12);
+
+        for (unsigned i = 0; i != 0x8000; ++i) ASSERT_EQ(target[i], source[i]) << i;
+        for (unsigned i = 0x8000; i != 0x8800; ++i) ASSERT_EQ(target[i], 0) << i;
+        ASSERT_EQ(target[0x8800], 0xCC);
+        for (unsigned i = 0; i != 0x10; ++i) ASSERT_EQ(target[0x9000 + i], source[0x8000 + i]);
+        ASSERT_EQ(target[0x9010], 0xCC);
+        for (unsigned i = 0; i != 0x123; ++i) ASSERT_EQ(target[0xB000 + i], source[0x8800 + i]);
+        for (unsigned i = 0x123; i != 0x3000; ++i) ASSERT_EQ(target[0xB000 + i], 0) << i;
+
+        // Running queue accepts no more jobs.
+        ASSERT_FALSE(queue.add({ to(0), from(0), 1, 0 }));
+    }
+}
+
+namespace elf
+{
+    // 64-bit executable with text and data segments, then a dynamic segment.
+
+    struct load_image
+    {
+        alignas(8) size1 bytes [0x400] {};
+
+        load_image ()
+        {
+            auto & header = this->header();
+            header.ident = { 0x7F, 'E', 'L', 'F', 2, 1, 1 };
+            header.type = size2(file_type::ET_EXEC);
+            header.machine = machine::EM_X86_64;
+            header.version = 1;
+            header.entry = 0x401010;
+            header.phoff = sizeof(header_64);
+            header.ehsize = sizeof(header_64);
+            header.phentsize = sizeof(segment_64);
+            header.phnum = 3;
+
+            segments()[0] = { segment::load, segment_flags::read | segment_flags::execute, 0x000, 0x400000, 0x400000, 0x200, 0x200, 0x1000 };
+            segments()[1] = { segment::load, segment_flags::read | segment_flags::write, 0x200, 0x401200, 0x401200, 0x100, 0x800, 0x1000 };
+            segments()[2] = { segment::dynamic, segment_flags::read, 0x300, 0x401300, 0x401300, 0x40, 0x40, 8 };
+        }
+
+        auto address () const -> size { return reinterpret_cast<size>(bytes); }
+
+        auto header () -> header_64 & { return * reinterpret_cast<header_64 *>(bytes); }
+
+        auto segments () -> segment_64 * { return reinterpret_cast<segment_64 *>(bytes + sizeof(header_64)); }
+    };
+
+    TEST(image, valid)
+    {
+        load_image module;
+        image_64 image { module.address(), sizeof(module.bytes) };
+        ASSERT_EQ(image.status(), image_status::valid);
+        ASSERT_EQ(image.segment_count(), 3);
+        ASSERT_EQ(image.segment_at(1).vaddr, 0x401200);
+        ASSERT_EQ(image.low(), 0x400000);
+        ASSERT_EQ(image.high(), 0x401A00);
+
+        // Wrong class.
+        image_32 other { module.address(), sizeof(module.bytes) };
+        ASSERT_EQ(other.status(), image_status::bad_identity);
+    }
+
+    TEST(image, header)
+    {
+        load_image module;
+        ASSERT_EQ(image_64(module.address(), sizeof(header_64) - 1).status(), image_status::truncated);
+        // Program header table ends past length.
+        ASSERT_EQ(image_64(module.address(), sizeof(header_64) + 2 * sizeof(segment_64)).status(), image_status::truncated);
+
+        module.header().ident.mag1 = 'e';
+        ASSERT_EQ(image_64(module.address(), sizeof(module.bytes)).status(), image_status::bad_identity);
+        module.header().ident.mag1 = 'E';
+
+        module.header().type = 1;
+        ASSERT_EQ(image_64(module.address(), sizeof(module.bytes)).status(), image_status::bad_type);
+        module.header().type = size2(file_type::ET_DYN);
+
+        module.header().machine = machine::EM_386;
+        ASSERT_EQ(image_64(module.address(), sizeof(module.bytes)).status(), image_status::bad_machine);
+        module.header().machine = machine::EM_X86_64;
+
+        module.header().phentsize = sizeof(segment_64) - 8;
+        ASSERT_EQ(image_64(module.address(), sizeof(module.bytes)).status(), image_status::bad_segment_table);
+        module.header().phentsize = sizeof(segment_64);
+
+        // Program header table offset overflows.
+        module.header().phoff = ~size8(0) - 7;
+        ASSERT_EQ(image_64(module.address(), sizeof(module.bytes)).status(), image_status::truncated);
+        module.header().phoff = sizeof(header_64);
+
+        module.header().entry = 0x402000;
+        ASSERT_EQ(image_64(module.address(), sizeof(module.bytes)).status(), image_status::bad_entry);
+    }
+
+    TEST(image, segments)
+    {
+        auto const status = [] (load_image & module) { return image_64(module.address(), sizeof(module.bytes)).status(); };
+
+        {
+            // File data past length, also by offset overflow.
+            load_image module;
+            module.segments()[2].filesz = 0x101;
+            ASSERT_EQ(status(module), image_status::segment_outside);
+            module.segments()[2].filesz = 0x40;
+            module.segments()[2].offset = ~size8(0) - 0x3F;
+            ASSERT_EQ(status(module), image_status::segment_outside);
+        }
+        {
+            // File size above memory size.
+            load_image module;
+            module.segments()[1].filesz = 0x900;
+            ASSERT_EQ(status(module), image_status::segment_outside);
+            module.segments()[1].filesz = 0x180;
+            module.segments()[1].memsz = 0x100;
+            ASSERT_EQ(status(module), image_status::bad_segment);
+        }
+        {
+            // Memory range wraps around.
+            load_image module;
+            module.segments()[1].vaddr = ~size8(0) - 0x1FF;
+            ASSERT_EQ(status(module), image_status::bad_segment);
+        }
+        {
+            // Offset and address not congruent modulo alignment; alignment not a power of two.
+            load_image module;
+            module.segments()[1].vaddr = 0x401210;
+            ASSERT_EQ(status(module), image_status::bad_segment);
+            module.segments()[1].vaddr = 0x401200;
+            module.segments()[1].align = 0x3000;
+            ASSERT_EQ(status(module), image_status::bad_segment);
+        }
+        {
+            // Overlapping, then out of order.
+            load_image module;
+            module.segments()[1].vaddr = 0x4001FF;
+            module.segments()[1].align = 1;
+            ASSERT_EQ(status(module), image_status::segment_overlap);
+            module.segments()[1].vaddr = 0x300000;
+            ASSERT_EQ(status(module), image_status::segment_overlap);
+            // Adjacent is fine.
+            module.segments()[1].vaddr = 0x401200;
+            module.segments()[0].memsz = 0x1200;
+            ASSERT_EQ(status(module), image_status::valid);
+        }
+    }
+}
+
+namespace elf
+{
+    // "abc", then match at offset 3 of length 9, then "x".
+    constexpr size1 lz4_repeat [] { 0x35, 'a', 'b', 'c', 0x03, 0x00, 0x10, 'x' };
+
+    // "z", then match at offset 1 of length 15 + 10 + 4.
+    constexpr size1 lz4_run [] { 0x1F, 'z', 0x01, 0x00, 0x0A };
+
+    TEST(lz4, decode)
+    {
+        char target [32] {};
+        size written {};
+        ASSERT_TRUE(lz4_decode(lz4_repeat, sizeof(lz4_repeat), target, sizeof(target), written));
+        ASSERT_EQ(written, 13);
+        ASSERT_EQ(std::string(target, 13), "abcabcabcabcx");
+
+        ASSERT_TRUE(lz4_decode(lz4_run, sizeof(lz4_run), target, sizeof(target), written));
+        ASSERT_EQ(written, 30);
+        ASSERT_EQ(std::string(target, 30), std::string(30, 'z'));
+
+        // Extended literal length: 15 + 1.
+        size1 literals [18] { 0xF0, 0x01 };
+        for (unsigned i = 0; i != 16; ++i) literals[2 + i] = size1('A' + i);
+        ASSERT_TRUE(lz4_decode(literals, sizeof(literals), target, sizeof(target), written));
+        ASSERT_EQ(written, 16);
+        ASSERT_EQ(std::string(target, 16), "ABCDEFGHIJKLMNOP");
+    }
+
+    TEST(lz4, malformed)
+    {
+        char target [32] {};
+        size written {};
+
+        // Target too small, for literals and for match.
+        ASSERT_FALSE(lz4_decode(lz4_repeat, sizeof(lz4_repeat), target, 2, written));
+        ASSERT_FALSE(lz4_decode(lz4_repeat, sizeof(lz4_repeat), target, 12, written));
+
+        // Offset before start of output, and zero.
+        size1 const far [] { 0x10, 'a', 0x02, 0x00 };
+        ASSERT_FALSE(lz4_decode(far, sizeof(far), target, sizeof(target), written));
+        size1 const zero [] { 0x10, 'a', 0x00, 0x00 };
+        ASSERT_FALSE(lz4_decode(zero, sizeof(zero), target, sizeof(target), written));
+
+        // Truncated offset, literals and length.
+        ASSERT_FALSE(lz4_decode(lz4_repeat, 5, target, sizeof(target), written));
+        ASSERT_FALSE(lz4_decode(lz4_repeat, 3, target, sizeof(target), written));
+        ASSERT_FALSE(lz4_decode(lz4_run, 4, target, sizeof(target), written));
+    }
+
+    // Container with frames at offsets 0 and 16 of a 64 byte image.
+
+    struct compressed_image
+    {
+        alignas(8) size1 bytes [80] {};
+
+        compressed_image ()
+        {
+            * reinterpret_cast<compressed_header *>(bytes) = { compressed_magic, 2, 64 };
+            * reinterpret_cast<compressed_frame *>(bytes + 16) = { 0, 13, sizeof(lz4_repeat) };
+            for (unsigned i = 0; i != sizeof(lz4_repeat); ++i) bytes[32 + i] = lz4_repeat[i];
+            * reinterpret_cast<compressed_frame *>(bytes + 40) = { 16, 30, sizeof(lz4_run) };
+            for (unsigned i = 0; i != sizeof(lz4_run); ++i) bytes[56 + i] = lz4_run[i];
+        }
+
+        auto address () const -> size { return reinterpret_cast<size>(bytes); }
+
+        auto frame ( unsigned offset ) -> compressed_frame & { return * reinterpret_cast<compressed_frame *>(bytes + offset); }
+    };
+
+    TEST(compressed, frames)
+    {
+        compressed_image container;
+        ASSERT_TRUE(is_compressed(container.address(), sizeof(container.bytes)));
+
+        // Last block need not be padded.
+        compressed_module module { container.address(), 61 };
+        ASSERT_TRUE(module.is_valid());
+        ASSERT_EQ(module.length(), 64);
+        ASSERT_EQ(module.frame_count(), 2);
+
+        char image [64] {};
+        auto frame = module.first();
+        ASSERT_NE(frame, nullptr);
+        ASSERT_EQ(frame->offset, 0);
+        ASSERT_TRUE(module.decode(*frame, image + frame->offset, sizeof(image) - frame->offset));
+        frame = module.next(frame);
+        ASSERT_NE(frame, nullptr);
+        ASSERT_EQ(frame->offset, 16);
+        ASSERT_FALSE(module.decode(*frame, image + frame->offset, 29));
+        ASSERT_TRUE(module.decode(*frame, image + frame->offset, sizeof(image) - frame->offset));
+        ASSERT_EQ(module.next(frame), nullptr);
+        ASSERT_EQ(std::string(image, 13), "abcabcabcabcx");
+        ASSERT_EQ(std::string(image + 16, 30), std::string(30, 'z'));
+
+        // Frame size must match decoded size.
+        container.frame(40).size = 31;
+        ASSERT_FALSE(module.decode(container.frame(40), image + 16, 48));
+    }
+
+    TEST(compressed, invalid)
+    {
+        {
+            compressed_image container;
+            ASSERT_FALSE(compressed_module(container.address(), 60).is_valid());
+            container.bytes[0] = 0;
+            ASSERT_FALSE(is_compressed(container.address(), sizeof(container.bytes)));
+            ASSERT_FALSE(compressed_module(container.address(), sizeof(container.bytes)).is_valid());
+        }
+        {
+            // Frame header past length.
+            compressed_image container;
+            container.bytes[4] = 3;
+            ASSERT_FALSE(compressed_module(container.address(), sizeof(container.bytes)).is_valid());
+        }
+        {
+            // Frames overlap.
+            compressed_image container;
+            container.frame(40).offset = 12;
+            ASSERT_FALSE(compressed_module(container.address(), sizeof(container.bytes)).is_valid());
+        }
+        {
+            // Frame past image length, also by offset overflow.
+            compressed_image container;
+            container.frame(40).offset = 40;
+            ASSERT_FALSE(compressed_module(container.address(), sizeof(container.bytes)).is_valid());
+            container.frame(40).offset = ~size8(0) - 8;
+            ASSERT_FALSE(compressed_module(container.address(), sizeof(container.bytes)).is_valid());
+        }
+    }
+}
+
 int main (int argc, char* argv[])
 {
     testing::InitGoogleTest(&argc, argv);
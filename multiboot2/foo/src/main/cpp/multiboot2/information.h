@@ -45,6 +45,7 @@ namespace multiboot2
     acpi_old         = 14,
     acpi_new         = 15,
     network          = 16,
+    efi_memory_map   = 17,
   };
 
   namespace internal
@@ -58,6 +59,12 @@ namespace multiboot2
 
   auto next (internal::information_item * item) -> internal::information_item * ;
 
+  auto begin (information_list const & list) -> internal::information_item const * ;
+
+  auto end (information_list const & list) -> internal::information_item const * ;
+
+  auto next (internal::information_item const * item) -> internal::information_item const * ;
+
   //! @brief Multiboot2 end information list
 
   struct end_information
@@ -132,6 +139,35 @@ namespace multiboot2
     ps::size4 entry_version;
   };
 
+  //! @brief Multiboot2 memory map entry type
+
+  enum class memory_type : ps::size4
+  {
+    available        = 1,
+    reserved         = 2,
+    acpi_reclaimable = 3,
+    acpi_nvs         = 4,
+    bad              = 5,
+  };
+
+  //! @brief Multiboot2 memory map entry
+
+  struct memory_map_entry
+  {
+    ps::size8   base;
+    ps::size8   length;
+    memory_type type;
+    ps::size4   reserved;
+  };
+
+  //! @brief Multiboot2 memory map entry count
+
+  auto entry_count (memory_map_information const & map) -> unsigned ;
+
+  //! @brief Multiboot2 memory map entry at index
+
+  auto entry_at (memory_map_information const & map, unsigned index) -> memory_map_entry const & ;
+
   //! @brief Multiboot2 ELF symbols information
 
   struct elf_symbols_information
@@ -214,6 +250,58 @@ namespace multiboot2
     ps::size8 pointer;
   };
 
+  //! @brief Multiboot2 EFI memory map information
+
+  struct efi_memory_map_information
+  {
+    information_type type;
+    ps::size4    size;
+
+    ps::size4 descriptor_size;
+    ps::size4 descriptor_version;
+  };
+
+  //! @brief EFI memory type
+
+  enum class efi_memory_type : ps::size4
+  {
+    reserved              = 0,
+    loader_code           = 1,
+    loader_data           = 2,
+    boot_services_code    = 3,
+    boot_services_data    = 4,
+    runtime_services_code = 5,
+    runtime_services_data = 6,
+    conventional          = 7,
+    unusable              = 8,
+    acpi_reclaimable      = 9,
+    acpi_nvs              = 10,
+    memory_mapped_io      = 11,
+    memory_mapped_io_port = 12,
+    pal_code              = 13,
+    persistent            = 14,
+  };
+
+  //! @brief EFI memory descriptor; pages are 4 KiB
+
+  struct efi_memory_descriptor
+  {
+    efi_memory_type type;
+    ps::size4       padding;
+    ps::size8       physical_start;
+    ps::size8       virtual_start;
+    ps::size8       page_count;
+    ps::size8       attribute;
+  };
+
+  //! @brief Multiboot2 EFI memory map descriptor count
+
+  auto descriptor_count (efi_memory_map_information const & map) -> unsigned ;
+
+  //! @brief Multiboot2 EFI memory map descriptor at index
+
+  auto descriptor_at (efi_memory_map_information const & map, unsigned index) -> efi_memory_descriptor const & ;
+
   //! @brief Multiboot2 SMBIOS information
 
   struct smbios_information
@@ -247,6 +335,95 @@ namespace multiboot2
     ps::size1 dhcpack [];
   };
 
+  //! @brief Multiboot2 modules information range
+  //!
+  //! Iterates modules information items from the first to the last, skipping other items in between.
+
+  class module_range
+  {
+    internal::information_item const * _first {};
+    internal::information_item const * _end {};
+
+  public:
+
+    class iterator
+    {
+      internal::information_item const * _item {};
+      internal::information_item const * _end {};
+
+    public:
+
+      constexpr
+      iterator () = default;
+
+      constexpr
+      iterator (internal::information_item const * item, internal::information_item const * end) : _item { item }, _end { end } { }
+
+      auto operator* () const -> modules_information const & ;
+
+      auto operator-> () const -> modules_information const * ;
+
+      auto operator++ () -> iterator & ;
+
+      auto operator== (iterator const & other) const -> bool { return _item == other._item; }
+    };
+
+    constexpr
+    module_range () = default;
+
+    constexpr
+    module_range (internal::information_item const * first, internal::information_item const * end) : _first { first }, _end { end } { }
+
+    auto begin () const -> iterator { return { _first, _end }; }
+
+    auto end () const -> iterator { return { _end, _end }; }
+  };
+
+  //! @brief Multiboot2 information index
+  //!
+  //! Records, in one pass, the first item of each information type, and the extent of modules items.
+  //! Scanning stops at the end item, at the list size, or at a malformed item.
+  //! Accessors return null for information types not present.
+
+  class information_index
+  {
+    static constexpr unsigned type_count = 18;
+
+    internal::information_item const * _items [type_count] {};
+    internal::information_item const * _modules_end {};
+    unsigned                           _module_count {};
+
+  public:
+
+    constexpr
+    information_index () = default;
+
+    explicit
+    information_index (information_list const & list);
+
+    //! @brief First item of type; null if none.
+
+    auto find (information_type type) const -> internal::information_item const * ;
+
+    auto command_line () const -> command_line_information const * ;
+
+    auto basic_memory () const -> basic_memory_information const * ;
+
+    auto memory_map () const -> memory_map_information const * ;
+
+    auto efi_memory_map () const -> efi_memory_map_information const * ;
+
+    auto framebuffer () const -> framebuffer_information const * ;
+
+    auto acpi_old () const -> acpi_information const * ;
+
+    auto acpi_new () const -> acpi_information const * ;
+
+    auto modules () const -> module_range ;
+
+    auto module_count () const -> unsigned { return _module_count; }
+  };
+
 }
 
 //! Inline definitions
@@ -287,4 +464,145 @@ namespace multiboot2
     return reinterpret_cast<internal::information_item *>(successor);
   }
 
+  inline
+  auto begin (information_list const & list) -> internal::information_item const *
+  {
+    return begin(const_cast<information_list &>(list));
+  }
+
+  inline
+  auto end (information_list const & list) -> internal::information_item const *
+  {
+    return end(const_cast<information_list &>(list));
+  }
+
+  inline
+  auto next (internal::information_item const * item) -> internal::information_item const *
+  {
+    return next(const_cast<internal::information_item *>(item));
+  }
+
+  inline
+  auto entry_count (memory_map_information const & map) -> unsigned
+  {
+    if (map.entry_size < sizeof(memory_map_entry) || map.size < sizeof(memory_map_information)) return 0;
+    return (map.size - sizeof(memory_map_information)) / map.entry_size;
+  }
+
+  inline
+  auto entry_at (memory_map_information const & map, unsigned index) -> memory_map_entry const &
+  {
+    auto const first = reinterpret_cast<char const *>(& map + 1);
+    return * reinterpret_cast<memory_map_entry const *>(first + index * map.entry_size);
+  }
+
+  inline
+  auto descriptor_count (efi_memory_map_information const & map) -> unsigned
+  {
+    if (map.descriptor_size < sizeof(efi_memory_descriptor) || map.size < sizeof(efi_memory_map_information)) return 0;
+    return (map.size - sizeof(efi_memory_map_information)) / map.descriptor_size;
+  }
+
+  inline
+  auto descriptor_at (efi_memory_map_information const & map, unsigned index) -> efi_memory_descriptor const &
+  {
+    auto const first = reinterpret_cast<char const *>(& map + 1);
+    return * reinterpret_cast<efi_memory_descriptor const *>(first + index * map.descriptor_size);
+  }
+
+  inline
+  auto module_range::iterator::operator* () const -> modules_information const &
+  {
+    return * reinterpret_cast<modules_information const *>(_item);
+  }
+
+  inline
+  auto module_range::iterator::operator-> () const -> modules_information const *
+  {
+    return reinterpret_cast<modules_information const *>(_item);
+  }
+
+  inline
+  auto module_range::iterator::operator++ () -> iterator &
+  {
+    do {
+      _item = next(_item);
+    } while (_item != _end && _item->type != information_type::modules);
+    return *this;
+  }
+
+  inline
+  information_index::information_index (information_list const & list)
+  {
+    auto const last = reinterpret_cast<char const *>(end(list));
+    for (auto i = begin(list); reinterpret_cast<char const *>(i) + sizeof(internal::information_item) <= last; i = next(i))
+    {
+      if (i->type == information_type::end || i->size < sizeof(internal::information_item)) break;
+      if (reinterpret_cast<char const *>(i) + i->size > last) break;
+
+      auto const type = static_cast<unsigned>(i->type);
+      if (type < type_count && _items[type] == nullptr) _items[type] = i;
+
+      if (i->type == information_type::modules) {
+        _modules_end = next(i);
+        ++_module_count;
+      }
+    }
+  }
+
+  inline
+  auto information_index::find (information_type type) const -> internal::information_item const *
+  {
+    auto const index = static_cast<unsigned>(type);
+    return index < type_count ? _items[index] : nullptr;
+  }
+
+  inline
+  auto information_index::command_line () const -> command_line_information const *
+  {
+    return reinterpret_cast<command_line_information const *>(find(information_type::command_line));
+  }
+
+  inline
+  auto information_index::basic_memory () const -> basic_memory_information const *
+  {
+    return reinterpret_cast<basic_memory_information const *>(find(information_type::basic_memory));
+  }
+
+  inline
+  auto information_index::memory_map () const -> memory_map_information const *
+  {
+    return reinterpret_cast<memory_map_information const *>(find(information_type::memory_map));
+  }
+
+  inline
+  auto information_index::efi_memory_map () const -> efi_memory_map_information const *
+  {
+    return reinterpret_cast<efi_memory_map_information const *>(find(information_type::efi_memory_map));
+  }
+
+  inline
+  auto information_index::framebuffer () const -> framebuffer_information const *
+  {
+    return reinterpret_cast<framebuffer_information const *>(find(information_type::framebuffer));
+  }
+
+  inline
+  auto information_index::acpi_old () const -> acpi_information const *
+  {
+    return reinterpret_cast<acpi_information const *>(find(information_type::acpi_old));
+  }
+
+  inline
+  auto information_index::acpi_new () const -> acpi_information const *
+  {
+    return reinterpret_cast<acpi_information const *>(find(information_type::acpi_new));
+  }
+
+  inline
+  auto information_index::modules () const -> module_range
+  {
+    return { find(information_type::modules), _modules_end };
+  }
+
 }
@@ -0,0 +1,228 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <multiboot2/information.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace multiboot2
+{
+  //! @brief Physical memory range, from begin up to but excluding end
+
+  struct memory_range
+  {
+    ps::size8 begin;
+    ps::size8 end;
+  };
+
+  //! @brief Memory map normalizer
+  //!
+  //! Collects available and reserved ranges from multiboot2 and EFI memory maps and from callers,
+  //! then sorts and merges each set, removes reserved ranges from available ones,
+  //! and shrinks what remains to page boundaries.
+  //! Where maps disagree, reserved wins.
+
+  template <unsigned Capacity = 128>
+  class memory_map_normalizer
+  {
+    memory_range _available [Capacity] {};
+    unsigned     _available_count {};
+    memory_range _reserved [Capacity] {};
+    unsigned     _reserved_count {};
+    memory_range _ranges [Capacity] {};
+    unsigned     _count {};
+
+  public:
+
+    //! @brief Add available range; false if full.
+
+    auto add_available (ps::size8 begin, ps::size8 end) -> bool ;
+
+    //! @brief Add reserved range; false if full.
+
+    auto add_reserved (ps::size8 begin, ps::size8 end) -> bool ;
+
+    //! @brief Add multiboot2 memory map entries; false if full.
+
+    auto add (memory_map_information const & map) -> bool ;
+
+    //! @brief Add EFI memory map descriptors; false if full.
+    //!
+    //! Boot services and loader memory count as available.
+
+    auto add (efi_memory_map_information const & map) -> bool ;
+
+    //! @brief Add memory maps, and reserve modules and the information list itself; false if full.
+
+    auto add (information_list const & list, information_index const & index) -> bool ;
+
+    //! @brief Compute available ranges aligned to page size, a power of two; false if full.
+
+    auto normalize (ps::size8 page_size = 0x1000) -> bool ;
+
+    //! @brief Normalized ranges, sorted and disjoint.
+
+    auto size () const -> unsigned { return _count; }
+
+    auto operator[] (unsigned index) const -> memory_range const & { return _ranges[index]; }
+
+    auto begin () const -> memory_range const * { return _ranges; }
+
+    auto end () const -> memory_range const * { return _ranges + _count; }
+
+    //! @brief Normalized bytes.
+
+    auto total () const -> ps::size8 ;
+  };
+}
+
+//! Inline definitions
+
+namespace multiboot2
+{
+  namespace internal
+  {
+    inline
+    auto add_range (memory_range * ranges, unsigned & count, unsigned capacity, ps::size8 begin, ps::size8 end) -> bool
+    {
+      if (begin >= end) return true;
+      if (count == capacity) return false;
+      ranges[count++] = { begin, end };
+      return true;
+    }
+
+    //! Sort by begin, then merge overlapping and adjacent ranges; returns new count.
+
+    inline
+    auto merge_ranges (memory_range * ranges, unsigned count) -> unsigned
+    {
+      for (unsigned i = 1; i < count; ++i) {
+        auto const range = ranges[i];
+        auto j = i;
+        for (; j != 0 && ranges[j - 1].begin > range.begin; --j)
+          ranges[j] = ranges[j - 1];
+        ranges[j] = range;
+      }
+
+      unsigned merged = 0;
+      for (unsigned i = 0; i != count; ++i) {
+        if (merged != 0 && ranges[i].begin <= ranges[merged - 1].end) {
+          if (ranges[i].end > ranges[merged - 1].end) ranges[merged - 1].end = ranges[i].end;
+        }
+        else {
+          ranges[merged++] = ranges[i];
+        }
+      }
+      return merged;
+    }
+  }
+
+  template <unsigned Capacity>
+  auto memory_map_normalizer<Capacity>::add_available (ps::size8 begin, ps::size8 end) -> bool
+  {
+    return internal::add_range(_available, _available_count, Capacity, begin, end);
+  }
+
+  template <unsigned Capacity>
+  auto memory_map_normalizer<Capacity>::add_reserved (ps::size8 begin, ps::size8 end) -> bool
+  {
+    return internal::add_range(_reserved, _reserved_count, Capacity, begin, end);
+  }
+
+  template <unsigned Capacity>
+  auto memory_map_normalizer<Capacity>::add (memory_map_information const & map) -> bool
+  {
+    for (unsigned i = 0, j = entry_count(map); i != j; ++i)
+    {
+      auto const & entry = entry_at(map, i);
+      auto const end = entry.base + entry.length < entry.base ? ~ps::size8(0) : entry.base + entry.length;
+      auto const added = entry.type == memory_type::available ? add_available(entry.base, end) : add_reserved(entry.base, end);
+      if (! added) return false;
+    }
+    return true;
+  }
+
+  template <unsigned Capacity>
+  auto memory_map_normalizer<Capacity>::add (efi_memory_map_information const & map) -> bool
+  {
+    for (unsigned i = 0, j = descriptor_count(map); i != j; ++i)
+    {
+      auto const & descriptor = descriptor_at(map, i);
+      auto const begin = descriptor.physical_start;
+      auto const length = descriptor.page_count > (~ps::size8(0) >> 12) ? ~ps::size8(0) : descriptor.page_count << 12;
+      auto const end = begin + length < begin ? ~ps::size8(0) : begin + length;
+      bool added;
+      switch (descriptor.type)
+      {
+      case efi_memory_type::loader_code:
+      case efi_memory_type::loader_data:
+      case efi_memory_type::boot_services_code:
+      case efi_memory_type::boot_services_data:
+      case efi_memory_type::conventional:
+        added = add_available(begin, end);
+        break;
+      default:
+        added = add_reserved(begin, end);
+        break;
+      }
+      if (! added) return false;
+    }
+    return true;
+  }
+
+  template <unsigned Capacity>
+  auto memory_map_normalizer<Capacity>::add (information_list const & list, information_index const & index) -> bool
+  {
+    if (auto const map = index.memory_map(); map != nullptr && ! add(*map)) return false;
+    if (auto const map = index.efi_memory_map(); map != nullptr && ! add(*map)) return false;
+
+    for (auto const & module : index.modules())
+      if (! add_reserved(module.start, module.end)) return false;
+
+    auto const address = reinterpret_cast<ps::size>(& list);
+    return add_reserved(address, ps::size8(address) + list.size);
+  }
+
+  template <unsigned Capacity>
+  auto memory_map_normalizer<Capacity>::normalize (ps::size8 page_size) -> bool
+  {
+    _available_count = internal::merge_ranges(_available, _available_count);
+    _reserved_count = internal::merge_ranges(_reserved, _reserved_count);
+    _count = 0;
+
+    auto const mask = page_size - 1;
+    auto const emit = [&] (ps::size8 begin, ps::size8 end) -> bool
+    {
+      if (begin > ~mask) return true;
+      return internal::add_range(_ranges, _count, Capacity, (begin + mask) & ~mask, end & ~mask);
+    };
+
+    // Both sets are sorted and disjoint: walk reserved ranges once.
+    unsigned j = 0;
+    for (unsigned i = 0; i != _available_count; ++i)
+    {
+      auto const & available = _available[i];
+      while (j != _reserved_count && _reserved[j].end <= available.begin) ++j;
+
+      auto cursor = available.begin;
+      for (auto k = j; k != _reserved_count && _reserved[k].begin < available.end; ++k)
+      {
+        if (_reserved[k].begin > cursor && ! emit(cursor, _reserved[k].begin)) return false;
+        if (_reserved[k].end > cursor) cursor = _reserved[k].end;
+      }
+      if (cursor < available.end && ! emit(cursor, available.end)) return false;
+    }
+    return true;
+  }
+
+  template <unsigned Capacity>
+  auto memory_map_normalizer<Capacity>::total () const -> ps::size8
+  {
+    ps::size8 bytes = 0;
+    for (unsigned i = 0; i != _count; ++i) bytes += _ranges[i].end - _ranges[i].begin;
+    return bytes;
+  }
+}
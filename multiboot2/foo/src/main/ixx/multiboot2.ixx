@@ -4,6 +4,7 @@ module;
 
 #include <multiboot2/header.h>
 #include <multiboot2/information.h>
+#include <multiboot2/memory_map.h>
 
 export module br.dev.pedrolamarao.metal.multiboot2;
 
@@ -39,13 +40,28 @@ export namespace multiboot2
     using ::multiboot2::basic_memory_information;
     using ::multiboot2::boot_device_information;
     using ::multiboot2::memory_map_information;
+    using ::multiboot2::memory_type;
+    using ::multiboot2::memory_map_entry;
+    using ::multiboot2::entry_count;
+    using ::multiboot2::entry_at;
     using ::multiboot2::elf_symbols_information;
     using ::multiboot2::apm_information;
     using ::multiboot2::vbe_information;
     using ::multiboot2::framebuffer_information;
     using ::multiboot2::efi32_information;
     using ::multiboot2::efi64_information;
+    using ::multiboot2::efi_memory_map_information;
+    using ::multiboot2::efi_memory_type;
+    using ::multiboot2::efi_memory_descriptor;
+    using ::multiboot2::descriptor_count;
+    using ::multiboot2::descriptor_at;
     using ::multiboot2::smbios_information;
     using ::multiboot2::acpi_information;
     using ::multiboot2::network_information;
+    using ::multiboot2::module_range;
+    using ::multiboot2::information_index;
+
+    // memory map
+    using ::multiboot2::memory_range;
+    using ::multiboot2::memory_map_normalizer;
 }
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.multiboot2;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    using namespace multiboot2;
+
+    // Information list builder: items are padded to 8 bytes.
+
+    struct list_builder
+    {
+        alignas(8) ps::size1 memory [512] {};
+        unsigned size { 8 };
+
+        auto add (information_type type, unsigned length) -> ps::size1 *
+        {
+            auto const item = memory + size;
+            reinterpret_cast<ps::size4 *>(item)[0] = ps::size4(type);
+            reinterpret_cast<ps::size4 *>(item)[1] = length;
+            size += (length + 7) & ~7u;
+            reinterpret_cast<information_list *>(memory)->size = size;
+            return item;
+        }
+
+        auto add_module (ps::size4 start, ps::size4 end) -> void
+        {
+            auto const item = reinterpret_cast<modules_information *>(add(information_type::modules, sizeof(modules_information) + 1));
+            item->start = start;
+            item->end = end;
+        }
+
+        auto list () -> information_list const & { return * reinterpret_cast<information_list const *>(memory); }
+    };
+
+    TEST(information_index, empty)
+    {
+        list_builder builder;
+        builder.add(information_type::end, 8);
+
+        information_index const index { builder.list() };
+        ASSERT_EQ(index.memory_map(), nullptr);
+        ASSERT_EQ(index.framebuffer(), nullptr);
+        ASSERT_EQ(index.acpi_new(), nullptr);
+        ASSERT_EQ(index.module_count(), 0);
+        ASSERT_EQ(index.modules().begin(), index.modules().end());
+    }
+
+    TEST(information_index, find)
+    {
+        list_builder builder;
+        auto const command_line = builder.add(information_type::command_line, 8 + 5);
+        builder.add_module(0x100000, 0x101000);
+        auto const memory_map = builder.add(information_type::memory_map, 16 + 24 * 2);
+        builder.add_module(0x101000, 0x102000);
+        auto const acpi = builder.add(information_type::acpi_new, 8 + 36);
+        builder.add_module(0x102000, 0x103000);
+        builder.add(information_type::end, 8);
+        // Past the end item: ignored.
+        builder.add(information_type::framebuffer, sizeof(framebuffer_information));
+
+        information_index const index { builder.list() };
+        ASSERT_EQ(reinterpret_cast<ps::size1 const *>(index.command_line()), command_line);
+        ASSERT_EQ(reinterpret_cast<ps::size1 const *>(index.memory_map()), memory_map);
+        ASSERT_EQ(reinterpret_cast<ps::size1 const *>(index.acpi_new()), acpi);
+        ASSERT_EQ(index.acpi_old(), nullptr);
+        ASSERT_EQ(index.framebuffer(), nullptr);
+
+        ASSERT_EQ(index.module_count(), 3);
+        ps::size4 expected = 0x100000;
+        unsigned count = 0;
+        for (auto const & module : index.modules()) {
+            ASSERT_EQ(module.start, expected);
+            ASSERT_EQ(module.end, expected + 0x1000);
+            expected += 0x1000;
+            ++count;
+        }
+        ASSERT_EQ(count, 3);
+    }
+
+    TEST(information_index, malformed)
+    {
+        list_builder builder;
+        builder.add_module(0x100000, 0x101000);
+        auto const item = builder.add(information_type::memory_map, 16);
+        // Item size too small to hold its own header: scanning stops.
+        reinterpret_cast<ps::size4 *>(item)[1] = 4;
+        builder.add(information_type::framebuffer, sizeof(framebuffer_information));
+
+        information_index const index { builder.list() };
+        ASSERT_EQ(index.module_count(), 1);
+        ASSERT_EQ(index.memory_map(), nullptr);
+        ASSERT_EQ(index.framebuffer(), nullptr);
+    }
+}
@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.multiboot2;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    using namespace multiboot2;
+
+    TEST(memory_map, merge)
+    {
+        memory_map_normalizer<8> normalizer;
+
+        // Out of order, overlapping and adjacent.
+        ASSERT_TRUE(normalizer.add_available(0x200000, 0x400000));
+        ASSERT_TRUE(normalizer.add_available(0x100000, 0x200000));
+        ASSERT_TRUE(normalizer.add_available(0x300000, 0x500000));
+        ASSERT_TRUE(normalizer.add_available(0x1000, 0x9F000));
+        ASSERT_TRUE(normalizer.add_available(0x1000, 0x1000));
+        ASSERT_TRUE(normalizer.normalize());
+
+        ASSERT_EQ(normalizer.size(), 2);
+        ASSERT_EQ(normalizer[0].begin, 0x1000);
+        ASSERT_EQ(normalizer[0].end, 0x9F000);
+        ASSERT_EQ(normalizer[1].begin, 0x100000);
+        ASSERT_EQ(normalizer[1].end, 0x500000);
+        ASSERT_EQ(normalizer.total(), 0x9E000 + 0x400000);
+    }
+
+    TEST(memory_map, clip)
+    {
+        memory_map_normalizer<8> normalizer;
+
+        ASSERT_TRUE(normalizer.add_available(0x100000, 0x8000000));
+        // Reserved at the start, inside, across the end, and outside.
+        ASSERT_TRUE(normalizer.add_reserved(0x100000, 0x180000));
+        ASSERT_TRUE(normalizer.add_reserved(0x400800, 0x401000));
+        ASSERT_TRUE(normalizer.add_reserved(0x400000, 0x400100));
+        ASSERT_TRUE(normalizer.add_reserved(0x7FFF000, 0x9000000));
+        ASSERT_TRUE(normalizer.add_reserved(0xFEC00000, 0xFEC01000));
+        ASSERT_TRUE(normalizer.normalize());
+
+        // Partial pages around reserved ranges are dropped.
+        ASSERT_EQ(normalizer.size(), 2);
+        ASSERT_EQ(normalizer[0].begin, 0x180000);
+        ASSERT_EQ(normalizer[0].end, 0x400000);
+        ASSERT_EQ(normalizer[1].begin, 0x401000);
+        ASSERT_EQ(normalizer[1].end, 0x7FFF000);
+
+        // Large pages.
+        ASSERT_TRUE(normalizer.normalize(0x200000));
+        ASSERT_EQ(normalizer.size(), 2);
+        ASSERT_EQ(normalizer[0].begin, 0x200000);
+        ASSERT_EQ(normalizer[0].end, 0x400000);
+        ASSERT_EQ(normalizer[1].begin, 0x600000);
+        ASSERT_EQ(normalizer[1].end, 0x7E00000);
+    }
+
+    TEST(memory_map, full)
+    {
+        memory_map_normalizer<2> normalizer;
+        ASSERT_TRUE(normalizer.add_available(0, 0x10000));
+        ASSERT_TRUE(normalizer.add_reserved(0x2000, 0x3000));
+        ASSERT_TRUE(normalizer.add_reserved(0x5000, 0x6000));
+        ASSERT_FALSE(normalizer.add_reserved(0x8000, 0x9000));
+        // Three ranges do not fit.
+        ASSERT_FALSE(normalizer.normalize());
+    }
+
+    TEST(memory_map, information)
+    {
+        // Multiboot2 and EFI memory maps disagree: reserved wins.
+
+        alignas(8) ps::size1 memory [256] {};
+        unsigned size = 8;
+
+        auto const map = reinterpret_cast<memory_map_information *>(memory + size);
+        * map = { information_type::memory_map, 16 + 24 * 3, 24, 0 };
+        auto const entries = reinterpret_cast<memory_map_entry *>(map + 1);
+        entries[0] = { 0x0, 0x9F000, memory_type::available, 0 };
+        entries[1] = { 0xF0000, 0x10000, memory_type::reserved, 0 };
+        entries[2] = { 0x100000, 0x7F00000, memory_type::available, 0 };
+        size += 16 + 24 * 3;
+
+        auto const efi = reinterpret_cast<efi_memory_map_information *>(memory + size);
+        * efi = { information_type::efi_memory_map, 16 + 48 * 2, 48, 1 };
+        auto const descriptors = memory + size + 16;
+        * reinterpret_cast<efi_memory_descriptor *>(descriptors) = { efi_memory_type::boot_services_data, 0, 0x8000000, 0, 0x1000, 0 };
+        * reinterpret_cast<efi_memory_descriptor *>(descriptors + 48) = { efi_memory_type::acpi_reclaimable, 0, 0x7FF0000, 0, 0x10, 0 };
+        size += 16 + 48 * 2;
+
+        auto const module = reinterpret_cast<modules_information *>(memory + size);
+        * module = { information_type::modules, 17, 0x200000, 0x280000 };
+        size += 24;
+
+        * reinterpret_cast<end_information *>(memory + size) = { information_type::end, 8 };
+        size += 8;
+        reinterpret_cast<information_list *>(memory)->size = size;
+
+        auto const & list = * reinterpret_cast<information_list const *>(memory);
+        information_index const index { list };
+        ASSERT_EQ(entry_count(* index.memory_map()), 3);
+        ASSERT_EQ(entry_at(* index.memory_map(), 2).base, 0x100000);
+        ASSERT_EQ(descriptor_count(* index.efi_memory_map()), 2);
+        ASSERT_EQ(descriptor_at(* index.efi_memory_map(), 1).type, efi_memory_type::acpi_reclaimable);
+
+        memory_map_normalizer<> normalizer;
+        ASSERT_TRUE(normalizer.add(list, index));
+        ASSERT_TRUE(normalizer.normalize());
+
+        // The information list lives in this test's stack, somewhere in the host address space.
+        ps::size8 const begins [] { 0x0, 0x100000, 0x280000, 0x8000000 };
+        ps::size8 const ends [] { 0x9F000, 0x200000, 0x7FF0000, 0x9000000 };
+        ASSERT_EQ(normalizer.size(), 4);
+        for (unsigned i = 0; i != 4; ++i) {
+            ASSERT_EQ(normalizer[i].begin, begins[i]);
+            ASSERT_EQ(normalizer[i].end, ends[i]);
+        }
+    }
+}
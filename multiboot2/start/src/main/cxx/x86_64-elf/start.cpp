@@ -190,6 +190,14 @@ namespace multiboot2
             or eax, 0x20
             mov cr4, eax
         }
+        // Enable SSE instructions: operating system supports FXSAVE and SIMD exceptions.
+        __asm__
+        {
+            .code32
+            mov eax, cr4
+            or eax, 0x600
+            mov cr4, eax
+        }
         // Enable long mode.
         __asm__
         {
@@ -49,6 +49,15 @@ namespace multiboot2
             return;
         }
 
+        // Index information: expect the same module.
+
+        _test_control = step++;
+        information_index const index { response };
+        if (index.module_count() != 1 || & * index.modules().begin() != module) {
+            _test_control = 0;
+            return;
+        }
+
         // Validate module: ELF32, x86_32 machine, segments, entry.
 
         _test_control = step++;
@@ -8,7 +8,9 @@ plugins {
 group = "br.dev.pedrolamarao.metal.pc"
 
 dependencies {
+    api(project(":acpi"))
     api(project(":psys"))
+    api(project(":x86"))
     testImplementation(project(":googletest"))
 }
 
@@ -0,0 +1,227 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace pc
+{
+    //! @brief HPET comparator registers
+
+    struct hpet_timer_memory_map
+    {
+        ps::size8 volatile configuration;
+        ps::size8 volatile comparator;
+        ps::size8 volatile fsb_route;
+        ps::size8          reserved;
+    };
+
+    //! @brief HPET memory map
+
+    struct hpet_memory_map
+    {
+        ps::size8 volatile    capabilities;
+        ps::size8             reserved0;
+        ps::size8 volatile    configuration;
+        ps::size8             reserved1;
+        ps::size8 volatile    status;
+        ps::size8             reserved2 [25];
+        ps::size8 volatile    counter;
+        ps::size8             reserved3;
+        hpet_timer_memory_map timers [32];
+    };
+
+    //! @brief High Precision Event Timer
+    //!
+    //! The main counter is a clock source; comparators raise one-shot or periodic interrupts,
+    //! routed to an I/O APIC input or, where capable, delivered as a message (FSB).
+
+    class hpet
+    {
+        hpet_memory_map * _registers {};
+        ps::size4         _period {};
+
+        static constexpr ps::size8 enable_bit = 1 << 0;
+        static constexpr ps::size8 legacy_bit = 1 << 1;
+
+        static constexpr ps::size8 level_bit         = 1 << 1;
+        static constexpr ps::size8 interrupt_bit     = 1 << 2;
+        static constexpr ps::size8 periodic_bit      = 1 << 3;
+        static constexpr ps::size8 periodic_cap_bit  = 1 << 4;
+        static constexpr ps::size8 value_set_bit     = 1 << 6;
+        static constexpr ps::size8 route_mask        = 0x1F << 9;
+        static constexpr ps::size8 fsb_bit           = 1 << 14;
+        static constexpr ps::size8 fsb_cap_bit       = 1 << 15;
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        hpet () = default;
+
+        //! @brief Timer block at virtual address
+
+        explicit
+        hpet (ps::size address) :
+            _registers { reinterpret_cast<hpet_memory_map *>(address) },
+            _period { ps::size4(_registers->capabilities >> 32) }
+        { }
+
+        //! @brief Timer block described by ACPI, at physical address plus mapping offset
+
+        explicit
+        hpet (acpi::hpet_description const & description, ps::size mapping = 0) :
+            hpet { ps::size(description.address.address) + mapping }
+        { }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        //! @brief Counter period in femtoseconds
+
+        auto period () const -> ps::size4 { return _period; }
+
+        //! @brief Counter frequency in Hz
+
+        auto frequency () const -> ps::size8 { return _period == 0 ? 0 : 1000000000000000ULL / _period; }
+
+        //! @brief Number of comparators
+
+        auto count () const -> unsigned { return ((_registers->capabilities >> 8) & 0x1F) + 1; }
+
+        auto is_64bit () const -> bool { return (_registers->capabilities & (1 << 13)) != 0; }
+
+        auto is_legacy_capable () const -> bool { return (_registers->capabilities & (1 << 15)) != 0; }
+
+        auto is_enabled () const -> bool { return (_registers->configuration & enable_bit) != 0; }
+
+        //! @brief I/O APIC inputs comparator may be routed to, bit n for input n
+
+        auto routes (unsigned timer) const -> ps::size4 { return _registers->timers[timer].configuration >> 32; }
+
+        auto is_periodic_capable (unsigned timer) const -> bool { return (_registers->timers[timer].configuration & periodic_cap_bit) != 0; }
+
+        auto is_fsb_capable (unsigned timer) const -> bool { return (_registers->timers[timer].configuration & fsb_cap_bit) != 0; }
+
+        //! @}
+
+        //! @brief Main counter
+        //! @{
+
+        void enable () { _registers->configuration = _registers->configuration | enable_bit; }
+
+        void disable () { _registers->configuration = _registers->configuration & ~enable_bit; }
+
+        //! @brief Route comparators 0 and 1 to IRQ 0 and IRQ 8, replacing PIT and RTC
+
+        void legacy (bool value)
+        {
+            auto const configuration = _registers->configuration;
+            _registers->configuration = value ? (configuration | legacy_bit) : (configuration & ~legacy_bit);
+        }
+
+        //! @brief Main counter value
+
+        auto counter () const -> ps::size8
+        {
+#if defined(__x86_64__)
+            return _registers->counter;
+#else
+            // Two 32-bit reads: retry if the high half changed in between.
+            auto const halves = reinterpret_cast<ps::size4 volatile const *>(& _registers->counter);
+            while (true) {
+                auto const high = halves[1];
+                auto const low = halves[0];
+                if (halves[1] == high) return (ps::size8{high} << 32) | low;
+            }
+#endif
+        }
+
+        //! @brief Set main counter; counter must be disabled
+
+        void counter (ps::size8 value) { _registers->counter = value; }
+
+        //! @brief Convert ticks to nanoseconds
+
+        auto nanoseconds (ps::size8 ticks) const -> ps::size8
+        {
+            // Split to avoid overflow of ticks times period.
+            constexpr ps::size8 scale = 1000000;
+            return (ticks / scale) * _period + ((ticks % scale) * _period) / scale;
+        }
+
+        //! @brief Convert nanoseconds to ticks
+
+        auto ticks (ps::size8 nanoseconds) const -> ps::size8
+        {
+            constexpr ps::size8 scale = 1000000;
+            return _period == 0 ? 0 : (nanoseconds / _period) * scale + ((nanoseconds % _period) * scale) / _period;
+        }
+
+        //! @brief Nanoseconds since counter start
+
+        auto now () const -> ps::size8 { return nanoseconds(counter()); }
+
+        //! @}
+
+        //! @brief Comparators
+        //! @{
+
+        //! @brief Interrupt once when counter reaches now plus ticks, edge triggered on I/O APIC input
+
+        void one_shot (unsigned timer, ps::size8 ticks, ps::size1 route)
+        {
+            auto & registers = _registers->timers[timer];
+            auto configuration = registers.configuration & ~(periodic_bit | level_bit | route_mask | fsb_bit);
+            configuration |= (ps::size8(route) << 9) & route_mask;
+            registers.configuration = configuration;
+            registers.comparator = counter() + ticks;
+            registers.configuration = configuration | interrupt_bit;
+        }
+
+        //! @brief Interrupt every ticks, edge triggered on I/O APIC input; returns false if not capable
+
+        auto periodic (unsigned timer, ps::size8 ticks, ps::size1 route) -> bool
+        {
+            if (! is_periodic_capable(timer)) return false;
+            auto & registers = _registers->timers[timer];
+            auto configuration = registers.configuration & ~(level_bit | route_mask | fsb_bit | interrupt_bit);
+            configuration |= ((ps::size8(route) << 9) & route_mask) | periodic_bit;
+            registers.configuration = configuration;
+            // With value set, the first write sets the comparator, the second the accumulator.
+            registers.configuration = configuration | value_set_bit;
+            registers.comparator = counter() + ticks;
+            registers.comparator = ticks;
+            registers.configuration = configuration | interrupt_bit;
+            return true;
+        }
+
+        //! @brief Deliver comparator interrupts as message; returns false if not capable
+
+        auto fsb (unsigned timer, ps::size4 address, ps::size4 data) -> bool
+        {
+            if (! is_fsb_capable(timer)) return false;
+            auto & registers = _registers->timers[timer];
+            registers.fsb_route = (ps::size8{address} << 32) | data;
+            registers.configuration = registers.configuration | fsb_bit;
+            return true;
+        }
+
+        void stop (unsigned timer)
+        {
+            auto & registers = _registers->timers[timer];
+            registers.configuration = registers.configuration & ~interrupt_bit;
+        }
+
+        //! @brief Acknowledge level triggered interrupt
+
+        void acknowledge (unsigned timer) { _registers->status = ps::size8(1) << timer; }
+
+        //! @}
+    };
+}
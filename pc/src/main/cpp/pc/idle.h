@@ -0,0 +1,220 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace pc
+{
+    //! @brief Idle state entry method
+
+    enum class idle_method : ps::size1
+    {
+        poll  = 0,
+        halt  = 1,
+        mwait = 2,
+        io    = 3,
+    };
+
+    //! @brief Idle state
+    //!
+    //! Hint is the MWAIT hint for mwait, the I/O port to read for io.
+    //! Latency and residency are in nanoseconds.
+
+    struct idle_state
+    {
+        idle_method method;
+        ps::size4   hint;
+        ps::size8   exit_latency;
+        ps::size8   target_residency;
+    };
+
+    //! @brief Idle state from ACPI _CST entry; false if entry is not usable
+    //!
+    //! Functional fixed hardware entries select MWAIT with the register address as hint;
+    //! system I/O entries select a read of the register port; other C1 entries select HLT.
+    //! Target residency is estimated as three times the exit latency.
+
+    inline
+    auto idle_state_of (acpi::power_state const & x, idle_state & result) -> bool
+    {
+        auto const latency = ps::size8(x.latency) * 1000;
+        result = { idle_method::halt, 0, latency, latency * 3 };
+        if (x.entry.space == 0x7F) {
+            result.method = idle_method::mwait;
+            result.hint = ps::size4(x.entry.address);
+            return true;
+        }
+        if (x.entry.space == ps::size1(acpi::address_space::system_io) && x.entry.address != 0 && x.entry.address <= 0xFFFF) {
+            result.method = idle_method::io;
+            result.hint = ps::size4(x.entry.address);
+            return true;
+        }
+        return x.type == 1;
+    }
+
+    //! @brief Idle governor for one processor
+    //!
+    //! States are kept ordered by target residency; state zero is polling.
+    //! Selection picks the deepest state whose target residency fits the expected idle duration,
+    //! the lesser of the time to the next known event and the predicted duration,
+    //! and whose exit latency, the greater of declared and measured, fits the latency limit.
+    //! Predicted duration and measured latencies are moving averages updated after every idle period;
+    //! they react faster to shorter idle periods and longer latencies.
+
+    template <unsigned Capacity = 8>
+    class idle_governor
+    {
+        idle_state _states [Capacity] {};
+        ps::size8  _measured [Capacity] {};
+        unsigned   _count { 1 };
+        ps::size8  _predicted { ~ps::size8(0) };
+
+    public:
+
+        static constexpr unsigned capacity = Capacity;
+
+        //! @brief No known event or latency limit
+
+        static constexpr ps::size8 unbounded = ~ps::size8(0);
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        idle_governor () = default;
+
+        //! @}
+
+        //! @brief States
+        //! @{
+
+        //! @brief Add state; false if full
+
+        auto add (idle_state const & state) -> bool
+        {
+            if (_count == Capacity) return false;
+            auto i = _count++;
+            for (; i > 1 && _states[i - 1].target_residency > state.target_residency; --i) {
+                _states[i] = _states[i - 1];
+                _measured[i] = _measured[i - 1];
+            }
+            _states[i] = state;
+            _measured[i] = 0;
+            return true;
+        }
+
+        //! @brief Add usable states from ACPI _CST entries; returns number added
+
+        auto add (acpi::power_state const * states, unsigned count) -> unsigned
+        {
+            unsigned added = 0;
+            for (unsigned i = 0; i != count; ++i) {
+                idle_state state;
+                if (idle_state_of(states[i], state) && add(state)) ++added;
+            }
+            return added;
+        }
+
+        auto size () const -> unsigned { return _count; }
+
+        auto state (unsigned index) const -> idle_state const & { return _states[index]; }
+
+        //! @brief Exit latency of state: greater of declared and measured
+
+        auto exit_latency (unsigned index) const -> ps::size8
+        {
+            auto const declared = _states[index].exit_latency;
+            return _measured[index] > declared ? _measured[index] : declared;
+        }
+
+        //! @brief Predicted idle duration; unbounded before the first update
+
+        auto predicted () const -> ps::size8 { return _predicted; }
+
+        //! @}
+
+        //! @brief Governor
+        //! @{
+
+        //! @brief Select state for idle period with time to next known event and exit latency limit
+
+        auto select (ps::size8 next_event, ps::size8 latency_limit) const -> unsigned
+        {
+            auto const expected = next_event < _predicted ? next_event : _predicted;
+            unsigned selected = 0;
+            for (unsigned i = 1; i != _count; ++i) {
+                if (_states[i].target_residency > expected) break;
+                if (exit_latency(i) > latency_limit) continue;
+                selected = i;
+            }
+            return selected;
+        }
+
+        //! @brief Record idle period in state with measured duration and exit latency, zero if unknown
+
+        void update (unsigned index, ps::size8 idle, ps::size8 latency)
+        {
+            if (_predicted == unbounded) _predicted = idle;
+            else if (idle < _predicted) _predicted = (_predicted + idle) / 2;
+            else _predicted = (_predicted * 7 + idle) / 8;
+
+            if (latency == 0 || index >= _count) return;
+            auto & measured = _measured[index];
+            if (latency > measured) measured = (measured + latency) / 2;
+            else measured = (measured * 7 + latency) / 8;
+        }
+
+        //! @}
+    };
+
+    //! @brief Enter idle state until wake differs from expected, an interrupt arrives, or, when polling, deadline
+    //!
+    //! Call with interrupts disabled; returns with interrupts enabled.
+    //! Clock returns nanoseconds.
+
+    template <typename Clock>
+    void enter_idle (idle_state const & state, unsigned const volatile * wake, unsigned expected, Clock & now, ps::size8 deadline)
+    {
+        switch (state.method)
+        {
+        case idle_method::poll:
+            x86::enable_interrupts();
+            while (*wake == expected && now() < deadline) x86::pause();
+            break;
+        case idle_method::halt:
+            x86::enable_interrupts_and_halt();
+            break;
+        case idle_method::mwait:
+            // Arm the monitor before checking, so a store after the check still wakes us.
+            x86::monitor(const_cast<unsigned const *>(wake));
+            if (*wake == expected) x86::enable_interrupts_and_mwait(state.hint);
+            else x86::enable_interrupts();
+            break;
+        case idle_method::io:
+            if (*wake == expected) x86::in1(ps::size2(state.hint));
+            x86::enable_interrupts();
+            break;
+        }
+    }
+
+    //! @brief Idle once: select, enter and update; returns state index
+    //!
+    //! Deadline is the time of the next known event, in clock nanoseconds, or unbounded.
+    //! Waking at or after deadline measures exit latency as the overshoot.
+
+    template <unsigned Capacity, typename Clock>
+    auto idle (idle_governor<Capacity> & governor, Clock & now, ps::size8 deadline, ps::size8 latency_limit, unsigned const volatile * wake, unsigned expected) -> unsigned
+    {
+        auto const start = now();
+        auto const next = deadline > start ? deadline - start : 0;
+        auto const index = governor.select(next, latency_limit);
+        enter_idle(governor.state(index), wake, expected, now, deadline);
+        auto const end = now();
+        auto const latency = index != 0 && deadline != governor.unbounded && end >= deadline ? end - deadline : 0;
+        governor.update(index, end - start, latency);
+        return index;
+    }
+}
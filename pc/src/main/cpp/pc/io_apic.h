@@ -0,0 +1,347 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace pc
+{
+    //! @brief I/O APIC interrupt input polarity
+
+    enum class io_apic_polarity : ps::size1
+    {
+        high = 0,
+        low  = 1,
+    };
+
+    //! @brief I/O APIC interrupt input trigger mode
+
+    enum class io_apic_trigger : ps::size1
+    {
+        edge  = 0,
+        level = 1,
+    };
+
+    //! @brief I/O APIC interrupt delivery mode
+
+    enum class io_apic_delivery : ps::size1
+    {
+        fixed           = 0,
+        lowest_priority = 1,
+        smi             = 2,
+        nmi             = 4,
+        init            = 5,
+        external        = 7,
+    };
+
+    //! @brief I/O APIC redirection table entry
+
+    class io_apic_redirection
+    {
+        ps::size8 _value { 1 << 16 };
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        io_apic_redirection () = default;
+
+        constexpr explicit
+        io_apic_redirection (ps::size8 value) : _value { value } { }
+
+        constexpr
+        io_apic_redirection (
+            ps::size1 vector,
+            io_apic_delivery delivery,
+            bool logical,
+            io_apic_polarity polarity,
+            io_apic_trigger trigger,
+            bool masked,
+            ps::size1 destination
+        ) :
+            _value {
+                ps::size8{vector}
+                | (ps::size8(delivery) & 7) << 8
+                | ps::size8{logical} << 11
+                | (ps::size8(polarity) & 1) << 13
+                | (ps::size8(trigger) & 1) << 15
+                | ps::size8{masked} << 16
+                | ps::size8{destination} << 56
+            }
+        { }
+
+        constexpr explicit
+        operator ps::size8 () const { return _value; }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        constexpr
+        auto vector () const -> ps::size1 { return _value & 0xFF; }
+
+        constexpr
+        auto delivery () const -> io_apic_delivery { return io_apic_delivery((_value >> 8) & 7); }
+
+        constexpr
+        auto logical () const -> bool { return (_value & (1 << 11)) != 0; }
+
+        constexpr
+        auto pending () const -> bool { return (_value & (1 << 12)) != 0; }
+
+        constexpr
+        auto polarity () const -> io_apic_polarity { return io_apic_polarity((_value >> 13) & 1); }
+
+        constexpr
+        auto remote_irr () const -> bool { return (_value & (1 << 14)) != 0; }
+
+        constexpr
+        auto trigger () const -> io_apic_trigger { return io_apic_trigger((_value >> 15) & 1); }
+
+        constexpr
+        auto masked () const -> bool { return (_value & (1 << 16)) != 0; }
+
+        constexpr
+        auto destination () const -> ps::size1 { return (_value >> 56) & 0xFF; }
+
+        //! @}
+    };
+
+    //! @brief I/O APIC memory map
+
+    struct io_apic_memory_map
+    {
+        ps::size4 volatile select;
+        ps::size4          reserved [3];
+        ps::size4 volatile window;
+    };
+
+    //! @brief I/O APIC controller
+    //!
+    //! Serves global system interrupts (GSI) [base, base + count).
+
+    template <typename Registers = io_apic_memory_map>
+    class io_apic
+    {
+        Registers * _registers {};
+        ps::size4            _base {};
+        ps::size4            _count {};
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        io_apic () = default;
+
+        io_apic (ps::size address, ps::size4 base) :
+            _registers { reinterpret_cast<Registers *>(address) },
+            _base { base },
+            _count { ((read(1) >> 16) & 0xFF) + 1 }
+        { }
+
+        //! @}
+
+        //! @brief Registers
+        //! @{
+
+        auto read (ps::size1 index) -> ps::size4
+        {
+            _registers->select = index;
+            return _registers->window;
+        }
+
+        void write (ps::size1 index, ps::size4 value)
+        {
+            _registers->select = index;
+            _registers->window = value;
+        }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto id () -> ps::size1 { return (read(0) >> 24) & 0x0F; }
+
+        auto version () -> ps::size1 { return read(1) & 0xFF; }
+
+        auto base () const -> ps::size4 { return _base; }
+
+        auto count () const -> ps::size4 { return _count; }
+
+        auto handles (ps::size4 gsi) const -> bool { return gsi >= _base && gsi < _base + _count; }
+
+        //! @}
+
+        //! @brief Redirection table
+        //! @{
+
+        auto redirection (ps::size4 gsi) -> io_apic_redirection
+        {
+            auto const index = 0x10 + 2 * (gsi - _base);
+            auto const low = read(index);
+            auto const high = read(index + 1);
+            return io_apic_redirection { (ps::size8{high} << 32) | low };
+        }
+
+        //! @brief Set redirection entry, keeping the input masked while the entry is inconsistent.
+
+        void redirection (ps::size4 gsi, io_apic_redirection entry)
+        {
+            auto const index = 0x10 + 2 * (gsi - _base);
+            auto const value = ps::size8(entry);
+            write(index, (value & 0xFFFFFFFF) | (1 << 16));
+            write(index + 1, value >> 32);
+            write(index, value & 0xFFFFFFFF);
+        }
+
+        void mask (ps::size4 gsi)
+        {
+            auto const index = 0x10 + 2 * (gsi - _base);
+            write(index, read(index) | (1 << 16));
+        }
+
+        void unmask (ps::size4 gsi)
+        {
+            auto const index = 0x10 + 2 * (gsi - _base);
+            write(index, read(index) & ~ps::size4(1 << 16));
+        }
+
+        //! @}
+    };
+
+    //! @brief ISA interrupt source mapping
+
+    struct isa_interrupt
+    {
+        ps::size4        gsi;
+        io_apic_polarity polarity;
+        io_apic_trigger  trigger;
+    };
+
+    //! @brief I/O APIC interrupt router
+    //!
+    //! Discovers I/O APICs and ISA interrupt source overrides from the MADT.
+    //! I/O APIC registers are accessed at physical address plus mapping offset.
+
+    template <typename Registers = io_apic_memory_map>
+    class io_apic_router
+    {
+    public:
+
+        static constexpr unsigned capacity = 8;
+
+    private:
+
+        io_apic<Registers> _io_apics [capacity] {};
+        unsigned           _count {};
+        unsigned           _found {};
+        isa_interrupt      _isa [16] {};
+
+        auto find (ps::size4 gsi) -> io_apic<Registers> *
+        {
+            for (unsigned i = 0; i != _count; ++i)
+                if (_io_apics[i].handles(gsi)) return & _io_apics[i];
+            return nullptr;
+        }
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        explicit
+        io_apic_router (acpi::apic_system_description const & madt, ps::size mapping = 0);
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto begin () -> io_apic<Registers> * { return _io_apics; }
+
+        auto end () -> io_apic<Registers> * { return _io_apics + _count; }
+
+        auto size () const -> unsigned { return _count; }
+
+        //! @brief Number of I/O APICs described by the MADT, which may exceed capacity.
+
+        auto found () const -> unsigned { return _found; }
+
+        //! @brief ISA interrupt source mapping, with overrides applied.
+
+        auto isa (ps::size1 irq) const -> isa_interrupt { return _isa[irq & 0x0F]; }
+
+        //! @}
+
+        //! @brief Routing
+        //! @{
+
+        //! @brief Route GSI to vector on the processor with destination APIC id; input remains masked.
+
+        auto route (ps::size4 gsi, ps::size1 vector, ps::size1 destination, io_apic_polarity polarity, io_apic_trigger trigger) -> bool
+        {
+            auto const target = find(gsi);
+            if (target == nullptr) return false;
+            target->redirection(gsi, { vector, io_apic_delivery::fixed, false, polarity, trigger, true, destination });
+            return true;
+        }
+
+        //! @brief Route ISA IRQ to vector on the processor with destination APIC id; input remains masked.
+
+        auto route_isa (ps::size1 irq, ps::size1 vector, ps::size1 destination) -> bool
+        {
+            auto const source = isa(irq);
+            return route(source.gsi, vector, destination, source.polarity, source.trigger);
+        }
+
+        auto mask (ps::size4 gsi) -> bool
+        {
+            auto const target = find(gsi);
+            if (target == nullptr) return false;
+            target->mask(gsi);
+            return true;
+        }
+
+        auto unmask (ps::size4 gsi) -> bool
+        {
+            auto const target = find(gsi);
+            if (target == nullptr) return false;
+            target->unmask(gsi);
+            return true;
+        }
+
+        //! @}
+    };
+
+    template <typename Registers>
+    io_apic_router<Registers>::io_apic_router (acpi::apic_system_description const & madt, ps::size mapping)
+    {
+        // ISA interrupts are edge triggered, active high, identity mapped unless overridden.
+
+        for (unsigned i = 0; i != 16; ++i)
+            _isa[i] = { i, io_apic_polarity::high, io_apic_trigger::edge };
+
+        for (auto & description : acpi::apic_structures<acpi::io_apic_description>(madt))
+        {
+            ++_found;
+            if (_count == capacity) continue;
+            _io_apics[_count++] = io_apic<Registers> { description.address + mapping, description.system_vector_base };
+        }
+
+        for (auto & description : acpi::apic_structures<acpi::input_source_override_description>(madt))
+        {
+            if (description.bus != 0 || description.source >= 16) continue;
+            // MPS INTI flags: 01 active high, 11 active low; 01 edge, 11 level; 00 conforms to bus.
+            auto const polarity = (description.flags & 3) == 3 ? io_apic_polarity::low : io_apic_polarity::high;
+            auto const trigger = ((description.flags >> 2) & 3) == 3 ? io_apic_trigger::level : io_apic_trigger::edge;
+            _isa[description.source] = { description.global_system_interrupt_vector, polarity, trigger };
+        }
+    }
+}
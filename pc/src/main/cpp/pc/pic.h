@@ -92,7 +92,7 @@ namespace pc
 
         void ocw2 (ps::size1 level, bool eoi, bool specific, bool rotate)
         {
-            ps::size1 value = (level & 0x07) | (eoi ? 8 : 0) | (specific ? 16 : 0) | (rotate ? 32 : 0);
+            ps::size1 value = (level & 0x07) | (eoi ? 0x20 : 0) | (specific ? 0x40 : 0) | (rotate ? 0x80 : 0);
             _command.write(value);
         }
 
@@ -111,8 +111,13 @@ namespace pc
 
         ps::size1 in_service ()
         {
-            ocw3(pic_read::is, true, pic_mask::ignore);
-            // #XXX: wait? how?
+            ocw3(pic_read::is, false, pic_mask::ignore);
+            return _command.read();
+        }
+
+        ps::size1 interrupt_request ()
+        {
+            ocw3(pic_read::ir, false, pic_mask::ignore);
             return _command.read();
         }
 
@@ -167,4 +172,150 @@ namespace pc
         }
 
     };
+
+    //! @brief Master and slave PIC controllers, cascaded on master line 2
+    //!
+    //! Masks are cached in memory: reading and changing masks writes only the affected controller.
+    //! Spurious interrupts on lines 7 and 15 are detected by reading the in-service register.
+
+    template <template <unsigned Width> typename Port>
+        requires ps::is_port<Port, 1>
+    class pic_pair
+    {
+        master_pic<Port> _master;
+        slave_pic<Port>  _slave;
+        ps::size1        _master_offset {};
+        ps::size1        _slave_offset {};
+        ps::size2        _mask { 0xFFFF };
+        unsigned         _spurious_master {};
+        unsigned         _spurious_slave {};
+
+        static constexpr ps::size1 cascade = 2;
+
+    public:
+
+        using port_address = typename pic<Port>::port_address;
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        pic_pair () : pic_pair { 0x20, 0x21, 0xA0, 0xA1 } { }
+
+        constexpr
+        pic_pair (port_address master_command, port_address master_data, port_address slave_command, port_address slave_data) :
+            _master { master_command, master_data },
+            _slave { slave_command, slave_data }
+        { }
+
+        //! @}
+
+        //! @brief Initialization
+        //! @{
+
+        //! @brief Initialize both controllers, edge triggered, with vector offsets; restores cached masks
+
+        void remap (ps::size1 master_offset, ps::size1 slave_offset)
+        {
+            _master_offset = master_offset & 0xF8;
+            _slave_offset = slave_offset & 0xF8;
+            _master.icw1(true, false, false);
+            _slave.icw1(true, false, false);
+            _master.icw2(_master_offset);
+            _slave.icw2(_slave_offset);
+            _master.icw3(1 << cascade);
+            _slave.icw3(cascade);
+            _master.icw4(true, false, pic_buffering::none, false);
+            _slave.icw4(true, false, pic_buffering::none, false);
+            _master.ocw1(_mask & 0xFF);
+            _slave.ocw1(_mask >> 8);
+        }
+
+        //! @}
+
+        //! @brief Masking
+        //! @{
+
+        //! @brief Cached mask; bit n masks IRQ n
+
+        auto mask () const -> ps::size2 { return _mask; }
+
+        void mask (ps::size2 value)
+        {
+            auto const changed = _mask ^ value;
+            _mask = value;
+            if ((changed & 0x00FF) != 0) _master.ocw1(_mask & 0xFF);
+            if ((changed & 0xFF00) != 0) _slave.ocw1(_mask >> 8);
+        }
+
+        void mask_irq (ps::size1 irq)
+        {
+            mask(_mask | ps::size2(1 << (irq & 0x0F)));
+        }
+
+        //! @brief Unmask IRQ; slave IRQs also unmask the cascade line
+
+        void unmask_irq (ps::size1 irq)
+        {
+            auto value = _mask & ~ps::size2(1 << (irq & 0x0F));
+            if (irq >= 8) value &= ~ps::size2(1 << cascade);
+            mask(value);
+        }
+
+        //! @}
+
+        //! @brief Interrupt handling
+        //! @{
+
+        //! @brief IRQ for vector, or 16 if vector is not served by this pair
+
+        auto irq (ps::size1 vector) const -> ps::size1
+        {
+            if ((vector & 0xF8) == _master_offset) return vector & 7;
+            if ((vector & 0xF8) == _slave_offset) return 8 + (vector & 7);
+            return 16;
+        }
+
+        //! @brief Test if IRQ is spurious; spurious IRQs must not be acknowledged with eoi
+        //!
+        //! Spurious IRQ 15 is acknowledged to the master here, because the master did raise the cascade line.
+
+        auto is_spurious (ps::size1 irq) -> bool
+        {
+            if (irq == 7 && (_master.in_service() & 0x80) == 0) {
+                ++_spurious_master;
+                return true;
+            }
+            if (irq == 15 && (_slave.in_service() & 0x80) == 0) {
+                ++_spurious_slave;
+                _master.ocw2(cascade, true, true, false);
+                return true;
+            }
+            return false;
+        }
+
+        //! @brief Specific end of interrupt, to the slave only for slave IRQs, then to the master
+
+        void eoi (ps::size1 irq)
+        {
+            if (irq >= 8) {
+                _slave.ocw2(irq & 7, true, true, false);
+                _master.ocw2(cascade, true, true, false);
+            }
+            else {
+                _master.ocw2(irq & 7, true, true, false);
+            }
+        }
+
+        //! @}
+
+        //! @brief Statistics
+        //! @{
+
+        auto spurious_master () const -> unsigned { return _spurious_master; }
+
+        auto spurious_slave () const -> unsigned { return _spurious_slave; }
+
+        //! @}
+    };
 }
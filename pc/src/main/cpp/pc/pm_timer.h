@@ -0,0 +1,147 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace pc
+{
+    //! @brief ACPI power management timer
+    //!
+    //! Free running 3.579545 MHz counter, 24 or 32 bits wide, in I/O space.
+    //! The counter is extended to 64 bits in software: it must be read at least once per wrap,
+    //! every 4.6 seconds for 24 bits or 20 minutes for 32 bits.
+
+    template <template <unsigned Width> typename Port>
+        requires ps::is_port<Port, 4>
+    class pm_timer
+    {
+        Port<4>       _port;
+        ps::size4     _mask;
+        ps::spin_lock _lock {};
+        ps::size4     _last {};
+        ps::size8     _count {};
+
+    public:
+
+        using port_address = typename Port<4>::address_type;
+
+        //! @brief Counter frequency in Hz
+
+        static constexpr ps::size8 frequency = 3579545;
+
+        //! @brief Object
+        //! @{
+
+        pm_timer (port_address address, bool wide) :
+            _port { address },
+            _mask { wide ? 0xFFFFFFFF : 0x00FFFFFF }
+        {
+            _last = read();
+        }
+
+        //! @brief Timer described by ACPI FADT; FADT must describe a timer in I/O space
+
+        explicit
+        pm_timer (acpi::fixed_system_description const & description) :
+            pm_timer { port_address(acpi::pm_timer_address(description).address), acpi::is_pm_timer_32bit(description) }
+        { }
+
+        pm_timer (pm_timer const &) = delete;
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto is_32bit () const -> bool { return _mask == 0xFFFFFFFF; }
+
+        //! @}
+
+        //! @brief Counter
+        //! @{
+
+        //! @brief Hardware counter value
+
+        auto read () -> ps::size4 { return ps::size4(_port.read()) & _mask; }
+
+        //! @brief Extended counter value: ticks since object construction
+
+        auto counter () -> ps::size8
+        {
+            ps::lock_guard guard { _lock };
+            auto const value = read();
+            _count += (value - _last) & _mask;
+            _last = value;
+            return _count;
+        }
+
+        //! @brief Convert ticks to nanoseconds
+
+        static constexpr
+        auto nanoseconds (ps::size8 ticks) -> ps::size8
+        {
+            // Split to avoid overflow of ticks times 10^9.
+            return (ticks / frequency) * 1000000000 + ((ticks % frequency) * 1000000000) / frequency;
+        }
+
+        //! @brief Convert nanoseconds to ticks, rounding up
+
+        static constexpr
+        auto ticks (ps::size8 nanoseconds) -> ps::size8
+        {
+            return (nanoseconds / 1000000000) * frequency + ((nanoseconds % 1000000000) * frequency + 999999999) / 1000000000;
+        }
+
+        //! @brief Nanoseconds since object construction
+
+        auto now () -> ps::size8 { return nanoseconds(counter()); }
+
+        //! @brief Busy wait for at least ticks
+
+        void wait (ps::size8 ticks)
+        {
+            auto const start = counter();
+            while (counter() - start < ticks) __builtin_ia32_pause();
+        }
+
+        //! @}
+
+        //! @brief Calibration
+        //! @{
+
+        //! @brief Measure frequency in Hz of another counter, such as the time stamp counter
+        //!
+        //! Waits for a timer edge to start, then spins for at least ticks;
+        //! each timer read is bracketed by two reads of the other counter, taking the midpoint.
+
+        template <typename Read>
+        auto calibrate (Read read_other, ps::size4 ticks) -> ps::size8
+        {
+            auto sample = [&] (ps::size4 & value) -> ps::size8 {
+                auto const before = read_other();
+                value = read();
+                auto const after = read_other();
+                return before + (after - before) / 2;
+            };
+
+            auto const first = read();
+            ps::size4 start;
+            ps::size8 begin;
+            do { begin = sample(start); } while (start == first);
+
+            ps::size4 value, elapsed;
+            ps::size8 end;
+            do {
+                end = sample(value);
+                elapsed = (value - start) & _mask;
+            }
+            while (elapsed < ticks);
+
+            return ((end - begin) * frequency) / elapsed;
+        }
+
+        //! @}
+    };
+}
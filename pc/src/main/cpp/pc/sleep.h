@@ -0,0 +1,103 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace pc
+{
+    //! @brief ACPI fixed hardware power control
+    //!
+    //! PM1a and optional PM1b control registers and the SMI command port, in I/O space.
+
+    template <template <unsigned Width> typename Port>
+        requires ps::is_port<Port, 1> && ps::is_port<Port, 2>
+    class power_control
+    {
+        Port<2>   _pm1a;
+        Port<2>   _pm1b;
+        Port<1>   _smi_command;
+        bool      _has_pm1b;
+        ps::size1 _cstate_control;
+
+    public:
+
+        using port_address = typename Port<2>::address_type;
+
+        //! @brief PM1 control sleep type field shift
+
+        static constexpr unsigned sleep_type_shift = 10;
+
+        //! @brief PM1 control sleep enable bit
+
+        static constexpr ps::size2 sleep_enable = 1 << 13;
+
+        //! @brief Object
+        //! @{
+
+        //! @brief Control with PM1b address zero if absent, and C-state control value zero if unsupported
+
+        power_control (port_address pm1a, port_address pm1b, port_address smi_command, ps::size1 cstate_control) :
+            _pm1a { pm1a },
+            _pm1b { pm1b },
+            _smi_command { typename Port<1>::address_type(smi_command) },
+            _has_pm1b { pm1b != 0 },
+            _cstate_control { cstate_control }
+        { }
+
+        //! @brief Control described by ACPI FADT; FADT must describe control registers in I/O space
+
+        explicit
+        power_control (acpi::fixed_system_description const & description) :
+            power_control {
+                port_address(acpi::pm1_control_address(description, false).address),
+                port_address(acpi::pm1_control_address(description, true).address),
+                port_address(description.SMI_CommandPort),
+                description.SMI_CommandPort != 0 ? description.CStateControl : ps::size1(0)
+            }
+        { }
+
+        power_control (power_control const &) = delete;
+
+        //! @}
+
+        //! @brief C-states
+        //! @{
+
+        //! @brief True if firmware accepts _CST support notification
+
+        auto has_cstate_control () const -> bool { return _cstate_control != 0; }
+
+        //! @brief Notify firmware that _CST is in use; does nothing if unsupported
+
+        void announce_cstate_control ()
+        {
+            if (_cstate_control != 0) _smi_command.write(_cstate_control);
+        }
+
+        //! @}
+
+        //! @brief Sleep states
+        //! @{
+
+        //! @brief Enter sleep state with type values from \_Sx
+        //!
+        //! Writes sleep type first, then sleep type with sleep enable, preserving other control bits;
+        //! for S1 to S4 the processor context must be saved beforehand,
+        //! and for S1 to S3 the caller must flush caches, with x86::wbinvd, right before this call.
+
+        void sleep (acpi::sleep_type type)
+        {
+            auto const mask = ps::size2(0x7 << sleep_type_shift) | sleep_enable;
+            auto const a = ps::size2((ps::size2(_pm1a.read()) & ~mask) | (ps::size2(type.a) << sleep_type_shift));
+            auto const b = _has_pm1b ? ps::size2((ps::size2(_pm1b.read()) & ~mask) | (ps::size2(type.b) << sleep_type_shift)) : ps::size2(0);
+            _pm1a.write(a);
+            if (_has_pm1b) _pm1b.write(b);
+            _pm1a.write(a | sleep_enable);
+            if (_has_pm1b) _pm1b.write(b | sleep_enable);
+        }
+
+        //! @}
+    };
+}
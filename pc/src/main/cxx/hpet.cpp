@@ -0,0 +1,7 @@
+#include <pc/hpet.h>
+
+static_assert(__builtin_offsetof(pc::hpet_memory_map, counter) == 0x0F0, "unexpected offset of pc::hpet_memory_map::counter");
+
+static_assert(__builtin_offsetof(pc::hpet_memory_map, timers) == 0x100, "unexpected offset of pc::hpet_memory_map::timers");
+
+static_assert(sizeof(pc::hpet_timer_memory_map) == 0x20, "unexpected size of pc::hpet_timer_memory_map");
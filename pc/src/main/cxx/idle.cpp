@@ -0,0 +1 @@
+#include <pc/idle.h>
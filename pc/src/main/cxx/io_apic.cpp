@@ -0,0 +1 @@
+#include <pc/io_apic.h>
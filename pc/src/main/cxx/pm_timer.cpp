@@ -0,0 +1 @@
+#include <pc/pm_timer.h>
@@ -0,0 +1 @@
+#include <pc/sleep.h>
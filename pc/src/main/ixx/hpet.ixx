@@ -0,0 +1,14 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pc/hpet.h>
+
+export module br.dev.pedrolamarao.metal.pc:hpet;
+
+export namespace pc
+{
+    using ::pc::hpet_timer_memory_map;
+    using ::pc::hpet_memory_map;
+    using ::pc::hpet;
+}
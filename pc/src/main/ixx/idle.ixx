@@ -0,0 +1,17 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pc/idle.h>
+
+export module br.dev.pedrolamarao.metal.pc:idle;
+
+export namespace pc
+{
+    using ::pc::idle_method;
+    using ::pc::idle_state;
+    using ::pc::idle_state_of;
+    using ::pc::idle_governor;
+    using ::pc::enter_idle;
+    using ::pc::idle;
+}
@@ -0,0 +1,19 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pc/io_apic.h>
+
+export module br.dev.pedrolamarao.metal.pc:io_apic;
+
+export namespace pc
+{
+    using ::pc::io_apic_polarity;
+    using ::pc::io_apic_trigger;
+    using ::pc::io_apic_delivery;
+    using ::pc::io_apic_redirection;
+    using ::pc::io_apic_memory_map;
+    using ::pc::io_apic;
+    using ::pc::isa_interrupt;
+    using ::pc::io_apic_router;
+}
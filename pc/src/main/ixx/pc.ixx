@@ -3,6 +3,11 @@
 export module br.dev.pedrolamarao.metal.pc;
 
 export import :cmos;
+export import :hpet;
+export import :idle;
+export import :io_apic;
 export import :pic;
 export import :pit;
+export import :pm_timer;
+export import :sleep;
 export import :uart;
\ No newline at end of file
@@ -14,4 +14,5 @@ export namespace pc
     using ::pc::pic;
     using ::pc::master_pic;
     using ::pc::slave_pic;
+    using ::pc::pic_pair;
 }
\ No newline at end of file
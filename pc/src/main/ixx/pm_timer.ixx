@@ -0,0 +1,12 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pc/pm_timer.h>
+
+export module br.dev.pedrolamarao.metal.pc:pm_timer;
+
+export namespace pc
+{
+    using ::pc::pm_timer;
+}
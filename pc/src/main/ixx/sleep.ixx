@@ -0,0 +1,12 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pc/sleep.h>
+
+export module br.dev.pedrolamarao.metal.pc:sleep;
+
+export namespace pc
+{
+    using ::pc::power_control;
+}
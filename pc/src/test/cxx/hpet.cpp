@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.pc;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Timer block simulated by memory: 100 MHz, 3 comparators, 64-bit, legacy capable;
+    // comparator 0 periodic capable, comparator 2 FSB capable.
+
+    auto make_registers (pc::hpet_memory_map & registers)
+    {
+        registers.capabilities = (ps::size8(10000000) << 32) | (1 << 15) | (1 << 13) | (2 << 8) | 1;
+        registers.timers[0].configuration = (ps::size8(0x00F00000) << 32) | (1 << 5) | (1 << 4);
+        registers.timers[1].configuration = (ps::size8(0x00F00000) << 32) | (1 << 5);
+        registers.timers[2].configuration = (ps::size8(0x00F00000) << 32) | (1 << 15) | (1 << 5);
+    }
+
+    TEST(hpet, properties)
+    {
+        static pc::hpet_memory_map registers {};
+        make_registers(registers);
+
+        pc::hpet hpet { reinterpret_cast<ps::size>(&registers) };
+        ASSERT_EQ(hpet.period(), 10000000);
+        ASSERT_EQ(hpet.frequency(), 100000000);
+        ASSERT_EQ(hpet.count(), 3);
+        ASSERT_TRUE(hpet.is_64bit());
+        ASSERT_TRUE(hpet.is_legacy_capable());
+        ASSERT_EQ(hpet.routes(0), 0x00F00000);
+        ASSERT_TRUE(hpet.is_periodic_capable(0));
+        ASSERT_FALSE(hpet.is_periodic_capable(1));
+        ASSERT_TRUE(hpet.is_fsb_capable(2));
+
+        hpet.enable();
+        ASSERT_TRUE(hpet.is_enabled());
+        hpet.legacy(true);
+        ASSERT_EQ(registers.configuration, 3);
+
+        registers.counter = 250;
+        ASSERT_EQ(hpet.counter(), 250);
+        ASSERT_EQ(hpet.now(), 2500);
+        ASSERT_EQ(hpet.nanoseconds(ps::size8(3000000000000)), ps::size8(30000000000000));
+        ASSERT_EQ(hpet.ticks(1000), 100);
+    }
+
+    TEST(hpet, comparators)
+    {
+        static pc::hpet_memory_map registers {};
+        make_registers(registers);
+
+        pc::hpet hpet { reinterpret_cast<ps::size>(&registers) };
+        registers.counter = 1000;
+
+        hpet.one_shot(1, 500, 20);
+        ASSERT_EQ(registers.timers[1].comparator, 1500);
+        ASSERT_EQ((registers.timers[1].configuration >> 9) & 0x1F, 20);
+        ASSERT_NE(registers.timers[1].configuration & (1 << 2), 0);
+        ASSERT_EQ(registers.timers[1].configuration & (1 << 3), 0);
+
+        // Simulated comparator keeps the last value written: the accumulator.
+        ASSERT_FALSE(hpet.periodic(1, 100, 20));
+        ASSERT_TRUE(hpet.periodic(0, 100, 21));
+        ASSERT_EQ(registers.timers[0].comparator, 100);
+        ASSERT_NE(registers.timers[0].configuration & (1 << 3), 0);
+        ASSERT_NE(registers.timers[0].configuration & (1 << 2), 0);
+
+        ASSERT_FALSE(hpet.fsb(1, 0xFEE00000, 0x40));
+        ASSERT_TRUE(hpet.fsb(2, 0xFEE00000, 0x40));
+        ASSERT_EQ(registers.timers[2].fsb_route, 0xFEE0000000000040);
+
+        hpet.stop(0);
+        ASSERT_EQ(registers.timers[0].configuration & (1 << 2), 0);
+    }
+
+    TEST(hpet, description)
+    {
+        static pc::hpet_memory_map registers {};
+        make_registers(registers);
+
+        acpi::hpet_description description {};
+        description.event_timer_block_id = 0x8086A201;
+        description.address.address = 0xFED00000;
+        ASSERT_EQ(acpi::comparators(description), 3);
+        ASSERT_TRUE(acpi::is_legacy_capable(description));
+
+        pc::hpet hpet { description, reinterpret_cast<ps::size>(&registers) - 0xFED00000 };
+        ASSERT_EQ(hpet.count(), 3);
+    }
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.pc;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    TEST(idle, state_of)
+    {
+        pc::idle_state state {};
+
+        ASSERT_TRUE(pc::idle_state_of({ { 0x7F, 1, 2, 1, 0x20 }, 2, 50, 500 }, state));
+        ASSERT_EQ(state.method, pc::idle_method::mwait);
+        ASSERT_EQ(state.hint, 0x20);
+        ASSERT_EQ(state.exit_latency, 50000);
+        ASSERT_EQ(state.target_residency, 150000);
+
+        ASSERT_TRUE(pc::idle_state_of({ { 1, 8, 0, 0, 0x414 }, 3, 100, 100 }, state));
+        ASSERT_EQ(state.method, pc::idle_method::io);
+        ASSERT_EQ(state.hint, 0x414);
+
+        ASSERT_TRUE(pc::idle_state_of({ { 0, 0, 0, 0, 0 }, 1, 1, 1000 }, state));
+        ASSERT_EQ(state.method, pc::idle_method::halt);
+
+        ASSERT_FALSE(pc::idle_state_of({ { 0, 8, 0, 0, 0x1000 }, 2, 100, 100 }, state));
+    }
+
+    TEST(idle, select)
+    {
+        pc::idle_governor<4> governor;
+        ASSERT_EQ(governor.size(), 1);
+        ASSERT_EQ(governor.state(0).method, pc::idle_method::poll);
+
+        // Added out of order: kept ordered by target residency.
+        ASSERT_TRUE(governor.add({ pc::idle_method::mwait, 0x20, 100000, 400000 }));
+        ASSERT_TRUE(governor.add({ pc::idle_method::halt, 0, 1000, 2000 }));
+        ASSERT_TRUE(governor.add({ pc::idle_method::mwait, 0x10, 20000, 60000 }));
+        ASSERT_FALSE(governor.add({ pc::idle_method::halt, 0, 1, 1 }));
+        ASSERT_EQ(governor.state(1).method, pc::idle_method::halt);
+        ASSERT_EQ(governor.state(2).hint, 0x10);
+        ASSERT_EQ(governor.state(3).hint, 0x20);
+
+        auto const unbounded = governor.unbounded;
+
+        // Without history, the next event bounds the expected idle duration.
+        ASSERT_EQ(governor.select(1000, unbounded), 0);
+        ASSERT_EQ(governor.select(2000, unbounded), 1);
+        ASSERT_EQ(governor.select(100000, unbounded), 2);
+        ASSERT_EQ(governor.select(unbounded, unbounded), 3);
+
+        // Latency limit excludes deeper states.
+        ASSERT_EQ(governor.select(unbounded, 50000), 2);
+        ASSERT_EQ(governor.select(unbounded, 500), 0);
+    }
+
+    TEST(idle, update)
+    {
+        pc::idle_governor<4> governor;
+        governor.add({ pc::idle_method::halt, 0, 1000, 2000 });
+        governor.add({ pc::idle_method::mwait, 0x20, 100000, 400000 });
+
+        auto const unbounded = governor.unbounded;
+
+        // Long idle periods predict long idle.
+        governor.update(2, 1000000, 0);
+        ASSERT_EQ(governor.predicted(), 1000000);
+        ASSERT_EQ(governor.select(unbounded, unbounded), 2);
+
+        // Short idle periods pull the prediction down quickly: about to be busy.
+        governor.update(2, 1000, 0);
+        governor.update(2, 1000, 0);
+        governor.update(2, 1000, 0);
+        ASSERT_LT(governor.predicted(), 400000);
+        ASSERT_EQ(governor.select(unbounded, unbounded), 1);
+
+        // Long idle periods raise it slowly.
+        governor.update(1, 1000000, 0);
+        ASSERT_LT(governor.predicted(), 400000);
+        for (int i = 0; i != 16; ++i) governor.update(1, 1000000, 0);
+        ASSERT_EQ(governor.select(unbounded, unbounded), 2);
+
+        // Measured exit latency above declared excludes state under limit.
+        ASSERT_EQ(governor.exit_latency(2), 100000);
+        governor.update(2, 1000000, 300000);
+        ASSERT_EQ(governor.exit_latency(2), 150000);
+        ASSERT_EQ(governor.select(unbounded, 120000), 1);
+        ASSERT_EQ(governor.select(unbounded, 200000), 2);
+    }
+
+    TEST(idle, add_power_states)
+    {
+        acpi::power_state const states [] {
+            { { 0x7F, 1, 2, 1, 0x00 }, 1, 1, 1000 },
+            { { 1, 8, 0, 0, 0x414 }, 2, 100, 500 },
+            { { 0, 8, 0, 0, 0x1000 }, 3, 200, 100 },
+        };
+        pc::idle_governor<> governor;
+        ASSERT_EQ(governor.add(states, 3), 2);
+        ASSERT_EQ(governor.size(), 3);
+        ASSERT_EQ(governor.state(1).method, pc::idle_method::mwait);
+        ASSERT_EQ(governor.state(2).method, pc::idle_method::io);
+    }
+}
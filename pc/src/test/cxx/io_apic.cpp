@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.pc;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // I/O APIC simulated by a register file: select chooses the register the window accesses; window writes are recorded.
+
+    struct access { unsigned index; unsigned value; };
+
+    access writes [16] {};
+    unsigned write_count {};
+    ps::size4 file [0x40] {};
+    unsigned selected {};
+
+    struct select_register
+    {
+        auto operator= (ps::size4 value) -> select_register & { selected = unsigned(value) % 0x40; return *this; }
+    };
+
+    struct window_register
+    {
+        operator ps::size4 () const { return file[selected]; }
+
+        auto operator= (ps::size4 value) -> window_register &
+        {
+            file[selected] = value;
+            writes[write_count++ % 16] = { selected, unsigned(value) };
+            return *this;
+        }
+    };
+
+    struct simulated_memory_map
+    {
+        select_register select;
+        ps::size4       reserved [3];
+        window_register window;
+    };
+
+    void reset ()
+    {
+        write_count = 0;
+        selected = 0;
+        for (auto & value : file) value = 0;
+        // Version register: 24 redirection entries.
+        file[1] = 23 << 16;
+    }
+
+    TEST(io_apic_redirection, encoding)
+    {
+        auto entry = pc::io_apic_redirection {
+            0x30, pc::io_apic_delivery::fixed, false, pc::io_apic_polarity::low, pc::io_apic_trigger::level, true, 3
+        };
+        ASSERT_EQ(entry.vector(), 0x30);
+        ASSERT_EQ(entry.delivery(), pc::io_apic_delivery::fixed);
+        ASSERT_FALSE(entry.logical());
+        ASSERT_EQ(entry.polarity(), pc::io_apic_polarity::low);
+        ASSERT_EQ(entry.trigger(), pc::io_apic_trigger::level);
+        ASSERT_TRUE(entry.masked());
+        ASSERT_EQ(entry.destination(), 3);
+        ASSERT_EQ(static_cast<std::uint64_t>(ps::size8(entry)), 0x030000000001A030ULL);
+    }
+
+    TEST(io_apic, redirection)
+    {
+        reset();
+        simulated_memory_map registers {};
+        pc::io_apic<simulated_memory_map> io_apic { reinterpret_cast<ps::size>(&registers), 16 };
+        ASSERT_EQ(io_apic.count(), 24);
+
+        // Entry is written masked, then the high word, then the unmasked low word.
+        io_apic.redirection(18, { 0x41, pc::io_apic_delivery::fixed, false, pc::io_apic_polarity::high, pc::io_apic_trigger::edge, false, 2 });
+        ASSERT_EQ(write_count, 3);
+        ASSERT_EQ(writes[0].index, 0x14);
+        ASSERT_EQ(writes[0].value, 0x00010041);
+        ASSERT_EQ(writes[1].index, 0x15);
+        ASSERT_EQ(writes[1].value, 0x02000000);
+        ASSERT_EQ(writes[2].index, 0x14);
+        ASSERT_EQ(writes[2].value, 0x00000041);
+        ASSERT_FALSE(io_apic.redirection(18).masked());
+        ASSERT_EQ(io_apic.redirection(18).destination(), 2);
+    }
+
+    TEST(io_apic_router, discover)
+    {
+        reset();
+        simulated_memory_map registers {};
+
+        alignas(8) ps::size1 table [76] {};
+
+        auto & madt = * reinterpret_cast<acpi::apic_system_description *>(table);
+        madt.base.length = sizeof(table);
+
+        auto & io_apic = * reinterpret_cast<acpi::io_apic_description *>(table + 44);
+        io_apic.base.type = 1;
+        io_apic.base.length = 12;
+        io_apic.address = 0xFEC00000;
+        io_apic.system_vector_base = 0;
+
+        // ISA 0 -> GSI 2, conforming
+        ps::size1 const override_0 [10] = { 2, 10, 0, 0, 2, 0, 0, 0, 0x00, 0x00 };
+        for (int i = 0; i != 10; ++i) table[56 + i] = override_0[i];
+
+        // ISA 9 -> GSI 9, active low, level triggered
+        ps::size1 const override_9 [10] = { 2, 10, 0, 9, 9, 0, 0, 0, 0x0F, 0x00 };
+        for (int i = 0; i != 10; ++i) table[66 + i] = override_9[i];
+
+        auto const mapping = reinterpret_cast<ps::size>(&registers) - 0xFEC00000;
+        pc::io_apic_router<simulated_memory_map> router { madt, mapping };
+        ASSERT_EQ(router.size(), 1);
+        ASSERT_EQ(router.found(), 1);
+        ASSERT_EQ(router.begin()->count(), 24);
+
+        ASSERT_EQ(router.isa(0).gsi, 2);
+        ASSERT_EQ(router.isa(0).polarity, pc::io_apic_polarity::high);
+        ASSERT_EQ(router.isa(0).trigger, pc::io_apic_trigger::edge);
+        ASSERT_EQ(router.isa(1).gsi, 1);
+        ASSERT_EQ(router.isa(9).gsi, 9);
+        ASSERT_EQ(router.isa(9).polarity, pc::io_apic_polarity::low);
+        ASSERT_EQ(router.isa(9).trigger, pc::io_apic_trigger::level);
+
+        // Routed entry is programmed masked, with level trigger and active low polarity from the override.
+        write_count = 0;
+        ASSERT_TRUE(router.route_isa(9, 0x39, 1));
+        ASSERT_EQ(write_count, 3);
+        ASSERT_EQ(writes[0].index, 0x10 + 2 * 9);
+        ASSERT_EQ(writes[0].value, 0x0001A039);
+        ASSERT_EQ(writes[1].index, 0x10 + 2 * 9 + 1);
+        ASSERT_EQ(writes[1].value, 0x01000000);
+        ASSERT_EQ(writes[2].index, 0x10 + 2 * 9);
+        ASSERT_EQ(writes[2].value, 0x0001A039);
+
+        ASSERT_TRUE(router.unmask(9));
+        ASSERT_EQ(file[0x10 + 2 * 9], 0x0000A039);
+        ASSERT_FALSE(router.route(24, 0x40, 0, pc::io_apic_polarity::high, pc::io_apic_trigger::edge));
+    }
+
+    TEST(io_apic_router, truncated)
+    {
+        // I/O APIC registers are simulated by memory: reading the window returns the last value written.
+
+        alignas(16) pc::io_apic_memory_map registers {};
+        registers.window = 23 << 16;
+
+        constexpr unsigned count = pc::io_apic_router<>::capacity + 1;
+        alignas(8) ps::size1 table [44 + 12 * count] {};
+
+        auto & madt = * reinterpret_cast<acpi::apic_system_description *>(table);
+        madt.base.length = sizeof(table);
+
+        for (unsigned i = 0; i != count; ++i)
+        {
+            auto & io_apic = * reinterpret_cast<acpi::io_apic_description *>(table + 44 + 12 * i);
+            io_apic.base.type = 1;
+            io_apic.base.length = 12;
+            io_apic.address = 0xFEC00000;
+            io_apic.system_vector_base = 24 * i;
+        }
+
+        auto const mapping = reinterpret_cast<ps::size>(&registers) - 0xFEC00000;
+        pc::io_apic_router router { madt, mapping };
+        ASSERT_EQ(router.size(), pc::io_apic_router<>::capacity);
+        ASSERT_EQ(router.found(), count);
+        ASSERT_FALSE(router.mask(24 * (count - 1)));
+    }
+}
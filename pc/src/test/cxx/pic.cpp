@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 import br.dev.pedrolamarao.metal.pc;
+import br.dev.pedrolamarao.metal.psys;
 
 namespace
 {
@@ -25,4 +26,131 @@ namespace
     {
         pc::pic<port> pic { 0, 0 };
     }
+
+    // Port recording writes; reads return the programmed value for its address.
+
+    struct access { unsigned address; unsigned value; };
+
+    access writes [64] {};
+    unsigned write_count {};
+    unsigned reads {};
+    unsigned read_values [256] {};
+
+    template <unsigned Size>
+    class recording_port
+    {
+        unsigned _address;
+
+    public:
+
+        typedef unsigned _BitInt(16) address_type;
+
+        typedef unsigned _BitInt(Size * 8) data_type;
+
+        recording_port (address_type address) : _address { unsigned(address) } { }
+
+        data_type read () { ++reads; return data_type(read_values[_address & 0xFF]); }
+
+        void write (data_type value) { writes[write_count++ % 64] = { _address, unsigned(value) }; }
+    };
+
+    void reset ()
+    {
+        write_count = 0;
+        reads = 0;
+        for (auto & value : read_values) value = 0;
+    }
+
+    TEST(pic_pair, remap)
+    {
+        reset();
+        pc::pic_pair<recording_port> pair {};
+        pair.remap(0x20, 0x28);
+        ASSERT_EQ(write_count, 10);
+        ASSERT_EQ(writes[0].address, 0x20);
+        ASSERT_EQ(writes[0].value, 0x11);
+        ASSERT_EQ(writes[2].address, 0x21);
+        ASSERT_EQ(writes[2].value, 0x20);
+        ASSERT_EQ(writes[3].address, 0xA1);
+        ASSERT_EQ(writes[3].value, 0x28);
+        ASSERT_EQ(writes[8].value, 0xFF);
+        ASSERT_EQ(writes[9].value, 0xFF);
+        ASSERT_EQ(pair.irq(0x21), 1);
+        ASSERT_EQ(pair.irq(0x2F), 15);
+        ASSERT_EQ(pair.irq(0x30), 16);
+    }
+
+    TEST(pic_pair, mask)
+    {
+        reset();
+        pc::pic_pair<recording_port> pair {};
+
+        // Master only.
+        pair.unmask_irq(0);
+        ASSERT_EQ(write_count, 1);
+        ASSERT_EQ(writes[0].address, 0x21);
+        ASSERT_EQ(writes[0].value, 0xFE);
+
+        // Slave IRQ unmasks cascade line.
+        pair.unmask_irq(12);
+        ASSERT_EQ(write_count, 3);
+        ASSERT_EQ(writes[1].address, 0x21);
+        ASSERT_EQ(writes[1].value, 0xFA);
+        ASSERT_EQ(writes[2].address, 0xA1);
+        ASSERT_EQ(writes[2].value, 0xEF);
+        ASSERT_EQ(pair.mask(), 0xEFFA);
+
+        // Unchanged mask writes nothing; masks are never read.
+        pair.mask(0xEFFA);
+        ASSERT_EQ(write_count, 3);
+        ASSERT_EQ(reads, 0);
+    }
+
+    TEST(pic_pair, spurious)
+    {
+        reset();
+        pc::pic_pair<recording_port> pair {};
+
+        // Master IRQ 7 not in service: spurious, no EOI.
+        ASSERT_TRUE(pair.is_spurious(7));
+        ASSERT_EQ(pair.spurious_master(), 1);
+        ASSERT_EQ(write_count, 1);
+        ASSERT_EQ(writes[0].value, 0x0B);
+
+        // Slave IRQ 15 not in service: spurious, EOI to master cascade line only.
+        ASSERT_TRUE(pair.is_spurious(15));
+        ASSERT_EQ(pair.spurious_slave(), 1);
+        ASSERT_EQ(write_count, 3);
+        ASSERT_EQ(writes[1].address, 0xA0);
+        ASSERT_EQ(writes[2].address, 0x20);
+        ASSERT_EQ(writes[2].value, 0x62);
+
+        // In service: genuine.
+        read_values[0x20] = 0x80;
+        ASSERT_FALSE(pair.is_spurious(7));
+        ASSERT_EQ(pair.spurious_master(), 1);
+
+        // Other IRQs are never spurious and touch no ports.
+        write_count = 0;
+        ASSERT_FALSE(pair.is_spurious(3));
+        ASSERT_EQ(write_count, 0);
+    }
+
+    TEST(pic_pair, eoi)
+    {
+        reset();
+        pc::pic_pair<recording_port> pair {};
+
+        pair.eoi(3);
+        ASSERT_EQ(write_count, 1);
+        ASSERT_EQ(writes[0].address, 0x20);
+        ASSERT_EQ(writes[0].value, 0x63);
+
+        pair.eoi(12);
+        ASSERT_EQ(write_count, 3);
+        ASSERT_EQ(writes[1].address, 0xA0);
+        ASSERT_EQ(writes[1].value, 0x64);
+        ASSERT_EQ(writes[2].address, 0x20);
+        ASSERT_EQ(writes[2].value, 0x62);
+    }
 }
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.pc;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Port simulating a free running counter, advancing on every read.
+
+    unsigned timer_value {};
+    unsigned timer_step {};
+    unsigned timer_address {};
+
+    template <unsigned Size>
+    class timer_port
+    {
+    public:
+
+        typedef unsigned _BitInt(16) address_type;
+
+        typedef unsigned _BitInt(Size * 8) data_type;
+
+        timer_port (address_type address) { timer_address = unsigned(address); }
+
+        data_type read () { timer_value += timer_step; return data_type(timer_value); }
+
+        void write (data_type value) { }
+    };
+
+    TEST(pm_timer, wrap)
+    {
+        timer_value = 0x00FFFF00;
+        timer_step = 0x80;
+
+        pc::pm_timer<timer_port> timer { 0x608, false };
+        ASSERT_FALSE(timer.is_32bit());
+        ASSERT_EQ(timer_address, 0x608);
+
+        // Counter crosses 24-bit boundary: extended counter keeps increasing.
+        ASSERT_EQ(timer.counter(), 0x80);
+        ASSERT_EQ(timer.counter(), 0x100);
+        ASSERT_EQ(timer.counter(), 0x180);
+        ASSERT_EQ(timer.read(), 0x180);
+    }
+
+    TEST(pm_timer, conversion)
+    {
+        using timer = pc::pm_timer<timer_port>;
+        ASSERT_EQ(timer::nanoseconds(timer::frequency), 1000000000);
+        ASSERT_EQ(timer::nanoseconds(timer::frequency * 3600), ps::size8(3600) * 1000000000);
+        ASSERT_EQ(timer::ticks(1000000000), timer::frequency);
+        ASSERT_EQ(timer::ticks(1), 1);
+        ASSERT_EQ(timer::nanoseconds(timer::ticks(1000000)) >= 1000000, true);
+    }
+
+    TEST(pm_timer, wait)
+    {
+        timer_value = 0xFFFFFFF0;
+        timer_step = 7;
+
+        pc::pm_timer<timer_port> timer { 0x608, true };
+        timer.wait(1000);
+        ASSERT_GE(timer.counter(), 1000);
+    }
+
+    TEST(pm_timer, calibrate)
+    {
+        timer_value = 0;
+        timer_step = 1;
+
+        // Other counter advancing 500 per timer tick: frequency is 500 times timer frequency.
+        ps::size8 other = 0;
+        auto read_other = [&] () -> ps::size8 { other += 250; return other; };
+
+        pc::pm_timer<timer_port> timer { 0x608, false };
+        ASSERT_EQ(timer.calibrate(read_other, 3580), pc::pm_timer<timer_port>::frequency * 500);
+    }
+
+    TEST(pm_timer, description)
+    {
+        static acpi::fixed_system_description description {};
+        description.base.length = sizeof(description);
+        description.PMTimerBlock = 0x608;
+        description.PMTimerLength = 4;
+
+        auto address = acpi::pm_timer_address(description);
+        ASSERT_EQ(address.space, ps::size1(acpi::address_space::system_io));
+        ASSERT_EQ(address.address, 0x608);
+        ASSERT_FALSE(acpi::is_pm_timer_32bit(description));
+
+        description.Flags = 1 << 8;
+        description.X_PMTimerBlock = { ps::size1(acpi::address_space::system_io), 32, 0, 3, 0xB008 };
+        address = acpi::pm_timer_address(description);
+        ASSERT_EQ(address.address, 0xB008);
+        ASSERT_TRUE(acpi::is_pm_timer_32bit(description));
+
+        // ACPI 1.0 table: extended fields absent.
+        description.base.length = 116;
+        ASSERT_EQ(acpi::pm_timer_address(description).address, 0x608);
+
+        description.PMTimerLength = 0;
+        ASSERT_EQ(acpi::pm_timer_address(description).address, 0);
+
+        // ACPI 1.0 table: flags absent.
+        description.base.length = 112;
+        ASSERT_FALSE(acpi::is_pm_timer_32bit(description));
+
+        timer_value = 0;
+        timer_step = 1;
+        description.base.length = sizeof(description);
+        description.PMTimerLength = 4;
+        pc::pm_timer<timer_port> timer { description };
+        ASSERT_TRUE(timer.is_32bit());
+        ASSERT_EQ(timer_address, 0xB008);
+    }
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.pc;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Ports recording writes.
+
+    struct write_record { unsigned address; unsigned value; };
+
+    write_record writes [8] {};
+    unsigned     write_count {};
+    unsigned     control_value {};
+
+    template <unsigned Size>
+    class record_port
+    {
+        unsigned _address;
+
+    public:
+
+        typedef unsigned _BitInt(16) address_type;
+
+        typedef unsigned _BitInt(Size * 8) data_type;
+
+        record_port (address_type address) : _address { unsigned(address) } { }
+
+        data_type read () { return data_type(control_value); }
+
+        void write (data_type value) { writes[write_count++] = { _address, unsigned(value) }; }
+    };
+
+    TEST(sleep, sleep)
+    {
+        write_count = 0;
+        control_value = 0x0001;
+
+        pc::power_control<record_port> control { 0x404, 0x408, 0xB2, 0 };
+        ASSERT_FALSE(control.has_cstate_control());
+        control.announce_cstate_control();
+        ASSERT_EQ(write_count, 0);
+
+        control.sleep({ 5, 7 });
+        ASSERT_EQ(write_count, 4);
+        ASSERT_EQ(writes[0].address, 0x404);
+        ASSERT_EQ(writes[0].value, 0x1401);
+        ASSERT_EQ(writes[1].address, 0x408);
+        ASSERT_EQ(writes[1].value, 0x1C01);
+        ASSERT_EQ(writes[2].value, 0x3401);
+        ASSERT_EQ(writes[3].value, 0x3C01);
+    }
+
+    TEST(sleep, description)
+    {
+        write_count = 0;
+        control_value = 0;
+
+        acpi::fixed_system_description fadt {};
+        fadt.base.length = 116;
+        fadt.PM1aControlBlock = 0x604;
+        fadt.PM1ControlLength = 2;
+        fadt.SMI_CommandPort = 0xB2;
+        fadt.CStateControl = 0x85;
+
+        pc::power_control<record_port> control { fadt };
+        ASSERT_TRUE(control.has_cstate_control());
+        control.announce_cstate_control();
+        ASSERT_EQ(write_count, 1);
+        ASSERT_EQ(writes[0].address, 0xB2);
+        ASSERT_EQ(writes[0].value, 0x85);
+
+        // No PM1b: only PM1a is written.
+        control.sleep({ 5, 5 });
+        ASSERT_EQ(write_count, 3);
+        ASSERT_EQ(writes[1].address, 0x604);
+        ASSERT_EQ(writes[1].value, 0x1400);
+        ASSERT_EQ(writes[2].value, 0x3400);
+    }
+}
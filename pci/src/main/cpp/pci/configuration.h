@@ -0,0 +1,97 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.psys;
+
+namespace pci
+{
+    //! @brief Configuration space of one PCI function, accessed in aligned 32-bit units
+
+    template <typename T>
+    concept is_configuration = requires (T & x, ps::size2 offset, ps::size4 value)
+    {
+        ps::size4 { x.read(offset) };
+        x.write(offset, value);
+    };
+
+    //! @brief Configuration space register offsets
+
+    enum class configuration_register : ps::size1
+    {
+        identification = 0x00,
+        command_status = 0x04,
+        class_revision = 0x08,
+        header_type    = 0x0C,
+        bar0           = 0x10,
+        capabilities   = 0x34,
+        interrupt      = 0x3C,
+    };
+
+    //! @brief Capability identifiers
+
+    enum class capability_id : ps::size1
+    {
+        power_management = 0x01,
+        msi              = 0x05,
+        vendor           = 0x09,
+        pci_express      = 0x10,
+        msix             = 0x11,
+    };
+
+    //! @brief Read 16 bits from configuration space
+
+    template <typename Configuration>
+        requires is_configuration<Configuration>
+    auto read2 (Configuration & configuration, ps::size2 offset) -> ps::size2
+    {
+        auto const value = configuration.read(offset & ~ps::size2(3));
+        return (value >> ((offset & 2) * 8)) & 0xFFFF;
+    }
+
+    //! @brief Write 16 bits to configuration space, preserving the other half of the 32-bit unit
+    //!
+    //! Not suitable for registers with write-one-to-clear bits in the other half.
+
+    template <typename Configuration>
+        requires is_configuration<Configuration>
+    void write2 (Configuration & configuration, ps::size2 offset, ps::size2 value)
+    {
+        auto const aligned = offset & ~ps::size2(3);
+        auto const shift = (offset & 2) * 8;
+        auto const old = configuration.read(aligned);
+        configuration.write(aligned, (old & ~(ps::size4(0xFFFF) << shift)) | (ps::size4{value} << shift));
+    }
+
+    //! @brief Find capability; returns its offset, or zero if absent
+
+    template <typename Configuration>
+        requires is_configuration<Configuration>
+    auto find_capability (Configuration & configuration, capability_id id) -> ps::size1
+    {
+        auto const status = configuration.read(ps::size2(configuration_register::command_status)) >> 16;
+        if ((status & (1 << 4)) == 0) return 0;
+
+        ps::size1 offset = configuration.read(ps::size2(configuration_register::capabilities)) & 0xFC;
+        // Bounded walk: a corrupt list must not loop forever.
+        for (unsigned i = 0; i != 48 && offset != 0; ++i)
+        {
+            auto const header = configuration.read(offset);
+            if ((header & 0xFF) == ps::size4(id)) return offset;
+            offset = (header >> 8) & 0xFC;
+        }
+        return 0;
+    }
+
+    //! @brief Disable legacy INTx interrupts
+
+    template <typename Configuration>
+        requires is_configuration<Configuration>
+    void disable_intx (Configuration & configuration)
+    {
+        auto const offset = ps::size2(configuration_register::command_status);
+        // Write zero to status: its error bits are write-one-to-clear.
+        auto const command = configuration.read(offset) & 0xFFFF;
+        configuration.write(offset, command | (1 << 10));
+    }
+}
@@ -0,0 +1,215 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <pci/configuration.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace pci
+{
+    //! @brief Function address
+
+    struct function_address
+    {
+        ps::size2 segment;
+        ps::size1 bus;
+        ps::size1 device;
+        ps::size1 function;
+    };
+
+    //! @brief Configuration space of one function through legacy mechanism #1
+    //!
+    //! Each access writes the address port 0xCF8 then transfers through the data port 0xCFC,
+    //! under a lock shared by all functions. Only the first 256 bytes are reachable;
+    //! reads beyond return all ones and writes are ignored.
+
+    template <template <unsigned Width> typename Port = x86::port>
+        requires ps::is_port<Port, 4>
+    class legacy_configuration
+    {
+        static inline ps::spin_lock _lock {};
+
+        ps::size4 _address {};
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        legacy_configuration () = default;
+
+        constexpr
+        legacy_configuration (ps::size1 bus, ps::size1 device, ps::size1 function) :
+            _address { 0x80000000 | (ps::size4{bus} << 16) | (ps::size4(device & 0x1F) << 11) | (ps::size4(function & 0x07) << 8) }
+        { }
+
+        //! @}
+
+        auto read (ps::size2 offset) -> ps::size4
+        {
+            if (_address == 0 || offset >= 0x100) return 0xFFFFFFFF;
+            ps::lock_guard guard { _lock };
+            Port<4> { 0xCF8 }.write(_address | (offset & 0xFC));
+            return Port<4> { 0xCFC }.read();
+        }
+
+        void write (ps::size2 offset, ps::size4 value)
+        {
+            if (_address == 0 || offset >= 0x100) return;
+            ps::lock_guard guard { _lock };
+            Port<4> { 0xCF8 }.write(_address | (offset & 0xFC));
+            Port<4> { 0xCFC }.write(value);
+        }
+    };
+
+    //! @brief Configuration space of one function through memory mapped ECAM window
+    //!
+    //! Each access is one aligned 32-bit load or store, without locking.
+
+    class ecam_configuration
+    {
+        ps::size4 volatile * _window {};
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        ecam_configuration () = default;
+
+        //! @brief Function window at virtual address
+
+        explicit
+        ecam_configuration (ps::size address) : _window { reinterpret_cast<ps::size4 volatile *>(address) } { }
+
+        //! @}
+
+        auto read (ps::size2 offset) -> ps::size4 { return _window[(offset & 0xFFC) >> 2]; }
+
+        void write (ps::size2 offset, ps::size4 value) { _window[(offset & 0xFFC) >> 2] = value; }
+    };
+
+    //! @brief Configuration space of one function, through ECAM if available, otherwise legacy ports
+
+    template <template <unsigned Width> typename Port = x86::port>
+        requires ps::is_port<Port, 4>
+    class function_configuration
+    {
+        ecam_configuration           _ecam {};
+        legacy_configuration<Port>   _legacy {};
+        bool                         _is_ecam {};
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        function_configuration () = default;
+
+        explicit
+        function_configuration (ecam_configuration ecam) : _ecam { ecam }, _is_ecam { true } { }
+
+        explicit constexpr
+        function_configuration (legacy_configuration<Port> legacy) : _legacy { legacy } { }
+
+        //! @}
+
+        auto is_ecam () const -> bool { return _is_ecam; }
+
+        auto read (ps::size2 offset) -> ps::size4 { return _is_ecam ? _ecam.read(offset) : _legacy.read(offset); }
+
+        void write (ps::size2 offset, ps::size4 value)
+        {
+            if (_is_ecam) _ecam.write(offset, value);
+            else _legacy.write(offset, value);
+        }
+    };
+
+    //! @brief Configuration space access method for all segments
+    //!
+    //! Regions from the ACPI MCFG are accessed at physical address plus mapping offset;
+    //! buses outside every region fall back to legacy ports, which reach segment zero only.
+
+    template <template <unsigned Width> typename Port = x86::port, unsigned Segments = 8>
+        requires ps::is_port<Port, 4>
+    class configuration_space
+    {
+        acpi::pci_segment _segments [Segments] {};
+        unsigned          _count {};
+        ps::size          _mapping {};
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        explicit constexpr
+        configuration_space (ps::size mapping = 0) : _mapping { mapping } { }
+
+        //! @}
+
+        //! @brief Configuration
+        //! @{
+
+        //! @brief Add ECAM region; returns false if full
+
+        auto add (acpi::pci_segment const & segment) -> bool
+        {
+            if (_count == Segments) return false;
+            _segments[_count++] = segment;
+            return true;
+        }
+
+        //! @brief Add ECAM regions described by MCFG; returns number added
+
+        auto add (acpi::pci_configuration_description const & description) -> unsigned
+        {
+            acpi::pci_segment segments [Segments];
+            auto const found = acpi::pci_segments(description, segments, Segments);
+            unsigned added = 0;
+            for (unsigned i = 0; i != found && i != Segments; ++i)
+                if (add(segments[i])) ++added;
+            return added;
+        }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto count () const -> unsigned { return _count; }
+
+        auto segment (unsigned index) const -> acpi::pci_segment const & { return _segments[index]; }
+
+        //! @brief ECAM region containing bus, or null
+
+        auto region (ps::size2 segment, ps::size1 bus) const -> acpi::pci_segment const *
+        {
+            for (unsigned i = 0; i != _count; ++i) {
+                auto const & x = _segments[i];
+                if (x.segment == segment && bus >= x.start_bus && bus <= x.end_bus) return & x;
+            }
+            return nullptr;
+        }
+
+        //! @}
+
+        //! @brief Configuration space of function
+
+        auto function (function_address address) const -> function_configuration<Port>
+        {
+            if (auto const x = region(address.segment, address.bus)) {
+                auto const offset = (ps::size8{address.bus} << 20) | (ps::size8(address.device & 0x1F) << 15) | (ps::size8(address.function & 0x07) << 12);
+                return function_configuration<Port> { ecam_configuration { ps::size(x->address + offset) + _mapping } };
+            }
+            if (address.segment != 0) return {};
+            return function_configuration<Port> { legacy_configuration<Port> { address.bus, address.device, address.function } };
+        }
+    };
+}
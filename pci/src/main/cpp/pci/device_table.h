@@ -0,0 +1,312 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <pci/configuration.h>
+#include <pci/configuration_space.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+namespace pci
+{
+    //! @brief Base address register
+
+    struct bar
+    {
+        ps::size8 address;
+        ps::size8 size;
+        bool      io;
+        bool      wide;
+        bool      prefetchable;
+    };
+
+    //! @brief PCI function found by enumeration
+
+    struct device
+    {
+        function_address address;
+        ps::size2        vendor_id;
+        ps::size2        device_id;
+        ps::size1        class_code;
+        ps::size1        subclass;
+        ps::size1        interface;
+        ps::size1        revision;
+        ps::size1        header_type;
+        ps::size1        interrupt_pin;
+        ps::size1        interrupt_line;
+        ps::size1        secondary_bus;
+        ps::size1        subordinate_bus;
+        ps::size1        msi;
+        ps::size1        msix;
+        ps::size1        express;
+        bar              bars [6];
+    };
+
+    //! @brief Read and size count base address registers, disabling decoding meanwhile
+    //!
+    //! A 64-bit register fills one entry and leaves the next empty.
+
+    template <typename Configuration>
+        requires is_configuration<Configuration>
+    void size_bars (Configuration & configuration, unsigned count, bar * bars)
+    {
+        auto const command_offset = ps::size2(configuration_register::command_status);
+        auto const command = configuration.read(command_offset) & 0xFFFF;
+        configuration.write(command_offset, command & ~ps::size4(0x3));
+
+        for (unsigned i = 0; i < count; ++i)
+        {
+            auto const offset = ps::size2(ps::size2(configuration_register::bar0) + i * 4);
+            auto const original = configuration.read(offset);
+            configuration.write(offset, 0xFFFFFFFF);
+            auto const probe = configuration.read(offset);
+            configuration.write(offset, original);
+
+            auto & x = bars[i];
+            x = {};
+            if ((original & 1) != 0) {
+                x.io = true;
+                x.address = original & ~ps::size4(0x3);
+                auto const mask = probe & ~ps::size4(0x3) & 0xFFFF;
+                x.size = mask == 0 ? 0 : (~mask & 0xFFFF) + 1;
+                continue;
+            }
+
+            x.prefetchable = (original & 0x8) != 0;
+            x.wide = ((original >> 1) & 0x3) == 0x2 && i + 1 < count;
+            ps::size8 address = original & ~ps::size4(0xF);
+            ps::size8 mask = probe & ~ps::size4(0xF);
+            if (x.wide) {
+                auto const high_offset = ps::size2(offset + 4);
+                auto const high = configuration.read(high_offset);
+                configuration.write(high_offset, 0xFFFFFFFF);
+                auto const high_probe = configuration.read(high_offset);
+                configuration.write(high_offset, high);
+                address |= ps::size8{high} << 32;
+                mask |= ps::size8{high_probe} << 32;
+                bars[++i] = {};
+            }
+            else if (mask != 0) mask |= 0xFFFFFFFF00000000;
+            x.address = address;
+            x.size = mask == 0 ? 0 : ~mask + 1;
+        }
+
+        configuration.write(command_offset, command);
+    }
+
+    //! @brief Immutable table of PCI functions, built by parallel enumeration
+    //!
+    //! Workers scan disjoint shares of all buses, brute force, reserving entries atomically;
+    //! sealing waits for every worker, then sorts entries by address.
+    //! After sealing the table is read only and may be shared for the rest of the boot.
+
+    template <unsigned Capacity = 256>
+    class device_table
+    {
+        device   _devices [Capacity] {};
+        unsigned _reserved {};
+        unsigned _dropped {};
+        unsigned _finished {};
+        unsigned _count {};
+        bool     _sealed {};
+
+        static constexpr
+        auto key (function_address x) -> ps::size4
+        {
+            return (ps::size4{x.segment} << 16) | (ps::size4{x.bus} << 8) | (ps::size4(x.device & 0x1F) << 3) | (x.function & 0x07);
+        }
+
+        template <typename Space>
+        void probe (Space & space, function_address address, ps::size4 identification)
+        {
+            auto configuration = space.function(address);
+            auto const index = __atomic_fetch_add(& _reserved, 1u, __ATOMIC_RELAXED);
+            if (index >= Capacity) {
+                __atomic_fetch_add(& _dropped, 1u, __ATOMIC_RELAXED);
+                return;
+            }
+
+            auto & x = _devices[index];
+            x.address = address;
+            x.vendor_id = identification & 0xFFFF;
+            x.device_id = identification >> 16;
+
+            auto const class_revision = configuration.read(ps::size2(configuration_register::class_revision));
+            x.class_code = class_revision >> 24;
+            x.subclass = class_revision >> 16;
+            x.interface = class_revision >> 8;
+            x.revision = class_revision;
+
+            x.header_type = (configuration.read(ps::size2(configuration_register::header_type)) >> 16) & 0x7F;
+
+            unsigned bars = 0;
+            if (x.header_type == 0) {
+                bars = 6;
+                auto const interrupt = configuration.read(ps::size2(configuration_register::interrupt));
+                x.interrupt_line = interrupt;
+                x.interrupt_pin = interrupt >> 8;
+            }
+            else if (x.header_type == 1) {
+                bars = 2;
+                auto const buses = configuration.read(0x18);
+                x.secondary_bus = buses >> 8;
+                x.subordinate_bus = buses >> 16;
+            }
+            if (bars != 0) size_bars(configuration, bars, x.bars);
+
+            x.msi = find_capability(configuration, capability_id::msi);
+            x.msix = find_capability(configuration, capability_id::msix);
+            x.express = find_capability(configuration, capability_id::pci_express);
+        }
+
+        template <typename Space>
+        void scan_bus (Space & space, ps::size2 segment, ps::size1 bus)
+        {
+            auto const identification = ps::size2(configuration_register::identification);
+            for (ps::size1 slot = 0; slot != 32; ++slot)
+            {
+                auto first = space.function({ segment, bus, slot, 0 });
+                auto const id = first.read(identification);
+                if ((id & 0xFFFF) == 0xFFFF) continue;
+                probe(space, { segment, bus, slot, 0 }, id);
+
+                auto const multifunction = (first.read(ps::size2(configuration_register::header_type)) & 0x00800000) != 0;
+                if (! multifunction) continue;
+                for (ps::size1 function = 1; function != 8; ++function)
+                {
+                    auto const other = space.function({ segment, bus, slot, function }).read(identification);
+                    if ((other & 0xFFFF) == 0xFFFF) continue;
+                    probe(space, { segment, bus, slot, function }, other);
+                }
+            }
+        }
+
+    public:
+
+        static constexpr unsigned capacity = Capacity;
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        device_table () = default;
+
+        device_table (device_table const &) = delete;
+
+        //! @}
+
+        //! @brief Enumeration
+        //! @{
+
+        //! @brief Scan share of worker among workers
+        //!
+        //! Buses of all ECAM regions, or of legacy segment zero if none, are split in contiguous shares.
+
+        template <typename Space>
+        void scan (Space & space, unsigned worker, unsigned workers)
+        {
+            unsigned total = 0;
+            for (unsigned i = 0; i != space.count(); ++i)
+                total += unsigned(space.segment(i).end_bus) - unsigned(space.segment(i).start_bus) + 1;
+            auto const legacy = space.count() == 0;
+            if (legacy) total = 256;
+
+            auto const first = unsigned((ps::size8(total) * worker) / workers);
+            auto const last = unsigned((ps::size8(total) * (worker + 1)) / workers);
+
+            unsigned base = 0;
+            for (unsigned i = 0; i != (legacy ? 1 : space.count()); ++i)
+            {
+                ps::size2 segment = 0;
+                unsigned start = 0, end = 255;
+                if (! legacy) {
+                    segment = space.segment(i).segment;
+                    start = space.segment(i).start_bus;
+                    end = space.segment(i).end_bus;
+                }
+                for (unsigned bus = start; bus <= end; ++bus, ++base)
+                    if (base >= first && base < last) scan_bus(space, segment, ps::size1(bus));
+            }
+
+            __atomic_fetch_add(& _finished, 1u, __ATOMIC_RELEASE);
+        }
+
+        //! @brief Wait for workers, then sort entries; idempotent
+
+        void seal (unsigned workers)
+        {
+            if (_sealed) return;
+            while (__atomic_load_n(& _finished, __ATOMIC_ACQUIRE) < workers)
+                __builtin_ia32_pause();
+
+            _count = _reserved < Capacity ? _reserved : Capacity;
+            for (unsigned i = 1; i < _count; ++i)
+            {
+                auto const x = _devices[i];
+                auto j = i;
+                for (; j != 0 && key(_devices[j - 1].address) > key(x.address); --j)
+                    _devices[j] = _devices[j - 1];
+                _devices[j] = x;
+            }
+            __atomic_store_n(& _sealed, true, __ATOMIC_RELEASE);
+        }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto is_sealed () const -> bool { return __atomic_load_n(& _sealed, __ATOMIC_ACQUIRE); }
+
+        auto size () const -> unsigned { return _count; }
+
+        //! @brief Number of functions found beyond capacity
+
+        auto dropped () const -> unsigned { return _dropped; }
+
+        auto begin () const -> device const * { return _devices; }
+
+        auto end () const -> device const * { return _devices + _count; }
+
+        //! @}
+
+        //! @brief Lookup
+        //! @{
+
+        //! @brief Function at address, or null
+
+        auto find (function_address address) const -> device const *
+        {
+            auto const k = key(address);
+            unsigned low = 0, high = _count;
+            while (low < high) {
+                auto const middle = (low + high) / 2;
+                auto const other = key(_devices[middle].address);
+                if (other == k) return _devices + middle;
+                if (other < k) low = middle + 1;
+                else high = middle;
+            }
+            return nullptr;
+        }
+
+        //! @brief Next function with vendor and device identifiers after previous, or null
+
+        auto find (ps::size2 vendor_id, ps::size2 device_id, device const * previous = nullptr) const -> device const *
+        {
+            for (auto i = previous == nullptr ? begin() : previous + 1; i < end(); ++i)
+                if (i->vendor_id == vendor_id && i->device_id == device_id) return i;
+            return nullptr;
+        }
+
+        //! @brief Next function with class and subclass after previous, or null
+
+        auto find_class (ps::size1 class_code, ps::size1 subclass, device const * previous = nullptr) const -> device const *
+        {
+            for (auto i = previous == nullptr ? begin() : previous + 1; i < end(); ++i)
+                if (i->class_code == class_code && i->subclass == subclass) return i;
+            return nullptr;
+        }
+
+        //! @}
+    };
+}
@@ -0,0 +1,295 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <pci/configuration.h>
+
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace pci
+{
+    //! @brief Message signaled interrupt message
+
+    struct msi_message
+    {
+        ps::size8 address;
+        ps::size4 data;
+    };
+
+    //! @brief Message for fixed, edge triggered delivery of vector to processor with APIC id
+
+    constexpr
+    auto make_msi_message (ps::size1 apic_id, ps::size1 vector) -> msi_message
+    {
+        return { 0xFEE00000 | (ps::size8{apic_id} << 12), ps::size4{vector} };
+    }
+
+    //! @brief MSI capability
+    //!
+    //! Multiple messages share address and destination and differ in the low bits of data,
+    //! therefore require a block of vectors, aligned to its size, on one processor.
+
+    template <typename Configuration>
+        requires is_configuration<Configuration>
+    class msi
+    {
+        Configuration & _configuration;
+        ps::size1       _offset;
+
+        auto control () -> ps::size2 { return read2(_configuration, _offset + 2); }
+
+        void control (ps::size2 value) { write2(_configuration, _offset + 2, value); }
+
+        auto mask_offset () -> ps::size2 { return _offset + (is_64bit() ? 0x10 : 0x0C); }
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        msi (Configuration & configuration, ps::size1 offset) : _configuration { configuration }, _offset { offset } { }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto offset () const -> ps::size1 { return _offset; }
+
+        auto is_64bit () -> bool { return (control() & (1 << 7)) != 0; }
+
+        auto is_maskable () -> bool { return (control() & (1 << 8)) != 0; }
+
+        auto is_enabled () -> bool { return (control() & 1) != 0; }
+
+        //! @brief Number of messages the function is capable of
+
+        auto capacity () -> unsigned { return 1u << ((control() >> 1) & 7); }
+
+        //! @brief Number of messages enabled
+
+        auto count () -> unsigned { return 1u << ((control() >> 4) & 7); }
+
+        //! @}
+
+        //! @brief Operations
+        //! @{
+
+        //! @brief Program message and enable count messages; count must be a power of two
+        //!
+        //! Message data must be aligned to count; returns false if count exceeds capacity.
+
+        auto enable (msi_message message, unsigned count = 1) -> bool
+        {
+            if (count == 0 || (count & (count - 1)) != 0 || count > capacity()) return false;
+            if ((message.data & (count - 1)) != 0) return false;
+
+            auto value = control() & ~ps::size2(0x71);
+            control(value);
+
+            _configuration.write(_offset + 4, message.address & 0xFFFFFFFC);
+            if (is_64bit()) {
+                _configuration.write(_offset + 8, message.address >> 32);
+                _configuration.write(_offset + 12, message.data & 0xFFFF);
+            }
+            else {
+                _configuration.write(_offset + 8, message.data & 0xFFFF);
+            }
+
+            value |= (__builtin_ctz(count) & 7) << 4;
+            control(value | 1);
+            return true;
+        }
+
+        void disable ()
+        {
+            control(control() & ~ps::size2(1));
+        }
+
+        //! @brief Mask message with index; no effect unless maskable
+
+        void mask (unsigned index)
+        {
+            if (! is_maskable()) return;
+            _configuration.write(mask_offset(), _configuration.read(mask_offset()) | (ps::size4(1) << index));
+        }
+
+        //! @brief Unmask message with index; no effect unless maskable
+
+        void unmask (unsigned index)
+        {
+            if (! is_maskable()) return;
+            _configuration.write(mask_offset(), _configuration.read(mask_offset()) & ~(ps::size4(1) << index));
+        }
+
+        //! @}
+    };
+
+    //! @brief MSI-X table entry
+
+    struct msix_entry
+    {
+        ps::size4 volatile address_low;
+        ps::size4 volatile address_high;
+        ps::size4 volatile data;
+        ps::size4 volatile control;
+    };
+
+    //! @brief MSI-X table, mapped from device memory
+    //!
+    //! Each entry has its own address and data, therefore its own processor and vector.
+
+    class msix_table
+    {
+        msix_entry * _entries {};
+        unsigned     _size {};
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        constexpr
+        msix_table () = default;
+
+        msix_table (void * address, unsigned size) : _entries { static_cast<msix_entry *>(address) }, _size { size } { }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto size () const -> unsigned { return _size; }
+
+        auto is_masked (unsigned index) const -> bool { return (_entries[index].control & 1) != 0; }
+
+        //! @}
+
+        //! @brief Operations
+        //! @{
+
+        //! @brief Program entry; entry is masked while inconsistent and remains masked
+
+        void set (unsigned index, msi_message message)
+        {
+            auto & entry = _entries[index];
+            entry.control = entry.control | 1;
+            entry.address_low = message.address & 0xFFFFFFFC;
+            entry.address_high = message.address >> 32;
+            entry.data = message.data;
+        }
+
+        void mask (unsigned index)
+        {
+            _entries[index].control = _entries[index].control | 1;
+        }
+
+        void unmask (unsigned index)
+        {
+            _entries[index].control = _entries[index].control & ~ps::size4(1);
+        }
+
+        //! @}
+    };
+
+    //! @brief MSI-X capability
+
+    template <typename Configuration>
+        requires is_configuration<Configuration>
+    class msix
+    {
+        Configuration & _configuration;
+        ps::size1       _offset;
+
+        auto control () -> ps::size2 { return read2(_configuration, _offset + 2); }
+
+        void control (ps::size2 value) { write2(_configuration, _offset + 2, value); }
+
+    public:
+
+        //! @brief Object
+        //! @{
+
+        msix (Configuration & configuration, ps::size1 offset) : _configuration { configuration }, _offset { offset } { }
+
+        //! @}
+
+        //! @brief Properties
+        //! @{
+
+        auto offset () const -> ps::size1 { return _offset; }
+
+        auto is_enabled () -> bool { return (control() & (1 << 15)) != 0; }
+
+        auto is_function_masked () -> bool { return (control() & (1 << 14)) != 0; }
+
+        //! @brief Number of table entries
+
+        auto size () -> unsigned { return (control() & 0x7FF) + 1; }
+
+        //! @brief Base address register index holding the table
+
+        auto table_bar () -> unsigned { return _configuration.read(_offset + 4) & 7; }
+
+        //! @brief Table offset from base address
+
+        auto table_offset () -> ps::size4 { return _configuration.read(_offset + 4) & ~ps::size4(7); }
+
+        //! @brief Base address register index holding the pending bit array
+
+        auto pending_bar () -> unsigned { return _configuration.read(_offset + 8) & 7; }
+
+        //! @brief Pending bit array offset from base address
+
+        auto pending_offset () -> ps::size4 { return _configuration.read(_offset + 8) & ~ps::size4(7); }
+
+        //! @}
+
+        //! @brief Operations
+        //! @{
+
+        //! @brief Enable MSI-X with all vectors masked at function level, for table programming
+
+        void enable_masked ()
+        {
+            control(control() | (1 << 15) | (1 << 14));
+        }
+
+        //! @brief Enable MSI-X; entries follow their own mask
+
+        void enable ()
+        {
+            control((control() | (1 << 15)) & ~ps::size2(1 << 14));
+        }
+
+        void disable ()
+        {
+            control(control() & ~ps::size2(1 << 15));
+        }
+
+        //! @}
+    };
+
+    //! @brief Allocate one vector per queue over affinity set and program MSI-X entries [0, count)
+    //!
+    //! Topology maps processor index to APIC id, like x86::ipi_controller.
+    //! Entries remain masked; returns number of queues programmed.
+
+    template <typename Topology>
+    auto assign_queues (
+        msix_table & table,
+        x86::vector_allocator & vectors,
+        Topology const & topology,
+        x86::cpu_set affinity,
+        x86::interrupt_vector * queues,
+        unsigned count
+    ) -> unsigned
+    {
+        if (count > table.size()) count = table.size();
+        auto const allocated = vectors.spread(affinity, queues, count);
+        for (unsigned i = 0; i != allocated; ++i)
+            table.set(i, make_msi_message(topology.apic_id(queues[i].cpu), queues[i].vector));
+        return allocated;
+    }
+}
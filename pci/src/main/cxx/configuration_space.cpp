@@ -0,0 +1,7 @@
+#include <pci/configuration_space.h>
+
+static_assert(pci::is_configuration<pci::ecam_configuration>);
+
+static_assert(pci::is_configuration<pci::legacy_configuration<>>);
+
+static_assert(pci::is_configuration<pci::function_configuration<>>);
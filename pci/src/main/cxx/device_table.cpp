@@ -0,0 +1 @@
+#include <pci/device_table.h>
@@ -0,0 +1 @@
+#include <pci/msi.h>
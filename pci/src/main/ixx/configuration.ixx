@@ -0,0 +1,18 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pci/configuration.h>
+
+export module br.dev.pedrolamarao.metal.pci:configuration;
+
+export namespace pci
+{
+    using ::pci::is_configuration;
+    using ::pci::configuration_register;
+    using ::pci::capability_id;
+    using ::pci::read2;
+    using ::pci::write2;
+    using ::pci::find_capability;
+    using ::pci::disable_intx;
+}
@@ -0,0 +1,16 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pci/configuration_space.h>
+
+export module br.dev.pedrolamarao.metal.pci:configuration_space;
+
+export namespace pci
+{
+    using ::pci::function_address;
+    using ::pci::legacy_configuration;
+    using ::pci::ecam_configuration;
+    using ::pci::function_configuration;
+    using ::pci::configuration_space;
+}
@@ -0,0 +1,15 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pci/device_table.h>
+
+export module br.dev.pedrolamarao.metal.pci:device_table;
+
+export namespace pci
+{
+    using ::pci::bar;
+    using ::pci::device;
+    using ::pci::size_bars;
+    using ::pci::device_table;
+}
@@ -0,0 +1,18 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <pci/msi.h>
+
+export module br.dev.pedrolamarao.metal.pci:msi;
+
+export namespace pci
+{
+    using ::pci::msi_message;
+    using ::pci::make_msi_message;
+    using ::pci::msi;
+    using ::pci::msix_entry;
+    using ::pci::msix_table;
+    using ::pci::msix;
+    using ::pci::assign_queues;
+}
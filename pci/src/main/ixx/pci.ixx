@@ -0,0 +1,8 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+export module br.dev.pedrolamarao.metal.pci;
+
+export import :configuration;
+export import :configuration_space;
+export import :device_table;
+export import :msi;
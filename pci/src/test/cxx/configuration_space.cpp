@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.pci;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Legacy mechanism simulated by ports: bus 0, device 3, function 1 is present.
+
+    unsigned selected {};
+    unsigned accesses {};
+    ps::size4 legacy_space [64] {};
+
+    template <unsigned Size>
+    class port
+    {
+        unsigned _address;
+
+    public:
+
+        typedef unsigned _BitInt(16) address_type;
+
+        typedef unsigned _BitInt(Size * 8) data_type;
+
+        port (address_type address) : _address { unsigned(address) } { }
+
+        auto present () const -> bool { return (selected & 0xFFFFFF00) == (0x80000000 | (3 << 11) | (1 << 8)); }
+
+        data_type read ()
+        {
+            ++accesses;
+            if (_address == 0xCF8) return data_type(selected);
+            return present() ? data_type(legacy_space[(selected & 0xFC) / 4]) : data_type(0xFFFFFFFF);
+        }
+
+        void write (data_type value)
+        {
+            ++accesses;
+            if (_address == 0xCF8) selected = unsigned(value);
+            else if (present()) legacy_space[(selected & 0xFC) / 4] = ps::size4(value);
+        }
+    };
+
+    TEST(configuration_space, legacy)
+    {
+        legacy_space[0] = 0x12348086;
+
+        pci::configuration_space<port> space;
+        auto function = space.function({ 0, 0, 3, 1 });
+        ASSERT_FALSE(function.is_ecam());
+
+        accesses = 0;
+        ASSERT_EQ(function.read(0x00), 0x12348086);
+        ASSERT_EQ(accesses, 2);
+        ASSERT_EQ(pci::read2(function, 0x02), 0x1234);
+
+        function.write(0x3C, 0x010B);
+        ASSERT_EQ(legacy_space[0x3C / 4], 0x010B);
+
+        // Extended configuration space is not reachable.
+        ASSERT_EQ(function.read(0x100), 0xFFFFFFFF);
+
+        ASSERT_EQ(space.function({ 0, 0, 4, 0 }).read(0x00), 0xFFFFFFFF);
+        ASSERT_EQ(space.function({ 1, 0, 3, 1 }).read(0x00), 0xFFFFFFFF);
+    }
+
+    alignas(4096) ps::size4 ecam [4][32][8][1024] {};
+
+    TEST(configuration_space, ecam)
+    {
+        // MCFG with one region for segment 0, buses 1 to 3; address is that of bus 0.
+        struct [[gnu::packed]]
+        {
+            acpi::pci_configuration_description header;
+            acpi::pci_segment_description segments [2];
+        }
+        mcfg {};
+        mcfg.header.base.length = sizeof(mcfg);
+        mcfg.segments[0] = { 0xE0000000, 0, 1, 3, 0 };
+        mcfg.segments[1] = { 0xF0000000, 1, 5, 4, 0 };
+
+        acpi::pci_segment segments [2];
+        ASSERT_EQ(acpi::pci_segments(mcfg.header, segments, 2), 1);
+        ASSERT_EQ(segments[0].address, 0xE0000000);
+        ASSERT_EQ(segments[0].end_bus, 3);
+
+        auto const mapping = reinterpret_cast<ps::size>(ecam) - 0xE0000000;
+        pci::configuration_space<port> space { mapping };
+        ASSERT_EQ(space.add(mcfg.header), 1);
+        ASSERT_EQ(space.count(), 1);
+        ASSERT_NE(space.region(0, 2), nullptr);
+        ASSERT_EQ(space.region(0, 0), nullptr);
+        ASSERT_EQ(space.region(1, 2), nullptr);
+
+        ecam[2][5][1][0] = 0x56781AF4;
+        ecam[2][5][1][0x104 / 4] = 0x00010001;
+
+        accesses = 0;
+        auto function = space.function({ 0, 2, 5, 1 });
+        ASSERT_TRUE(function.is_ecam());
+        ASSERT_EQ(function.read(0x00), 0x56781AF4);
+        ASSERT_EQ(function.read(0x104), 0x00010001);
+        function.write(0x10, 0xFEB00000);
+        ASSERT_EQ(ecam[2][5][1][4], 0xFEB00000);
+        ASSERT_EQ(accesses, 0);
+
+        // Bus 0 is outside the region: legacy ports.
+        ASSERT_FALSE(space.function({ 0, 0, 3, 1 }).is_ecam());
+    }
+}
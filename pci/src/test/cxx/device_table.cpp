@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+import br.dev.pedrolamarao.metal.acpi;
+import br.dev.pedrolamarao.metal.pci;
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Functions simulated by memory; base address registers answer sizing probes.
+
+    struct function
+    {
+        ps::size4 data [64];
+        ps::size4 masks [6];
+    };
+
+    struct configuration
+    {
+        function * x;
+
+        auto read (ps::size2 offset) -> ps::size4 { return x == nullptr ? 0xFFFFFFFF : x->data[offset / 4]; }
+
+        void write (ps::size2 offset, ps::size4 value)
+        {
+            if (x == nullptr) return;
+            auto const i = offset / 4;
+            if (i == 1) {
+                // Status bits are read only or write-one-to-clear.
+                x->data[i] = (x->data[i] & 0xFFFF0000) | (value & 0xFFFF);
+            }
+            else if (i >= 4 && i < 10) {
+                // Unimplemented registers read as zero.
+                auto const flags = x->data[i] & ~x->masks[i - 4];
+                x->data[i] = (value & x->masks[i - 4]) | flags;
+            }
+            else x->data[i] = value;
+        }
+    };
+
+    // Segment 0 buses 0 to 3, segment 1 bus 0.
+
+    struct space
+    {
+        function functions [2][4][32][8] {};
+
+        auto count () const -> unsigned { return 2; }
+
+        auto segment (unsigned i) const -> acpi::pci_segment
+        {
+            return i == 0 ? acpi::pci_segment { 0xE0000000, 0, 0, 3 } : acpi::pci_segment { 0xF0000000, 1, 0, 0 };
+        }
+
+        auto function (pci::function_address a) -> configuration
+        {
+            auto & x = functions[unsigned(a.segment)][unsigned(a.bus)][unsigned(a.device)][unsigned(a.function)];
+            return { x.data[0] == 0 ? nullptr : & x };
+        }
+
+        auto add (unsigned segment, unsigned bus, unsigned device, unsigned function, ps::size4 id, ps::size4 class_revision) -> ::function &
+        {
+            auto & x = functions[segment][bus][device][function];
+            x.data[0] = id;
+            x.data[2] = class_revision;
+            return x;
+        }
+    };
+
+    auto make_space () -> space &
+    {
+        static space s;
+        s = {};
+
+        // Host bridge: no base address registers.
+        s.add(0, 0, 0, 0, 0x29C08086, 0x06000002);
+
+        // Network controller: 64-bit prefetchable 16 KiB memory, 32 byte I/O, MSI-X capability.
+        auto & nic = s.add(0, 1, 2, 0, 0x10D38086, 0x02000000);
+        nic.data[1] = 0x00100007;
+        nic.data[4] = 0xFEBC000C;
+        nic.data[5] = 0x00000001;
+        nic.masks[0] = 0xFFFFC000;
+        nic.masks[1] = 0xFFFFFFFF;
+        nic.data[6] = 0x0000C001;
+        nic.masks[2] = 0xFFFFFFE0;
+        nic.data[13] = 0x40;
+        nic.data[16] = 0x00000011;
+        nic.data[15] = 0x0000010B;
+
+        // Multifunction storage device, functions 0 and 3.
+        auto & sata = s.add(0, 3, 31, 0, 0x29228086, 0x01060102);
+        sata.data[3] = 0x00800000;
+        sata.data[9] = 0xFEBD1000;
+        sata.masks[5] = 0xFFFFF000;
+        s.add(0, 3, 31, 3, 0x29308086, 0x0C050002);
+
+        // Bridge on segment 1 to buses 1 to 4.
+        auto & bridge = s.add(1, 0, 1, 0, 0x1234ABCD, 0x06040000);
+        bridge.data[3] = 0x00010000;
+        bridge.data[6] = 0x00040100;
+
+        return s;
+    }
+
+    TEST(device_table, size_bars)
+    {
+        auto & s = make_space();
+        pci::bar bars [6];
+        auto configuration = s.function({ 0, 1, 2, 0 });
+        pci::size_bars(configuration, 6, bars);
+
+        ASSERT_EQ(bars[0].address, 0x1FEBC0000);
+        ASSERT_EQ(bars[0].size, 0x4000);
+        ASSERT_TRUE(bars[0].wide);
+        ASSERT_TRUE(bars[0].prefetchable);
+        ASSERT_EQ(bars[1].size, 0);
+        ASSERT_TRUE(bars[2].io);
+        ASSERT_EQ(bars[2].address, 0xC000);
+        ASSERT_EQ(bars[2].size, 0x20);
+        ASSERT_EQ(bars[3].size, 0);
+
+        // Registers and command restored.
+        ASSERT_EQ(configuration.read(0x10), 0xFEBC000C);
+        ASSERT_EQ(configuration.read(0x18), 0x0000C001);
+        ASSERT_EQ(configuration.read(0x04), 0x00100007);
+    }
+
+    TEST(device_table, scan)
+    {
+        auto & s = make_space();
+        static pci::device_table<> table;
+        for (unsigned worker = 0; worker != 3; ++worker) table.scan(s, worker, 3);
+        table.seal(3);
+
+        ASSERT_TRUE(table.is_sealed());
+        ASSERT_EQ(table.size(), 5);
+        ASSERT_EQ(table.dropped(), 0);
+
+        // Sorted by address.
+        ASSERT_EQ(table.begin()[0].address.bus, 0);
+        ASSERT_EQ(table.begin()[4].address.segment, 1);
+
+        auto const nic = table.find(0x8086, 0x10D3);
+        ASSERT_NE(nic, nullptr);
+        ASSERT_EQ(nic, table.find({ 0, 1, 2, 0 }));
+        ASSERT_EQ(nic->class_code, 0x02);
+        ASSERT_EQ(nic->msix, 0x40);
+        ASSERT_EQ(nic->msi, 0);
+        ASSERT_EQ(nic->interrupt_line, 0x0B);
+        ASSERT_EQ(nic->interrupt_pin, 0x01);
+        ASSERT_EQ(nic->bars[0].size, 0x4000);
+
+        auto const sata = table.find_class(0x01, 0x06);
+        ASSERT_NE(sata, nullptr);
+        ASSERT_EQ(sata->interface, 0x01);
+        ASSERT_EQ(sata->bars[5].address, 0xFEBD1000);
+        ASSERT_EQ(sata->bars[5].size, 0x1000);
+        ASSERT_NE(table.find({ 0, 3, 31, 3 }), nullptr);
+        ASSERT_EQ(table.find({ 0, 3, 31, 1 }), nullptr);
+
+        auto const bridge = table.find_class(0x06, 0x04);
+        ASSERT_NE(bridge, nullptr);
+        ASSERT_EQ(bridge->header_type, 1);
+        ASSERT_EQ(bridge->secondary_bus, 1);
+        ASSERT_EQ(bridge->subordinate_bus, 4);
+
+        auto const host = table.find_class(0x06, 0x00);
+        ASSERT_NE(host, nullptr);
+        ASSERT_EQ(table.find_class(0x06, 0x00, host), nullptr);
+    }
+
+    TEST(device_table, parallel)
+    {
+        auto & s = make_space();
+        static pci::device_table<4> table;
+        std::thread workers [4];
+        for (unsigned i = 0; i != 4; ++i) workers[i] = std::thread { [&, i] { table.scan(s, i, 4); } };
+        table.seal(4);
+        for (auto & worker : workers) worker.join();
+
+        // Capacity is 4: one function dropped.
+        ASSERT_EQ(table.size(), 4);
+        ASSERT_EQ(table.dropped(), 1);
+        auto key = [] (pci::device const & x) {
+            return (unsigned(x.address.segment) << 16) | (unsigned(x.address.bus) << 8) | (unsigned(x.address.device) << 3) | unsigned(x.address.function);
+        };
+        for (unsigned i = 1; i != table.size(); ++i)
+            ASSERT_LT(key(table.begin()[i - 1]), key(table.begin()[i]));
+    }
+}
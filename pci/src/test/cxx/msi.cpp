@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.pci;
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace
+{
+    // Configuration space simulated by memory.
+
+    struct configuration
+    {
+        ps::size4 data [64] {};
+
+        auto read (ps::size2 offset) -> ps::size4 { return data[offset / 4]; }
+
+        void write (ps::size2 offset, ps::size4 value) { data[offset / 4] = value; }
+    };
+
+    // MSI at 0x50, 64-bit, maskable, 8 messages; MSI-X at 0x70, 16 entries in BAR 2 at 0x2000.
+
+    auto make_configuration () -> configuration
+    {
+        configuration result {};
+        result.data[0x04 / 4] = 0x00100000;
+        result.data[0x34 / 4] = 0x50;
+        result.data[0x50 / 4] = (0x0186 << 16) | (0x70 << 8) | 0x05;
+        result.data[0x70 / 4] = (0x000F << 16) | (0x00 << 8) | 0x11;
+        result.data[0x74 / 4] = 0x2002;
+        result.data[0x78 / 4] = 0x3002;
+        return result;
+    }
+
+    struct topology
+    {
+        auto apic_id (unsigned index) const -> ps::size1 { return index * 2; }
+    };
+
+    TEST(pci, find_capability)
+    {
+        auto space = make_configuration();
+        ASSERT_EQ(pci::find_capability(space, pci::capability_id::msi), 0x50);
+        ASSERT_EQ(pci::find_capability(space, pci::capability_id::msix), 0x70);
+        ASSERT_EQ(pci::find_capability(space, pci::capability_id::pci_express), 0);
+        space.data[0x04 / 4] = 0;
+        ASSERT_EQ(pci::find_capability(space, pci::capability_id::msi), 0);
+    }
+
+    TEST(msi, enable)
+    {
+        auto space = make_configuration();
+        pci::msi<configuration> msi { space, 0x50 };
+        ASSERT_TRUE(msi.is_64bit());
+        ASSERT_TRUE(msi.is_maskable());
+        ASSERT_EQ(msi.capacity(), 8);
+
+        ASSERT_FALSE(msi.enable(pci::make_msi_message(1, 0x42), 4));
+        ASSERT_TRUE(msi.enable(pci::make_msi_message(1, 0x44), 4));
+        ASSERT_TRUE(msi.is_enabled());
+        ASSERT_EQ(msi.count(), 4);
+        ASSERT_EQ(space.data[0x54 / 4], 0xFEE01000);
+        ASSERT_EQ(space.data[0x58 / 4], 0);
+        ASSERT_EQ(space.data[0x5C / 4], 0x44);
+
+        msi.mask(2);
+        ASSERT_EQ(space.data[0x60 / 4], 4);
+        msi.unmask(2);
+        ASSERT_EQ(space.data[0x60 / 4], 0);
+
+        msi.disable();
+        ASSERT_FALSE(msi.is_enabled());
+    }
+
+    TEST(msix, queues)
+    {
+        auto space = make_configuration();
+        pci::msix<configuration> msix { space, 0x70 };
+        ASSERT_EQ(msix.size(), 16);
+        ASSERT_EQ(msix.table_bar(), 2);
+        ASSERT_EQ(msix.table_offset(), 0x2000);
+        ASSERT_EQ(msix.pending_offset(), 0x3000);
+
+        pci::msix_entry entries [16] {};
+        pci::msix_table table { entries, msix.size() };
+
+        static x86::vector_allocator vectors { 2 };
+        x86::interrupt_vector queues [4] {};
+
+        msix.enable_masked();
+        ASSERT_TRUE(msix.is_function_masked());
+        ASSERT_EQ(pci::assign_queues(table, vectors, topology {}, x86::first(2), queues, 4), 4);
+        msix.enable();
+        ASSERT_TRUE(msix.is_enabled());
+        ASSERT_FALSE(msix.is_function_masked());
+
+        ASSERT_EQ(entries[0].address_low, 0xFEE00000);
+        ASSERT_EQ(entries[1].address_low, 0xFEE02000);
+        ASSERT_EQ(entries[1].data, queues[1].vector);
+        ASSERT_TRUE(table.is_masked(1));
+        table.unmask(1);
+        ASSERT_FALSE(table.is_masked(1));
+    }
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <psys/size.h>
+
+namespace ps
+{
+    //! Context entry procedure.
+
+    using context_entry = void (*) (void * argument);
+
+    //! Execution context.
+    //!
+    //! A suspended context is represented by its stack pointer:
+    //! only callee-saved registers are kept, on the context's own stack.
+    //! Floating point control state is kept only for contexts that request it.
+
+    struct context
+    {
+        void *        stack    {};
+        context_entry entry    {};
+        void *        argument {};
+        bool          fpu      {};
+        size2         x87      { 0x037F };
+        size4         sse      { 0x1F80 };
+    };
+
+    //! Prepare a context to call entry(argument) on stack [base, base + length).
+    //!
+    //! Entry must never return; it must switch away instead.
+
+    void make_context (context & target, void * base, size length, context_entry entry, void * argument, bool fpu = false);
+
+    //! Save floating point control state into context.
+
+    void save_fpu_control (context & target);
+
+    //! Load floating point control state from context.
+
+    void load_fpu_control (context const & source);
+
+    //! Switch from the current context to target context.
+
+    void switch_context (context & current, context & target);
+}
+
+extern "C"
+{
+    //! Psys context switch.
+    //!
+    //! Pushes callee-saved registers, stores the stack pointer into `save`,
+    //! loads the stack pointer from `load`, pops callee-saved registers and returns.
+
+    void _ps_switch_context (void ** save, void * load);
+}
+
+namespace ps
+{
+    inline
+    void switch_context (context & current, context & target)
+    {
+        if (current.fpu) save_fpu_control(current);
+        _ps_switch_context(&current.stack, target.stack);
+        if (current.fpu) load_fpu_control(current);
+    }
+}
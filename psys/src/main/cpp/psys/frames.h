@@ -0,0 +1,202 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <psys/size.h>
+#include <psys/spin_lock.h>
+
+namespace ps
+{
+    //! Physical memory range on node.
+
+    struct node_range
+    {
+        size8    base;
+        size8    length;
+        unsigned node;
+    };
+
+    //! Physical frame allocator with one pool per node.
+    //!
+    //! Allocation tries the requested node first, then other nodes by increasing distance.
+    //! Each pool carves frames from its ranges and recycles released frames through a free list
+    //! threaded through the frames themselves, accessed at physical address plus mapping offset.
+    //! Frame zero is never allocated; zero means allocation failed.
+
+    template <unsigned Nodes = 8, unsigned Ranges = 16, unsigned Frame = 0x1000>
+    class frame_allocator
+    {
+        struct range
+        {
+            size8 base;
+            size8 next;
+            size8 limit;
+        };
+
+        struct pool
+        {
+            spin_lock lock;
+            range     ranges [Ranges];
+            unsigned  count;
+            size8     free;
+            size8     available;
+        };
+
+        pool  _pools [Nodes] {};
+        size1 _distances [Nodes][Nodes] {};
+        size1 _order [Nodes][Nodes] {};
+        size  _mapping {};
+
+        auto link (size8 frame) const -> size8 * { return reinterpret_cast<size8 *>(size(frame) + _mapping); }
+
+        auto take (unsigned node) -> size8
+        {
+            auto & pool = _pools[node];
+            lock_guard guard { pool.lock };
+
+            if (pool.free != 0) {
+                auto const frame = pool.free;
+                pool.free = *link(frame);
+                --pool.available;
+                return frame;
+            }
+
+            for (unsigned i = 0; i != pool.count; ++i) {
+                auto & range = pool.ranges[i];
+                if (range.next == range.limit) continue;
+                auto const frame = range.next;
+                range.next += Frame;
+                --pool.available;
+                return frame;
+            }
+
+            return 0;
+        }
+
+        void sort ()
+        {
+            // Nodes by increasing distance; ties keep index order.
+            for (unsigned i = 0; i != Nodes; ++i)
+            {
+                for (unsigned j = 0; j != Nodes; ++j) _order[i][j] = j;
+                for (unsigned j = 1; j < Nodes; ++j)
+                {
+                    auto const node = _order[i][j];
+                    auto k = j;
+                    for (; k != 0 && _distances[i][_order[i][k - 1]] > _distances[i][node]; --k)
+                        _order[i][k] = _order[i][k - 1];
+                    _order[i][k] = node;
+                }
+            }
+        }
+
+    public:
+
+        static constexpr unsigned nodes = Nodes;
+
+        static constexpr unsigned frame_size = Frame;
+
+        //! Object.
+        //! @{
+
+        //! Allocator with default distances: 10 local, 20 remote.
+
+        explicit
+        frame_allocator (size mapping = 0) : _mapping { mapping }
+        {
+            for (unsigned i = 0; i != Nodes; ++i)
+                for (unsigned j = 0; j != Nodes; ++j)
+                    _distances[i][j] = i == j ? 10 : 20;
+            sort();
+        }
+
+        frame_allocator (frame_allocator const &) = delete;
+
+        //! @}
+
+        //! Configuration.
+        //! @{
+
+        //! Add memory range to node pool, trimmed to whole frames and excluding frame zero.
+
+        auto add (node_range memory) -> bool
+        {
+            if (memory.node >= Nodes) return false;
+
+            auto base = (memory.base + Frame - 1) & ~size8(Frame - 1);
+            auto const limit = (memory.base + memory.length) & ~size8(Frame - 1);
+            if (base == 0) base = Frame;
+            if (base >= limit) return false;
+
+            auto & pool = _pools[memory.node];
+            lock_guard guard { pool.lock };
+            if (pool.count == Ranges) return false;
+            pool.ranges[pool.count++] = { base, base, limit };
+            pool.available += (limit - base) / Frame;
+            return true;
+        }
+
+        //! Set distances from a row-major matrix of count by count nodes, as in the ACPI SLIT.
+
+        void distances (size1 const * matrix, unsigned count)
+        {
+            for (unsigned i = 0; i != Nodes && i != count; ++i)
+                for (unsigned j = 0; j != Nodes && j != count; ++j)
+                    _distances[i][j] = matrix[i * count + j];
+            sort();
+        }
+
+        //! @}
+
+        //! Properties.
+        //! @{
+
+        auto distance (unsigned from, unsigned to) const -> size1 { return _distances[from][to]; }
+
+        //! Number of frames available on node.
+
+        auto available (unsigned node) const -> size8 { return _pools[node].available; }
+
+        //! Node owning frame, or Nodes if none.
+
+        auto node (size8 frame) const -> unsigned
+        {
+            for (unsigned i = 0; i != Nodes; ++i)
+                for (unsigned j = 0; j != _pools[i].count; ++j)
+                    if (frame >= _pools[i].ranges[j].base && frame < _pools[i].ranges[j].limit) return i;
+            return Nodes;
+        }
+
+        //! @}
+
+        //! Allocation.
+        //! @{
+
+        //! Allocate frame, local to node if possible, otherwise from the nearest node with free frames.
+
+        auto allocate (unsigned node) -> size8
+        {
+            if (node >= Nodes) node = 0;
+            for (unsigned i = 0; i != Nodes; ++i) {
+                auto const frame = take(_order[node][i]);
+                if (frame != 0) return frame;
+            }
+            return 0;
+        }
+
+        //! Release frame to the pool of its node.
+
+        void release (size8 frame)
+        {
+            auto const owner = node(frame);
+            if (owner == Nodes) return;
+            auto & pool = _pools[owner];
+            lock_guard guard { pool.lock };
+            *link(frame) = pool.free;
+            pool.free = frame;
+            ++pool.available;
+        }
+
+        //! @}
+    };
+}
@@ -0,0 +1,58 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+namespace ps
+{
+    //! Spin lock.
+    //!
+    //! Test and test-and-set: waiters spin on a plain load to keep the cache line shared.
+
+    class spin_lock
+    {
+        bool _locked {};
+
+    public:
+
+        //! Try to acquire lock; returns false if already locked.
+
+        auto try_lock () -> bool
+        {
+            return ! __atomic_exchange_n(&_locked, true, __ATOMIC_ACQUIRE);
+        }
+
+        //! Acquire lock, spinning until available.
+
+        void lock ()
+        {
+            while (! try_lock()) {
+                while (__atomic_load_n(&_locked, __ATOMIC_RELAXED))
+                    __asm__ volatile ( "pause" : : : "memory" );
+            }
+        }
+
+        //! Release lock.
+
+        void unlock ()
+        {
+            __atomic_store_n(&_locked, false, __ATOMIC_RELEASE);
+        }
+    };
+
+    //! Scoped lock guard.
+
+    template <typename Lock>
+    class lock_guard
+    {
+        Lock & _lock;
+
+    public:
+
+        explicit
+        lock_guard (Lock & lock) : _lock { lock } { _lock.lock(); }
+
+        lock_guard (lock_guard const &) = delete;
+
+        ~lock_guard () { _lock.unlock(); }
+    };
+}
@@ -0,0 +1,94 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <psys/size.h>
+
+namespace ps
+{
+    //! Stack memory region.
+
+    struct stack
+    {
+        void * base   {};
+        size   length {};
+    };
+
+    //! Pool of fixed size stacks.
+    //!
+    //! Each stack is preceded by a guard region, page aligned, filled with a known pattern.
+    //! Paging may unmap the guard region to fault on overflow;
+    //! otherwise, overflow is detected when the stack is released.
+
+    template <unsigned Length, unsigned Count, unsigned Guard = 0x1000>
+        requires (Length % Guard == 0)
+    class stack_pool
+    {
+        static constexpr size1 pattern = 0xCC;
+
+        struct alignas(Guard) slot
+        {
+            size1 guard  [Guard];
+            size1 memory [Length];
+        };
+
+        slot _slots [Count] {};
+        bool _used  [Count] {};
+
+    public:
+
+        //! Allocate a stack; returns an empty stack if exhausted.
+
+        auto allocate () -> stack
+        {
+            for (unsigned i = 0; i != Count; ++i)
+            {
+                if (_used[i]) continue;
+                _used[i] = true;
+                for (auto & byte : _slots[i].guard) byte = pattern;
+                return { _slots[i].memory, Length };
+            }
+            return {};
+        }
+
+        //! Release a stack; returns false if its guard region was overwritten.
+
+        auto release (stack target) -> bool
+        {
+            auto const i = index(target);
+            if (i == Count) return false;
+            auto const intact = is_intact(target);
+            _used[i] = false;
+            return intact;
+        }
+
+        //! Guard region below stack.
+
+        auto guard (stack target) -> stack
+        {
+            auto const i = index(target);
+            if (i == Count) return {};
+            return { _slots[i].guard, Guard };
+        }
+
+        //! Test if the guard region below stack is intact.
+
+        auto is_intact (stack target) const -> bool
+        {
+            auto const i = index(target);
+            if (i == Count) return false;
+            for (auto byte : _slots[i].guard)
+                if (byte != pattern) return false;
+            return true;
+        }
+
+    private:
+
+        auto index (stack target) const -> unsigned
+        {
+            for (unsigned i = 0; i != Count; ++i)
+                if (target.base == _slots[i].memory) return i;
+            return Count;
+        }
+    };
+}
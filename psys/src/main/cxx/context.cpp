@@ -0,0 +1,230 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#include <psys/context.h>
+
+// NOTE: inline assembler in `att` syntax.
+
+extern "C"
+{
+    //! Psys context start.
+    //!
+    //! Called by the context trampoline with the context being started.
+
+    [[gnu::used]]
+    void _ps_context_start (ps::context * self)
+    {
+        if (self->fpu) ps::load_fpu_control(*self);
+        self->entry(self->argument);
+        __builtin_trap();
+    }
+
+#if defined(__x86_64__) && defined(_WIN64)
+
+    // Microsoft x64: callee saves rbx, rbp, rdi, rsi, r12-r15, xmm6-xmm15.
+
+    [[gnu::naked]]
+    void _ps_switch_context (void ** save, void * load)
+    {
+        __asm__ (
+            "push %rbp                \n"
+            "push %rbx                \n"
+            "push %rdi                \n"
+            "push %rsi                \n"
+            "push %r12                \n"
+            "push %r13                \n"
+            "push %r14                \n"
+            "push %r15                \n"
+            "sub $160, %rsp           \n"
+            "movdqu %xmm6,    0(%rsp) \n"
+            "movdqu %xmm7,   16(%rsp) \n"
+            "movdqu %xmm8,   32(%rsp) \n"
+            "movdqu %xmm9,   48(%rsp) \n"
+            "movdqu %xmm10,  64(%rsp) \n"
+            "movdqu %xmm11,  80(%rsp) \n"
+            "movdqu %xmm12,  96(%rsp) \n"
+            "movdqu %xmm13, 112(%rsp) \n"
+            "movdqu %xmm14, 128(%rsp) \n"
+            "movdqu %xmm15, 144(%rsp) \n"
+            "mov %rsp, (%rcx)         \n"
+            "mov %rdx, %rsp           \n"
+            "movdqu    0(%rsp), %xmm6 \n"
+            "movdqu   16(%rsp), %xmm7 \n"
+            "movdqu   32(%rsp), %xmm8 \n"
+            "movdqu   48(%rsp), %xmm9 \n"
+            "movdqu   64(%rsp), %xmm10\n"
+            "movdqu   80(%rsp), %xmm11\n"
+            "movdqu   96(%rsp), %xmm12\n"
+            "movdqu  112(%rsp), %xmm13\n"
+            "movdqu  128(%rsp), %xmm14\n"
+            "movdqu  144(%rsp), %xmm15\n"
+            "add $160, %rsp           \n"
+            "pop %r15                 \n"
+            "pop %r14                 \n"
+            "pop %r13                 \n"
+            "pop %r12                 \n"
+            "pop %rsi                 \n"
+            "pop %rdi                 \n"
+            "pop %rbx                 \n"
+            "pop %rbp                 \n"
+            "ret                      \n"
+        );
+    }
+
+    [[gnu::naked]]
+    void _ps_context_trampoline ()
+    {
+        __asm__ (
+            "mov %r12, %rcx           \n"
+            "sub $32, %rsp            \n"
+            "call _ps_context_start   \n"
+            "ud2                      \n"
+        );
+    }
+
+#elif defined(__x86_64__)
+
+    // System V x86-64: callee saves rbx, rbp, r12-r15.
+
+    [[gnu::naked]]
+    void _ps_switch_context (void ** save, void * load)
+    {
+        __asm__ (
+            "push %rbp                \n"
+            "push %rbx                \n"
+            "push %r12                \n"
+            "push %r13                \n"
+            "push %r14                \n"
+            "push %r15                \n"
+            "mov %rsp, (%rdi)         \n"
+            "mov %rsi, %rsp           \n"
+            "pop %r15                 \n"
+            "pop %r14                 \n"
+            "pop %r13                 \n"
+            "pop %r12                 \n"
+            "pop %rbx                 \n"
+            "pop %rbp                 \n"
+            "ret                      \n"
+        );
+    }
+
+    [[gnu::naked]]
+    void _ps_context_trampoline ()
+    {
+        __asm__ (
+            "mov %r12, %rdi           \n"
+            "call _ps_context_start   \n"
+            "ud2                      \n"
+        );
+    }
+
+#elif defined(__i386__)
+
+    // System V i386: callee saves ebx, ebp, esi, edi.
+
+    [[gnu::naked]]
+    void _ps_switch_context (void ** save, void * load)
+    {
+        __asm__ (
+            "mov 4(%esp), %eax        \n"
+            "mov 8(%esp), %edx        \n"
+            "push %ebp                \n"
+            "push %ebx                \n"
+            "push %esi                \n"
+            "push %edi                \n"
+            "mov %esp, (%eax)         \n"
+            "mov %edx, %esp           \n"
+            "pop %edi                 \n"
+            "pop %esi                 \n"
+            "pop %ebx                 \n"
+            "pop %ebp                 \n"
+            "ret                      \n"
+        );
+    }
+
+    [[gnu::naked]]
+    void _ps_context_trampoline ()
+    {
+        __asm__ (
+            "push %esi                \n"
+            "call _ps_context_start   \n"
+            "ud2                      \n"
+        );
+    }
+
+#else
+# error unsupported target
+#endif
+}
+
+namespace ps
+{
+    void make_context (context & target, void * base, size length, context_entry entry, void * argument, bool fpu)
+    {
+        target.entry = entry;
+        target.argument = argument;
+        target.fpu = fpu;
+        target.x87 = 0x037F;
+        target.sse = 0x1F80;
+
+        // Initial frame is popped by _ps_switch_context, which then returns into the trampoline;
+        // the trampoline calls _ps_context_start with the stack aligned to 16 bytes.
+
+        auto const top = (reinterpret_cast<size>(base) + length) & ~size{15};
+        auto const self = reinterpret_cast<void *>(&target);
+        auto const trampoline = reinterpret_cast<void *>(_ps_context_trampoline);
+
+#if defined(__x86_64__) && defined(_WIN64)
+        auto const frame = reinterpret_cast<void **>(top - 16 - 8 - 8 * 8 - 160);
+        for (unsigned i = 0; i != 20; ++i) frame[i] = nullptr; // xmm6-xmm15
+        frame[20] = nullptr;    // r15
+        frame[21] = nullptr;    // r14
+        frame[22] = nullptr;    // r13
+        frame[23] = self;       // r12
+        frame[24] = nullptr;    // rsi
+        frame[25] = nullptr;    // rdi
+        frame[26] = nullptr;    // rbx
+        frame[27] = nullptr;    // rbp
+        frame[28] = trampoline; // return
+#elif defined(__x86_64__)
+        auto const frame = reinterpret_cast<void **>(top - 16 - 8 - 6 * 8);
+        frame[0] = nullptr;     // r15
+        frame[1] = nullptr;     // r14
+        frame[2] = nullptr;     // r13
+        frame[3] = self;        // r12
+        frame[4] = nullptr;     // rbx
+        frame[5] = nullptr;     // rbp
+        frame[6] = trampoline;  // return
+#elif defined(__i386__)
+        auto const frame = reinterpret_cast<void **>(top - 12 - 4 - 4 * 4);
+        frame[0] = nullptr;     // edi
+        frame[1] = self;        // esi
+        frame[2] = nullptr;     // ebx
+        frame[3] = nullptr;     // ebp
+        frame[4] = trampoline;  // return
+#endif
+
+        target.stack = frame;
+    }
+
+    void save_fpu_control (context & target)
+    {
+        unsigned short x87 {};
+        __asm__ volatile ( "fnstcw %0" : "=m"(x87) );
+        target.x87 = x87;
+#if defined(__x86_64__)
+        unsigned int sse {};
+        __asm__ volatile ( "stmxcsr %0" : "=m"(sse) );
+        target.sse = sse;
+#endif
+    }
+
+    void load_fpu_control (context const & source)
+    {
+        unsigned short x87 = source.x87;
+        __asm__ volatile ( "fldcw %0" : : "m"(x87) );
+#if defined(__x86_64__)
+        unsigned int sse = source.sse;
+        __asm__ volatile ( "ldmxcsr %0" : : "m"(sse) );
+#endif
+    }
+}
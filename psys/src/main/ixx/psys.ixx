@@ -2,16 +2,32 @@
 
 module;
 
+#include <psys/context.h>
+#include <psys/frames.h>
 #include <psys/integer.h>
 #include <psys/move.h>
 #include <psys/port.h>
 #include <psys/size.h>
+#include <psys/spin_lock.h>
+#include <psys/stack.h>
 #include <psys/test.h>
 
 export module br.dev.pedrolamarao.metal.psys;
 
 export namespace ps
 {
+    // context
+    using ::ps::context_entry;
+    using ::ps::context;
+    using ::ps::make_context;
+    using ::ps::save_fpu_control;
+    using ::ps::load_fpu_control;
+    using ::ps::switch_context;
+
+    // frames
+    using ::ps::node_range;
+    using ::ps::frame_allocator;
+
     // integer
     using ::ps::integer;
     using ::ps::integer1;
@@ -31,6 +47,14 @@ export namespace ps
     using ::ps::size2;
     using ::ps::size4;
     using ::ps::size8;
+
+    // spin_lock
+    using ::ps::spin_lock;
+    using ::ps::lock_guard;
+
+    // stack
+    using ::ps::stack;
+    using ::ps::stack_pool;
 }
 
 export using ::_test_start;
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    ps::stack_pool<0x4000, 2> pool {};
+
+    ps::context main_context {};
+
+    ps::context ping_context {};
+
+    unsigned counter {};
+
+    void ping (void * argument)
+    {
+        auto const limit = *static_cast<unsigned *>(argument);
+        while (true) {
+            if (counter != limit) ++counter;
+            ps::switch_context(ping_context, main_context);
+        }
+    }
+
+    // Floating point control state of the running context.
+
+    struct fpu_control
+    {
+        unsigned short x87 {};
+        unsigned int   sse {};
+    };
+
+    auto get_fpu_control () -> fpu_control
+    {
+        fpu_control control {};
+        __asm__ volatile ( "fnstcw %0" : "=m"(control.x87) );
+#if defined(__x86_64__)
+        __asm__ volatile ( "stmxcsr %0" : "=m"(control.sse) );
+#endif
+        return control;
+    }
+
+    void set_fpu_control (fpu_control control)
+    {
+        __asm__ volatile ( "fldcw %0" : : "m"(control.x87) );
+#if defined(__x86_64__)
+        __asm__ volatile ( "ldmxcsr %0" : : "m"(control.sse) );
+#endif
+    }
+
+    fpu_control ping_control {};
+
+    void fpu_ping (void *)
+    {
+        while (true) {
+            ping_control = get_fpu_control();
+            set_fpu_control({ 0x007F, 0x1F80 });
+            ps::switch_context(ping_context, main_context);
+        }
+    }
+
+    TEST(context, ping_pong)
+    {
+        auto stack = pool.allocate();
+        ASSERT_NE(stack.base, nullptr);
+
+        unsigned limit = 1000;
+        ps::make_context(ping_context, stack.base, stack.length, ping, &limit);
+
+        counter = 0;
+        for (unsigned i = 0; i != limit; ++i) {
+            ps::switch_context(main_context, ping_context);
+            ASSERT_EQ(counter, i + 1);
+        }
+
+        ASSERT_TRUE(pool.release(stack));
+    }
+
+    TEST(context, fpu)
+    {
+        auto stack = pool.allocate();
+        ASSERT_NE(stack.base, nullptr);
+
+        ps::make_context(ping_context, stack.base, stack.length, fpu_ping, nullptr, true);
+        main_context.fpu = true;
+
+        // Rounding toward zero, all exceptions masked.
+        auto const saved = get_fpu_control();
+        set_fpu_control({ 0x0F7F, 0x7F80 });
+
+        for (unsigned i = 0; i != 2; ++i) {
+            ps::switch_context(main_context, ping_context);
+            auto const control = get_fpu_control();
+            set_fpu_control(saved);
+            // Ping starts with default control state, then keeps its own.
+            ASSERT_EQ(ping_control.x87, i == 0 ? 0x037F : 0x007F);
+            ASSERT_EQ(control.x87, 0x0F7F);
+#if defined(__x86_64__)
+            ASSERT_EQ(ping_control.sse, 0x1F80);
+            ASSERT_EQ(control.sse, 0x7F80);
+#endif
+            set_fpu_control({ 0x0F7F, 0x7F80 });
+        }
+        set_fpu_control(saved);
+
+        main_context.fpu = false;
+        ASSERT_TRUE(pool.release(stack));
+    }
+
+    TEST(stack_pool, exhaust)
+    {
+        ps::stack_pool<0x1000, 1> small {};
+        auto first = small.allocate();
+        ASSERT_NE(first.base, nullptr);
+        auto second = small.allocate();
+        ASSERT_EQ(second.base, nullptr);
+        ASSERT_TRUE(small.release(first));
+    }
+
+    TEST(stack_pool, guard)
+    {
+        ps::stack_pool<0x1000, 1> small {};
+        auto stack = small.allocate();
+        auto guard = small.guard(stack);
+        ASSERT_EQ(static_cast<char *>(guard.base) + guard.length, stack.base);
+        static_cast<char *>(guard.base)[guard.length - 1] = 0;
+        ASSERT_FALSE(small.is_intact(stack));
+        ASSERT_FALSE(small.release(stack));
+    }
+}
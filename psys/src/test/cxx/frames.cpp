@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+namespace
+{
+    // Physical memory simulated by an arena: frame addresses are offsets into it.
+
+    alignas(0x1000) ps::size1 arena [0x10000] {};
+
+    auto const mapping = reinterpret_cast<ps::size>(arena);
+
+    TEST(frame_allocator, local_first)
+    {
+        ps::frame_allocator<2, 4> frames { mapping };
+        ASSERT_TRUE(frames.add({ 0x0000, 0x4000, 0 }));
+        ASSERT_TRUE(frames.add({ 0x8000, 0x2800, 1 }));
+        ASSERT_FALSE(frames.add({ 0xC000, 0x1000, 2 }));
+
+        // Frame zero is excluded; partial frames are trimmed.
+        ASSERT_EQ(frames.available(0), 3);
+        ASSERT_EQ(frames.available(1), 2);
+
+        ASSERT_EQ(frames.allocate(1), 0x8000);
+        ASSERT_EQ(frames.allocate(1), 0x9000);
+        // Node 1 exhausted: falls back to node 0.
+        ASSERT_EQ(frames.allocate(1), 0x1000);
+        ASSERT_EQ(frames.node(0x1000), 0);
+
+        // Released frames are reused first.
+        frames.release(0x9000);
+        ASSERT_EQ(frames.available(1), 1);
+        ASSERT_EQ(frames.allocate(1), 0x9000);
+        frames.release(0x8000);
+        frames.release(0x9000);
+        ASSERT_EQ(frames.allocate(1), 0x9000);
+        ASSERT_EQ(frames.allocate(1), 0x8000);
+    }
+
+    TEST(frame_allocator, distance)
+    {
+        ps::frame_allocator<3, 4> frames { mapping };
+        ASSERT_TRUE(frames.add({ 0x1000, 0x1000, 0 }));
+        ASSERT_TRUE(frames.add({ 0x2000, 0x1000, 1 }));
+        ASSERT_TRUE(frames.add({ 0x3000, 0x1000, 2 }));
+
+        // Node 2 is nearer to node 0 than node 1 is.
+        ps::size1 const distances [] = {
+            10, 40, 20,
+            40, 10, 20,
+            20, 20, 10,
+        };
+        frames.distances(distances, 3);
+        ASSERT_EQ(frames.distance(0, 2), 20);
+
+        ASSERT_EQ(frames.allocate(0), 0x1000);
+        ASSERT_EQ(frames.allocate(0), 0x3000);
+        ASSERT_EQ(frames.allocate(0), 0x2000);
+        ASSERT_EQ(frames.allocate(0), 0);
+    }
+}
@@ -0,0 +1,104 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace
+{
+    ps::stack_pool<0x4000, 1> pool {};
+
+    ps::context main_context {};
+
+    ps::context pong_context {};
+
+    unsigned counter {};
+
+    void pong (void *)
+    {
+        while (true) {
+            ++counter;
+            ps::switch_context(pong_context, main_context);
+        }
+    }
+
+    constexpr unsigned rounds = 10000;
+}
+
+namespace psys { void main (); }
+
+void psys::main ()
+{
+    using namespace ps;
+    using namespace x86;
+
+    // allocate stack
+
+    _test_control = 1;
+
+    auto stack = pool.allocate();
+    if (stack.base == nullptr) {
+        _test_control = 0;
+        return;
+    }
+
+    // test: switch into new context and back
+
+    _test_control = 2;
+
+    make_context(pong_context, stack.base, stack.length, pong, nullptr);
+    switch_context(main_context, pong_context);
+
+    if (counter != 1) {
+        _test_control = 0;
+        return;
+    }
+
+    // benchmark: ping-pong without floating point control state
+    // report: cycles per round trip (two switches)
+
+    _test_control = 3;
+
+    auto const start = rdtsc();
+    for (unsigned i = 0; i != rounds; ++i)
+        switch_context(main_context, pong_context);
+    auto const finish = rdtsc();
+
+    if (counter != rounds + 1) {
+        _test_control = 0;
+        return;
+    }
+
+    _test_debug = (finish - start) / rounds;
+
+    // benchmark: ping-pong with floating point control state
+    // report: cycles per round trip (two switches)
+
+    _test_control = 4;
+
+    main_context.fpu = true;
+    pong_context.fpu = true;
+
+    auto const start_fpu = rdtsc();
+    for (unsigned i = 0; i != rounds; ++i)
+        switch_context(main_context, pong_context);
+    auto const finish_fpu = rdtsc();
+
+    if (counter != 2 * rounds + 1) {
+        _test_control = 0;
+        return;
+    }
+
+    _test_debug = (finish_fpu - start_fpu) / rounds;
+
+    // test: stack guard intact
+
+    _test_control = 5;
+
+    if (! pool.release(stack)) {
+        _test_control = 0;
+        return;
+    }
+
+    _test_control = -1;
+    return;
+}
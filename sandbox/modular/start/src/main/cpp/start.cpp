@@ -22,6 +22,22 @@ namespace x86
 
     void install_pages ();
 
+    auto map_page ( size8 address, size8 frame, bool writable ) -> bool;
+
+    auto allocate_frame () -> size1 *;
+
+    auto available_frames () -> size;
+
+    auto available_page_tables () -> size;
+
+    auto allocate_high_half ( size8 length ) -> size8;
+
+    auto map_large_pages ( size8 address, size8 frame, size8 length ) -> bool;
+
+    void install_direct_map ( multiboot2::information_index const & index );
+
+    auto direct_map_limit () -> size8;
+
     // operators.
 
     void abort ()
@@ -33,24 +49,48 @@ namespace x86
 
     void trampoline_call_32 ( segment_selector segment, size target );
 
-    void trampoline_call_64 ( segment_selector segment, size target );
+    void trampoline_call_64 ( segment_selector segment, size8 target );
+}
+
+namespace elf
+{
+    // Module source: ELF image, or compressed container with ELF headers decoded to a buffer.
+
+    struct module_source
+    {
+        size headers;
+        size headers_length;
+        size length;
+        size container;
+        size container_length;
+    };
 }
 
 namespace multiboot2
 {
     using size = ps::size;
 
-    auto find_module ( information_list & information ) -> modules_information const * ;
-
     struct module_type
     {
         unsigned bitness;
         size start;
-        size entry;
+        ps::size8 entry;
         size end;
+        ps::size8 low;
+        ps::size8 high;
+        ps::size8 bias;
+        ps::size8 alias;
+        size dynamic;
+        size dynamic_size;
     };
 
-    auto load_module ( modules_information const * module ) -> module_type;
+    auto collect_free_memory ( information_list const & information, information_index const & index ) -> bool;
+
+    auto validate_module ( modules_information const * module, elf::module_source & source ) -> bool;
+
+    auto load_module ( elf::module_source const & source, elf::copy_queue<> & queue ) -> module_type;
+
+    void relocate_module ( module_type const & module );
 }
 
 void multiboot2::main ( ps::size4 magic, multiboot2::information_list & information )
@@ -80,6 +120,10 @@ void multiboot2::main ( ps::size4 magic, multiboot2::information_list & informat
         return;
     }
 
+    // Index boot information.
+
+    information_index const index { information };
+
     // Prepare x86 segments.
 
     install_segments();
@@ -88,6 +132,10 @@ void multiboot2::main ( ps::size4 magic, multiboot2::information_list & informat
 
     install_pages();
 
+    // Map all memory at the direct map base.
+
+    install_direct_map(index);
+
     // Enable long mode.
 
     set_msr(msr::EFER, get_msr(msr::EFER) | (1 << 8));
@@ -96,23 +144,53 @@ void multiboot2::main ( ps::size4 magic, multiboot2::information_list & informat
 
     enable_paging();
 
-    // Find modules.
+    // Collect free memory: RAM less modules, the information list and the start image.
 
-    for (auto i = begin(information), j = end(information); i != j; i = next(i))
+    if (! collect_free_memory(information, index)) {
+        abort();
+        return;
+    }
+
+    // Validate all modules before touching memory: headers, program headers and segment ranges.
+
+    elf::module_source modules [16] {};
+    unsigned module_count = 0;
+
+    for (auto const & module_information : index.modules())
     {
-        if (i->type != information_type::modules) continue;
-        auto module_information = reinterpret_cast<modules_information const *>(i);
+        if (module_count == sizeof(modules) / sizeof(modules[0])) abort();
+        if (! validate_module(& module_information, modules[module_count])) continue;
+        ++module_count;
+    }
 
-        // Load module.
+    // Map all modules, queueing segment copies.
 
-        auto module = load_module(module_information);
-        if (module.entry == 0) continue;
+    static elf::copy_queue<> queue;
+    module_type loaded [16] {};
+
+    for (unsigned i = 0; i != module_count; ++i)
+        loaded[i] = load_module(modules[i], queue);
+
+    // Copy all segments; other processors, once started, may join by running the queue.
 
-        // Call module entry point.
+    queue.run();
+    queue.wait();
+
+    // Relocate all modules.
+
+    for (unsigned i = 0; i != module_count; ++i)
+        relocate_module(loaded[i]);
+
+    // Call module entry points in order.
+
+    for (unsigned i = 0; i != module_count; ++i)
+    {
+        auto const & module = loaded[i];
+        if (module.entry == 0) continue;
 
         if (module.bitness == 32) // call 32-bit entry
         {
-            trampoline_call_32(code_segment_32, module.entry);
+            trampoline_call_32(code_segment_32, size(module.entry));
         }
         else if (module.bitness == 64) // call 64-bit entry
         {
@@ -129,97 +207,340 @@ namespace elf
 {
     struct module_type
     {
-        size start;
-        size entry;
-        size end;
+        size  start;
+        size8 entry;
+        size  end;
+        size8 low;
+        size8 high;
+        size8 bias;
+        size8 alias;
+        size  dynamic;
+        size  dynamic_size;
     };
 
-    auto load_module_32 ( size address )
+    constexpr size8 page_size = 0x1000;
+
+    // Free memory: available RAM from the memory maps, less modules, the information list
+    // and the first 2 MiB, where the start image, its page tables and its frames live.
+
+    constinit
+    multiboot2::memory_map_normalizer<> free_memory {};
+
+    // Range from begin to end lies inside free memory.
+
+    auto is_free ( size8 begin, size8 end ) -> bool
+    {
+        for (auto const & range : free_memory)
+            if (range.begin <= begin && end <= range.end) return true;
+        return false;
+    }
+
+    // Identity map 2 MiB regions covering length bytes at address, with 2 MiB pages;
+    // the first 2 MiB is identity mapped by the shared page table already.
+
+    void map_identity ( size8 address, size8 length )
+    {
+        auto const begin = address < 0x200000 ? size8(0x200000) : address & ~size8(0x1FFFFF);
+        auto const end = (address + length + 0x1FFFFF) & ~size8(0x1FFFFF);
+        if (begin < end && ! x86::map_large_pages(begin, begin, end - begin)) x86::abort();
+    }
+
+    // Queue copy of file data and zero fill to virtual address.
+
+    template <typename Segment>
+    void copy_segment ( size address, Segment const & segment, copy_queue<> & queue )
     {
-        auto header = reinterpret_cast<header_32 const *>(address);
+        copy_job const job { size(segment.vaddr), size(address + segment.offset), size(segment.filesz), size(segment.memsz - segment.filesz) };
+        if (! queue.add(job)) x86::abort();
+    }
 
-        for (int i = 0; i != header->phnum; ++i)
+    // Map module pages in place, with fresh frames for the partial page and zero fill;
+    // if not congruent, or if frames or page tables may not suffice, identity map the segment and copy it instead:
+    // outside the first 2 MiB, virtual is not physical until mapped.
+    // Copies must land in free memory; start aborts otherwise.
+    // Writable pages are mapped in place too: the module image belongs to the loaded program.
+
+    template <typename Segment>
+    void map_segment ( size address, Segment const & original, size8 bias, copy_queue<> & queue )
+    {
+        auto segment = original;
+        segment.vaddr += bias;
+
+        segment_plan plan;
+        auto const mapped = plan_segment(address, segment, page_size, plan);
+        auto const frames = (plan.copy ? 1 : 0) + plan.zero_pages;
+        auto const end = plan.zero_address + plan.zero_pages * page_size;
+        auto const tables = (end - plan.map_address + 0x1FFFFF) / 0x200000 + 1;
+        if (! mapped || end > 0x40000000 || frames > x86::available_frames() || tables > x86::available_page_tables())
         {
-            auto segment = reinterpret_cast<segment_32 const *>(address + header->phoff + (header->phentsize * i));
+            if (! is_free(segment.vaddr, size8(segment.vaddr) + segment.memsz)) x86::abort();
+            map_identity(segment.vaddr, segment.memsz);
+            copy_segment(address, segment, queue);
+            return;
+        }
 
-            if (segment->type != elf::segment::load) continue;
+        for (size8 i = 0; i != plan.map_pages; ++i)
+            if (! x86::map_page(plan.map_address + i * page_size, plan.map_source + i * page_size, plan.writable)) x86::abort();
 
-            auto file = reinterpret_cast<size1 *>(address + segment->offset);
-            auto memory = reinterpret_cast<size1 *>(segment->vaddr);
-            for (int i = 0; i != segment->filesz; ++i)
-                memory[i] = file[i];
-            for (int i = segment->filesz; i != segment->memsz; ++i)
-                memory[i] = 0;
+        if (plan.copy) {
+            auto frame = x86::allocate_frame();
+            auto offset = plan.copy_address & (page_size - 1);
+            if (! queue.add({ size(reinterpret_cast<size>(frame) + offset), size(plan.copy_source), size(plan.copy_size), 0 })) x86::abort();
+            if (! x86::map_page(plan.copy_address & ~(page_size - 1), reinterpret_cast<size>(frame), plan.writable)) x86::abort();
         }
 
-        return module_type { 0, header->entry, 0 };
+        for (size8 i = 0; i != plan.zero_pages; ++i)
+            if (! x86::map_page(plan.zero_address + i * page_size, reinterpret_cast<size>(x86::allocate_frame()), plan.writable)) x86::abort();
     }
 
-    auto load_module_64 ( size address )
+    // Decode compressed frames inside segment straight to its address, then queue zero fill.
+
+    template <typename Segment>
+    auto is_inside ( Segment const & segment, compressed_frame const & frame ) -> bool
+    {
+        return frame.offset >= segment.offset && frame.offset + frame.size <= size8(segment.offset) + segment.filesz;
+    }
+
+    template <typename Segment>
+    void unpack_segment ( compressed_module const & container, Segment const & segment, size8 bias, copy_queue<> & queue )
     {
-        auto header = reinterpret_cast<header_64 const *>(address);
+        auto const address = size8(segment.vaddr) + bias;
+        if (address + segment.memsz > 0x40000000) x86::abort();
 
-        for (int i = 0; i != header->phnum; ++i)
+        for (auto frame = container.first(); frame != nullptr; frame = container.next(frame))
         {
-            auto segment = reinterpret_cast<segment_64 const *>(address + header->phoff + (header->phentsize * i));
+            if (! is_inside(segment, *frame)) continue;
+            auto const target = address + (frame->offset - segment.offset);
+            if (! container.decode(*frame, reinterpret_cast<void *>(size(target)), frame->size)) x86::abort();
+        }
+
+        if (! queue.add({ size(address + segment.filesz), 0, 0, size(segment.memsz - segment.filesz) })) x86::abort();
+    }
+
+    // Executable images, widened to 2 MiB boundaries: placements keep away from them.
+
+    constinit
+    multiboot2::memory_range executables [16] {};
+
+    constinit
+    unsigned executable_count {};
+
+    template <typename Header, typename Segment>
+    auto reserve_executable ( module_source const & source ) -> bool
+    {
+        image<Header, Segment> const module { source.headers, source.length };
+        if (module.header().type == size2(file_type::ET_DYN)) return true;
+        if (executable_count == sizeof(executables) / sizeof(executables[0])) return false;
+        executables[executable_count++] = { module.low() & ~size8(0x1FFFFF), (module.high() + 0x1FFFFF) & ~size8(0x1FFFFF) };
+        return true;
+    }
+
+    // Allocate 2 MiB aligned range of length bytes in free memory below 1 GiB, away from executables,
+    // above previous allocations; zero if none.
+
+    constinit
+    size8 next_base {};
+
+    auto allocate_placement ( size8 length ) -> size8
+    {
+        for (auto const & range : free_memory)
+        {
+            auto base = (range.begin + 0x1FFFFF) & ~size8(0x1FFFFF);
+            if (base < next_base) base = next_base;
+            for (bool moved = true; moved; )
+            {
+                moved = false;
+                for (unsigned i = 0; i != executable_count; ++i) {
+                    if (base < executables[i].end && executables[i].begin < base + length) {
+                        base = executables[i].end;
+                        moved = true;
+                    }
+                }
+            }
+            if (base + length > range.end || base + length > 0x40000000) continue;
+            next_base = base + length;
+            return base;
+        }
+        return 0;
+    }
+
+    // Position independent images are placed in free memory, at 2 MiB aligned addresses below 1 GiB,
+    // identity mapped with 2 MiB pages, and loaded by copying; start aborts if none fits.
+    // 64-bit ones then run in the high half, mapped with 2 MiB pages;
+    // they are loaded and relocated through the identity mapped alias.
+
+    struct placement
+    {
+        bool  placed;
+        size8 bias;
+        size8 alias;
+    };
+
+    template <typename Header, typename Segment>
+    auto place ( image<Header, Segment> const & module ) -> placement
+    {
+        if (module.header().type != size2(file_type::ET_DYN) || module.high() == module.low()) return {};
+
+        auto const low = module.low() & ~size8(0x1FFFFF);
+        auto const length = (module.high() - low + 0x1FFFFF) & ~size8(0x1FFFFF);
+        auto const base = allocate_placement(length);
+        if (base == 0 || ! x86::map_large_pages(base, base, length)) x86::abort();
+        if constexpr (sizeof(Segment) == sizeof(segment_32)) return { true, base - low, base - low };
+
+        auto const high = x86::allocate_high_half(length);
+        if (high == 0 || ! x86::map_large_pages(high, base, length)) x86::abort();
+        return { true, high - low, base - low };
+    }
+
+    // Valid images only; executables must fit in the identity mapped first 1 GiB,
+    // and dynamic sections must lie inside the image.
+    // Compressed images must have program headers in the first frame,
+    // and file data of every loadable segment exactly covered by frames inside it;
+    // compressed executables decode straight to segment addresses, which must lie in free memory,
+    // away from their own container, other modules and the information list.
+
+    template <typename Header, typename Segment>
+    auto is_loadable ( module_source const & source ) -> bool
+    {
+        auto const & header = * reinterpret_cast<Header const *>(source.headers);
+        if (source.headers_length < sizeof(Header)) return false;
+        if (header.phoff > source.headers_length || size8(header.phnum) * header.phentsize > source.headers_length - header.phoff) return false;
+
+        image<Header, Segment> const module { source.headers, source.length };
+        if (! module.is_valid()) return false;
+        if (module.header().type != size2(file_type::ET_DYN) && module.high() > 0x40000000) return false;
+        for (size i = 0; i != module.segment_count(); ++i)
+        {
+            auto const & segment = module.segment_at(i);
+            if (segment.type != elf::segment::dynamic) continue;
+            if (segment.vaddr < module.low() || segment.vaddr > module.high() || segment.memsz > module.high() - segment.vaddr) return false;
+        }
+        if (source.container == 0) return true;
+
+        compressed_module const container { source.container, source.container_length };
+        for (size i = 0; i != module.segment_count(); ++i)
+        {
+            auto const & segment = module.segment_at(i);
+            if (segment.type != elf::segment::load) continue;
+            if (module.header().type != size2(file_type::ET_DYN) && ! is_free(segment.vaddr, size8(segment.vaddr) + segment.memsz)) return false;
+            size8 covered = 0;
+            for (auto frame = container.first(); frame != nullptr; frame = container.next(frame))
+                if (is_inside(segment, *frame)) covered += frame->size;
+            if (covered != segment.filesz) return false;
+        }
+        return true;
+    }
+
+    alignas(8) size1 header_buffers [16][0x1000];
+    unsigned header_buffer_count = 0;
 
-            if (segment->type != elf::segment::load) continue;
+    auto validate_module ( size address, size length, module_source & source ) -> bool
+    {
+        source = { address, length, length, 0, 0 };
 
-            auto file = reinterpret_cast<size1 *>(address + segment->offset);
-            auto memory = reinterpret_cast<size1 *>(segment->vaddr);
-            for (int i = 0; i != segment->filesz; ++i)
-                memory[i] = file[i];
-            for (int i = segment->filesz; i != segment->memsz; ++i)
-                memory[i] = 0;
+        if (is_compressed(address, length))
+        {
+            compressed_module const container { address, length };
+            if (! container.is_valid() || container.length() > ~size(0) || header_buffer_count == 16) return false;
+            auto const first = container.first();
+            auto const buffer = header_buffers[header_buffer_count];
+            if (first == nullptr || first->offset != 0 || ! container.decode(*first, buffer, sizeof(header_buffers[0]))) return false;
+            ++header_buffer_count;
+            source = { reinterpret_cast<size>(buffer), size(first->size), size(container.length()), address, length };
         }
 
-        if (header->entry > 0xFFFFFFFF) x86::abort();
-        auto narrow = static_cast<size>(header->entry);
+        if (source.headers_length < sizeof(prologue)) return false;
+        auto prologue = reinterpret_cast<elf::prologue const *>(source.headers);
+        if (prologue->type == 1) return is_loadable<header_32, segment_32>(source) && reserve_executable<header_32, segment_32>(source);
+        else if (prologue->type == 2) return is_loadable<header_64, segment_64>(source) && reserve_executable<header_64, segment_64>(source);
+        else return false;
+    }
+
+    // Load validated image: map or unpack segments and queue copies.
+
+    template <typename Header, typename Segment>
+    auto load_image ( module_source const & source, copy_queue<> & queue ) -> module_type
+    {
+        image<Header, Segment> const module { source.headers, source.length };
+        compressed_module const container { source.container, source.container_length };
+        auto const [placed, bias, alias] = place(module);
+
+        size dynamic {};
+        size dynamic_size {};
+        for (size i = 0; i != module.segment_count(); ++i)
+        {
+            auto const & segment = module.segment_at(i);
+
+            if (segment.type == elf::segment::dynamic) {
+                dynamic = size(segment.vaddr + alias);
+                dynamic_size = size(segment.memsz);
+            }
+
+            if (segment.type != elf::segment::load) continue;
+
+            if (source.container != 0) {
+                if (! placed) map_identity(segment.vaddr, segment.memsz);
+                unpack_segment(container, segment, alias, queue);
+            }
+            else if (placed) {
+                auto moved = segment;
+                moved.vaddr += alias;
+                copy_segment(source.headers, moved, queue);
+            }
+            else {
+                map_segment(source.headers, segment, bias, queue);
+            }
+        }
 
-        return module_type { 0, narrow, 0 };
+        return module_type { 0, module.header().entry + bias, 0, module.low(), module.high(), bias, alias, dynamic, dynamic_size };
     }
 
-    auto load_module ( size address ) -> module_type
+    auto load_module ( module_source const & source, copy_queue<> & queue ) -> module_type
     {
-        auto prologue = reinterpret_cast<elf::prologue const *>(address);
-        if (prologue->type == 1) return load_module_32(address);
-        else if (prologue->type == 2) return load_module_64(address);
+        auto prologue = reinterpret_cast<elf::prologue const *>(source.headers);
+        if (prologue->type == 1) return load_image<header_32, segment_32>(source, queue);
+        else if (prologue->type == 2) return load_image<header_64, segment_64>(source, queue);
         else return {};
     }
+
+    // Relocate after segments are copied: relocation tables live in loaded memory.
+
+    // Relocation tables are read, and relocations written, through alias;
+    // tables or relocations outside the image abort.
+
+    void relocate_module ( unsigned bitness, size8 low, size8 high, size8 bias, size8 alias, size dynamic, size dynamic_size )
+    {
+        if (bias == 0 || dynamic == 0) return;
+        if (bitness == 32 && ! relocate_32(find_relocations(reinterpret_cast<dynamic_32 const *>(dynamic), dynamic_size / sizeof(dynamic_32), alias), low, high, size4(bias))) x86::abort();
+        if (bitness == 64 && ! relocate_64(find_relocations(reinterpret_cast<dynamic_64 const *>(dynamic), dynamic_size / sizeof(dynamic_64), alias), low, high, bias, alias)) x86::abort();
+    }
 }
 
 namespace multiboot2
 {
-    auto find_module ( information_list & information ) -> modules_information const *
+    auto collect_free_memory ( information_list const & information, information_index const & index ) -> bool
     {
-        modules_information const * it {};
-        for (auto i = begin(information), j = end(information); i != j; i = next(i))
-        {
-            switch (i->type)
-            {
-            case information_type::modules:
-                it = reinterpret_cast<modules_information const *>(i);
-                 break;
-            default:
-                break;
-            }
-        }
-        return it;
+        auto & memory = elf::free_memory;
+        return memory.add(information, index) && memory.add_reserved(0, 0x200000) && memory.normalize();
     }
 
-    auto load_module ( modules_information const * module ) -> module_type
+    auto validate_module ( modules_information const * module, elf::module_source & source ) -> bool
     {
-        auto elf = reinterpret_cast<elf::prologue const *>(module->start);
-        auto is_elf = (elf->mag0 == 0x7F)
-            && (elf->mag1 == 'E')
-            && (elf->mag2 == 'L')
-            && (elf->mag3 == 'F');
-        if (is_elf) {
-            size bitness = (elf->type == 1) ? 32 : ((elf->type == 2) ? 64 : 0);
-            auto [start,entry,end] = elf::load_module(module->start);
-            return { bitness, start, entry, end };
-        }
-        return {};
+        if (module->end <= module->start) return false;
+        return elf::validate_module(module->start, module->end - module->start, source);
+    }
+
+    auto load_module ( elf::module_source const & source, elf::copy_queue<> & queue ) -> module_type
+    {
+        auto elf = reinterpret_cast<elf::prologue const *>(source.headers);
+        size bitness = (elf->type == 1) ? 32 : 64;
+        auto [start,entry,end,low,high,bias,alias,dynamic,dynamic_size] = elf::load_module(source, queue);
+        return { bitness, start, entry, end, low, high, bias, alias, dynamic, dynamic_size };
+    }
+
+    void relocate_module ( module_type const & module )
+    {
+        elf::relocate_module(module.bitness, module.low, module.high, module.bias, module.alias, module.dynamic, module.dynamic_size);
     }
 }
 
@@ -294,6 +615,176 @@ namespace x86
         set_paging( extended_paging { {}, false, false, reinterpret_cast<size4>(page_map) } );
     }
 
+    // Page directory entries share one page table, aliasing the first 2 MiB everywhere;
+    // mapping a page gives its 2 MiB region, in the first GiB, a private identity page table.
+    // Frames and private page tables live in this image, below 2 MiB, where virtual is physical.
+
+    alignas(0x1000) constinit
+    long_page_table_entry private_page_tables [ 0x08 ][ 0x200 ];
+
+    constinit
+    size private_page_table_count {};
+
+    alignas(0x1000) constinit
+    size1 frames [ 0x40 ][ 0x1000 ];
+
+    constinit
+    size frame_count {};
+
+    auto available_frames () -> size
+    {
+        return sizeof(frames) / sizeof(frames[0]) - frame_count;
+    }
+
+    auto available_page_tables () -> size
+    {
+        return sizeof(private_page_tables) / sizeof(private_page_tables[0]) - private_page_table_count;
+    }
+
+    auto allocate_frame () -> size1 *
+    {
+        if (frame_count == sizeof(frames) / sizeof(frames[0])) return nullptr;
+        return frames[frame_count++];
+    }
+
+    auto map_page ( size8 address, size8 frame, bool writable ) -> bool
+    {
+        if (address >= 0x40000000) return false;
+
+        auto & directory = page_directory[(address >> 21) & 0x1FF];
+        auto const region = address & ~size8(0x1FFFFF);
+        // Identity 2 MiB pages are split like the shared page table; others are not.
+        auto const large = (reinterpret_cast<size8 const &>(directory) & 0x80) != 0;
+        if (large && reinterpret_cast<long_large_page_directory_entry const &>(directory).address() != region) return false;
+        if (large || directory.address() == reinterpret_cast<size8>(page_table))
+        {
+            if (private_page_table_count == sizeof(private_page_tables) / sizeof(private_page_tables[0])) return false;
+            auto table = private_page_tables[private_page_table_count++];
+            for (size i = 0; i != 0x200; ++i) {
+                table[i] = {
+                    true, true, true, false, false, false, false, 0, false, 0, region + (0x1000 * i), 0, false
+                };
+            }
+            directory = {
+                true, true, true, false, false, false, 0, reinterpret_cast<size8>(table), false
+            };
+            // Flush the whole region: entries were cached through the shared table.
+            for (size i = 0; i != 0x200; ++i) invlpg(size(region + (0x1000 * i)));
+        }
+
+        // Executable permission is not enforced: EFER.NXE is not enabled.
+        auto table = reinterpret_cast<long_page_table_entry *>(size(directory.address()));
+        table[(address >> 12) & 0x1FF] = {
+            true, writable, true, false, false, false, false, 0, false, 0, frame, 0, false
+        };
+        invlpg(size(address));
+        return true;
+    }
+
+    // High half: page map entry 511 and page directory pointer entry 510 give a page directory
+    // of 2 MiB pages for the 1 GiB window at 0xFFFFFFFF80000000.
+    // Placement starts from a 2 MiB slot in the first 512 MiB, chosen at first use from the time stamp counter:
+    // not a secret, but layout varies from boot to boot.
+
+    constexpr size8 high_half = 0xFFFFFFFF80000000;
+
+    alignas(0x1000) constinit
+    long_large_page_directory_entry high_page_directory [ 0x200 ];
+
+    alignas(0x1000) constinit
+    long_small_page_directory_pointer_entry high_page_directory_pointers [ 0x200 ];
+
+    constinit
+    bool randomize_high_half = true;
+
+    constinit
+    size8 next_high_half {};
+
+    auto allocate_high_half ( size8 length ) -> size8
+    {
+        if (next_high_half == 0)
+        {
+            high_page_directory_pointers[0x1FE] = {
+                true, true, true, false, false, false, 0, reinterpret_cast<size8>(high_page_directory), false
+            };
+            page_map[0x1FF] = {
+                true, true, true, false, false, false, 0, reinterpret_cast<size8>(high_page_directory_pointers), false
+            };
+            auto const slot = randomize_high_half ? rdtsc() % 0x100 : 0;
+            next_high_half = high_half + slot * 0x200000;
+        }
+
+        auto const base = next_high_half;
+        auto const aligned = (length + 0x1FFFFF) & ~size8(0x1FFFFF);
+        if (length > 0x40000000 || aligned > high_half + 0x40000000 - base) return 0;
+        next_high_half = base + aligned;
+        return base;
+    }
+
+    // Map 2 MiB pages in the first GiB, replacing the shared page table, or in the high half window.
+    // Private page tables are kept where mapping identity: they map identity too, except pages mapped in place;
+    // they are never replaced by other mappings.
+    // Executable permission is not enforced: EFER.NXE is not enabled.
+
+    auto map_large_pages ( size8 address, size8 frame, size8 length ) -> bool
+    {
+        if (((address | frame) & 0x1FFFFF) != 0) return false;
+
+        for (size8 offset = 0; offset < length; offset += 0x200000)
+        {
+            auto const page = address + offset;
+            long_large_page_directory_entry * directory {};
+            if (page + 0x200000 <= 0x40000000) {
+                auto const & entry = page_directory[(page >> 21) & 0x1FF];
+                auto const table = (reinterpret_cast<size8 const &>(entry) & 0x80) == 0 && entry.address() != reinterpret_cast<size8>(page_table);
+                if (table && frame + offset != page) return false;
+                if (table) continue;
+                directory = reinterpret_cast<long_large_page_directory_entry *>(page_directory);
+            }
+            else if (page >= high_half && next_high_half != 0) directory = high_page_directory;
+            else return false;
+            directory[(page >> 21) & 0x1FF] = {
+                true, true, true, false, false, false, false, 0, false, 0, frame + offset, 0, false
+            };
+        }
+
+        // Flush everything: 32-bit code cannot invalidate high half addresses.
+        set_paging(get_extended_paging());
+        return true;
+    }
+
+    // Direct map: memory map RAM, exactly, with 1 GiB pages if supported, otherwise 2 MiB pages,
+    // and 4 KiB pages at range edges; holes between RAM ranges, such as video memory, stay unmapped.
+    // Without 1 GiB pages, 64 page directories cover the first 64 GiB;
+    // RAM beyond the tables is left unmapped from direct_map_limit on.
+
+    constinit
+    direct_map<1, 0x40, 0x10> direct_memory {};
+
+    auto direct_map_limit () -> size8
+    {
+        return direct_memory.limit();
+    }
+
+    void install_direct_map ( multiboot2::information_index const & index )
+    {
+        using namespace multiboot2;
+
+        direct_memory.use_gigabyte_pages(has_gigabyte_pages());
+
+        if (auto const map = index.memory_map(); map != nullptr)
+        {
+            for (unsigned k = 0, n = entry_count(*map); k != n; ++k)
+            {
+                auto const & entry = entry_at(*map, k);
+                if (entry.type != memory_type::available && entry.type != memory_type::acpi_reclaimable && entry.type != memory_type::acpi_nvs) continue;
+                direct_memory.map(entry.base, entry.base + entry.length);
+            }
+        }
+
+        direct_memory.install(page_map);
+    }
+
     // operators.
 
     constinit
@@ -336,7 +827,7 @@ namespace x86
         }
     }
 
-    void trampoline_call_64 ( segment_selector segment, size target )
+    void trampoline_call_64 ( segment_selector segment, size8 target )
     {
         trampoline_target_64 = target; // #TODO: use stack
         far_call(segment, trampoline_64);
@@ -23,11 +23,13 @@ rootProject.name = "metal"
 
 // components
 
+include("acpi")
 include("pc")
 include("pc:test:cmos")
 include("pc:test:pic")
 include("pc:test:pit")
 include("pc:test:uart")
+include("pci")
 include("elf")
 include("googletest")
 include("multiboot2:foo")
@@ -40,6 +42,8 @@ include("multiboot2:test:module")
 include("multiboot2:test:start")
 include("psys")
 include("psys:start")
+include("psys:test:context")
+include("smbios")
 include("x86")
 include("x86:test:cpuid")
 include("x86:test:exceptions")
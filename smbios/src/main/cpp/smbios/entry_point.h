@@ -0,0 +1,131 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace smbios
+{
+  //! SMBIOS 2.1 entry point: anchor "_SM_"
+
+  struct [[gnu::packed]] entry_point_2
+  {
+    char      anchor [4];
+    ps::size1 checksum;
+    ps::size1 length;
+    ps::size1 major;
+    ps::size1 minor;
+    ps::size2 maximum_structure;
+    ps::size1 revision;
+    ps::size1 formatted [5];
+    char      intermediate_anchor [5];
+    ps::size1 intermediate_checksum;
+    ps::size2 table_length;
+    ps::size4 table_address;
+    ps::size2 structure_count;
+    ps::size1 bcd_revision;
+  };
+
+  //! SMBIOS 3.0 entry point: anchor "_SM3_"
+
+  struct [[gnu::packed]] entry_point_3
+  {
+    char      anchor [5];
+    ps::size1 checksum;
+    ps::size1 length;
+    ps::size1 major;
+    ps::size1 minor;
+    ps::size1 docrev;
+    ps::size1 revision;
+    ps::size1 reserved;
+    ps::size4 table_maximum;
+    ps::size8 table_address;
+  };
+
+  //! Structure table location.
+  //!
+  //! Count is zero if unknown: the table ends at the end-of-table structure or at length.
+
+  struct table_location
+  {
+    ps::size8 address;
+    ps::size4 length;
+    ps::size2 count;
+    ps::size1 major;
+    ps::size1 minor;
+  };
+
+  //! Locate structure table from a valid 2.1 or 3.0 entry point; false if invalid.
+
+  auto locate ( void const * entry_point, table_location & location ) -> bool ;
+
+  //! Find entry point in memory on 16 byte boundaries, as in the legacy BIOS area 0xF0000 to 0xFFFFF; null if none.
+  //!
+  //! Prefers a 3.0 entry point.
+
+  auto find_entry_point ( void const * memory, ps::size length ) -> void const * ;
+}
+
+//! Inline procedure definitions
+
+namespace smbios
+{
+  inline
+  auto locate ( void const * entry_point, table_location & location ) -> bool
+  {
+    auto const bytes = static_cast<ps::size1 const *>(entry_point);
+    auto const sum = [] ( ps::size1 const * i, unsigned length ) -> ps::size1 {
+      ps::size1 result = 0;
+      for (unsigned j = 0; j != length; ++j) result += i[j];
+      return result;
+    };
+
+    if (bytes[0] == '_' && bytes[1] == 'S' && bytes[2] == 'M' && bytes[3] == '3' && bytes[4] == '_')
+    {
+      auto const x = static_cast<entry_point_3 const *>(entry_point);
+      if (x->length < sizeof(entry_point_3) || sum(bytes, x->length) != 0) return false;
+      location = { x->table_address, x->table_maximum, 0, x->major, x->minor };
+      return true;
+    }
+
+    if (bytes[0] == '_' && bytes[1] == 'S' && bytes[2] == 'M' && bytes[3] == '_')
+    {
+      auto const x = static_cast<entry_point_2 const *>(entry_point);
+      if (x->length < sizeof(entry_point_2) || sum(bytes, x->length) != 0) return false;
+      auto const & y = x->intermediate_anchor;
+      if (y[0] != '_' || y[1] != 'D' || y[2] != 'M' || y[3] != 'I' || y[4] != '_' || sum(bytes + 0x10, 0x0F) != 0) return false;
+      location = { x->table_address, x->table_length, x->structure_count, x->major, x->minor };
+      return true;
+    }
+
+    return false;
+  }
+
+  inline
+  auto find_entry_point ( void const * memory, ps::size length ) -> void const *
+  {
+    auto const bytes = static_cast<ps::size1 const *>(memory);
+    void const * found = nullptr;
+    for (ps::size i = 0; i + sizeof(entry_point_3) <= length; i += 16)
+    {
+      auto const x = bytes + i;
+      if (x[0] != '_' || x[1] != 'S' || x[2] != 'M') continue;
+
+      // Bound structures and checksums to the area before locate reads them: length is read from memory.
+      table_location location;
+      if (x[3] == '3' && x[4] == '_')
+      {
+        if (x[__builtin_offsetof(entry_point_3, length)] > length - i || ! locate(x, location)) continue;
+        return x;
+      }
+      if (x[3] == '_' && found == nullptr)
+      {
+        if (i + sizeof(entry_point_2) > length || x[__builtin_offsetof(entry_point_2, length)] > length - i || ! locate(x, location)) continue;
+        found = x;
+      }
+    }
+    return found;
+  }
+}
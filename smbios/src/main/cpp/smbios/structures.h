@@ -0,0 +1,491 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <smbios/entry_point.h>
+
+import br.dev.pedrolamarao.metal.psys;
+
+//! Declarations
+
+namespace smbios
+{
+  //! Structure type.
+
+  enum class structure_type : ps::size1
+  {
+    processor              = 4,
+    cache                  = 7,
+    memory_array           = 16,
+    memory_device          = 17,
+    memory_array_address   = 19,
+    end_of_table           = 127,
+  };
+
+  //! Structure header.
+  //!
+  //! A formatted area of length bytes, including this header, is followed by a string set:
+  //! null terminated strings ending with an additional null.
+
+  struct [[gnu::packed]] header
+  {
+    ps::size1 type;
+    ps::size1 length;
+    ps::size2 handle;
+  };
+
+  //! Structure table.
+  //!
+  //! Iteration stops at the end-of-table structure, at count structures if known,
+  //! or at the first structure not fitting in length.
+
+  class table
+  {
+    ps::size1 const * _begin {};
+    ps::size1 const * _end {};
+    ps::size2          _count {};
+
+  public:
+
+    class iterator
+    {
+      ps::size1 const * _current {};
+      ps::size1 const * _end {};
+      ps::size2         _remaining {};
+
+      auto next () const -> ps::size1 const * ;
+
+      auto valid () const -> bool ;
+
+    public:
+
+      constexpr
+      iterator () = default;
+
+      iterator ( ps::size1 const * current, ps::size1 const * end, ps::size2 remaining ) ;
+
+      auto operator* () const -> header const & { return * reinterpret_cast<header const *>(_current); }
+
+      auto operator-> () const -> header const * { return reinterpret_cast<header const *>(_current); }
+
+      auto operator++ () -> iterator & ;
+
+      auto operator== ( iterator const & other ) const -> bool { return _current == other._current; }
+    };
+
+    constexpr
+    table () = default;
+
+    //! Table at memory; count is zero if unknown.
+
+    table ( void const * memory, ps::size length, ps::size2 count = 0 ) ;
+
+    auto begin () const -> iterator { return { _begin, _end, _count }; }
+
+    auto end () const -> iterator { return {}; }
+
+    //! Structure with handle, or null.
+
+    auto find ( ps::size2 handle ) const -> header const * ;
+  };
+
+  //! String at one-based index in structure string set; null if index is zero or absent.
+
+  auto string ( header const & x, ps::size1 index ) -> char const * ;
+
+  //! Processor information, from type 4.
+  //!
+  //! Speeds are in MHz; counts are zero if unknown; cache handles are 0xFFFF if absent.
+
+  struct processor
+  {
+    ps::size2    handle;
+    ps::size1    family;
+    bool         populated;
+    ps::size2    maximum_speed;
+    ps::size2    current_speed;
+    ps::size2    core_count;
+    ps::size2    thread_count;
+    ps::size2    l1_cache;
+    ps::size2    l2_cache;
+    ps::size2    l3_cache;
+    char const * socket;
+  };
+
+  //! Cache type.
+
+  enum class cache_type : ps::size1
+  {
+    other       = 1,
+    unknown     = 2,
+    instruction = 3,
+    data        = 4,
+    unified     = 5,
+  };
+
+  //! Cache information, from type 7.
+  //!
+  //! Ways is zero if unknown, ~0 if fully associative.
+
+  struct cache
+  {
+    ps::size2  handle;
+    ps::size1  level;
+    bool       enabled;
+    cache_type type;
+    ps::size8  size;
+    ps::size4  ways;
+  };
+
+  //! Physical memory array, from type 16.
+  //!
+  //! Maximum capacity is in bytes, zero if unknown.
+
+  struct memory_array
+  {
+    ps::size2 handle;
+    ps::size1 location;
+    ps::size1 use;
+    ps::size8 maximum_capacity;
+    ps::size2 devices;
+  };
+
+  //! Memory device, from type 17.
+  //!
+  //! Size is in bytes, zero if no device is installed, ~0 if unknown; speed is in MT/s, zero if unknown.
+
+  struct memory_device
+  {
+    ps::size2    handle;
+    ps::size2    array;
+    ps::size8    size;
+    ps::size1    form_factor;
+    ps::size1    type;
+    ps::size4    speed;
+    char const * locator;
+  };
+
+  //! Memory array mapped address range, from type 19.
+  //!
+  //! Addresses are in bytes; end is exclusive.
+
+  struct memory_range
+  {
+    ps::size2 handle;
+    ps::size2 array;
+    ps::size8 start;
+    ps::size8 end;
+    ps::size1 partition_width;
+  };
+
+  //! Decode structure; false if structure has another type or is too short.
+  //! @{
+
+  auto decode ( header const & x, processor & result ) -> bool ;
+
+  auto decode ( header const & x, cache & result ) -> bool ;
+
+  auto decode ( header const & x, memory_array & result ) -> bool ;
+
+  auto decode ( header const & x, memory_device & result ) -> bool ;
+
+  auto decode ( header const & x, memory_range & result ) -> bool ;
+
+  //! @}
+
+  //! Collect structures of type; returns number found, which may exceed capacity.
+
+  template <typename T>
+  auto collect ( table const & x, T * results, unsigned capacity ) -> unsigned ;
+
+  //! Total installed memory device size in bytes, ignoring devices of unknown size.
+
+  auto installed_memory ( table const & x ) -> ps::size8 ;
+}
+
+//! Inline procedure definitions
+
+namespace smbios
+{
+  namespace detail
+  {
+    // Formatted area fields may be unaligned.
+
+    template <typename T>
+    inline
+    auto field ( header const & x, unsigned offset ) -> T
+    {
+      auto const bytes = reinterpret_cast<ps::size1 const *>(& x) + offset;
+      T result = 0;
+      for (unsigned i = 0; i != sizeof(T); ++i)
+        result |= T(bytes[i]) << (i * 8);
+      return result;
+    }
+
+    inline
+    auto has ( header const & x, unsigned offset, unsigned size ) -> bool
+    {
+      return x.length >= offset + size;
+    }
+  }
+
+  inline
+  table::iterator::iterator ( ps::size1 const * current, ps::size1 const * end, ps::size2 remaining ) :
+    _current { current }, _end { end }, _remaining { remaining }
+  {
+    if (! valid()) _current = nullptr;
+  }
+
+  inline
+  auto table::iterator::next () const -> ps::size1 const *
+  {
+    auto i = _current + _current[1];
+    while (i + 1 < _end && (i[0] != 0 || i[1] != 0)) ++i;
+    return i + 2;
+  }
+
+  inline
+  auto table::iterator::valid () const -> bool
+  {
+    if (_current == nullptr) return false;
+    if (_current >= _end || ps::size(_end - _current) < sizeof(header) + 2) return false;
+    if (_current[1] < sizeof(header) || ps::size(_end - _current) < ps::size(_current[1]) + 2) return false;
+    if (next() > _end) return false;
+    return true;
+  }
+
+  inline
+  auto table::iterator::operator++ () -> iterator &
+  {
+    auto const last = operator*().type == ps::size1(structure_type::end_of_table) || _remaining == 1;
+    if (_remaining != 0) --_remaining;
+    _current = last ? nullptr : next();
+    if (! valid()) _current = nullptr;
+    return *this;
+  }
+
+  inline
+  table::table ( void const * memory, ps::size length, ps::size2 count ) :
+    _begin { static_cast<ps::size1 const *>(memory) },
+    _end { static_cast<ps::size1 const *>(memory) + length },
+    _count { count }
+  { }
+
+  inline
+  auto table::find ( ps::size2 handle ) const -> header const *
+  {
+    for (auto & x : *this)
+      if (x.handle == handle) return & x;
+    return nullptr;
+  }
+
+  inline
+  auto string ( header const & x, ps::size1 index ) -> char const *
+  {
+    if (index == 0) return nullptr;
+    auto i = reinterpret_cast<char const *>(& x) + x.length;
+    for (ps::size1 j = 1; j != index; ++j)
+    {
+      if (*i == 0) return nullptr;
+      while (*i != 0) ++i;
+      ++i;
+    }
+    return *i == 0 ? nullptr : i;
+  }
+
+  inline
+  auto decode ( header const & x, processor & result ) -> bool
+  {
+    using detail::field;
+    using detail::has;
+
+    if (x.type != ps::size1(structure_type::processor) || ! has(x, 0x1A, 6)) return false;
+
+    result = {};
+    result.handle = x.handle;
+    result.socket = string(x, field<ps::size1>(x, 0x04));
+    result.family = field<ps::size1>(x, 0x06);
+    result.maximum_speed = field<ps::size2>(x, 0x14);
+    result.current_speed = field<ps::size2>(x, 0x16);
+    result.populated = (field<ps::size1>(x, 0x18) & 0x40) != 0;
+    result.l1_cache = field<ps::size2>(x, 0x1A);
+    result.l2_cache = field<ps::size2>(x, 0x1C);
+    result.l3_cache = field<ps::size2>(x, 0x1E);
+
+    if (has(x, 0x23, 1)) result.core_count = field<ps::size1>(x, 0x23);
+    if (has(x, 0x25, 1)) result.thread_count = field<ps::size1>(x, 0x25);
+    // Counts above 255 are in the 3.0 fields.
+    if (result.core_count == 0xFF && has(x, 0x2A, 2)) result.core_count = field<ps::size2>(x, 0x2A);
+    if (result.thread_count == 0xFF && has(x, 0x2E, 2)) result.thread_count = field<ps::size2>(x, 0x2E);
+
+    return true;
+  }
+
+  inline
+  auto decode ( header const & x, cache & result ) -> bool
+  {
+    using detail::field;
+    using detail::has;
+
+    if (x.type != ps::size1(structure_type::cache) || ! has(x, 0x05, 6)) return false;
+
+    auto const configuration = field<ps::size2>(x, 0x05);
+
+    result = {};
+    result.handle = x.handle;
+    result.level = (configuration & 0x7) + 1;
+    result.enabled = (configuration & 0x80) != 0;
+    result.type = cache_type::unknown;
+
+    // Size granularity is bit 15: 64 KiB if set, otherwise 1 KiB.
+    auto const decode_size = [] ( ps::size8 value, ps::size8 mask ) -> ps::size8 {
+      auto const granularity = (value & (mask + 1)) != 0 ? ps::size8(64 * 1024) : ps::size8(1024);
+      return (value & mask) * granularity;
+    };
+
+    auto const installed = field<ps::size2>(x, 0x09);
+    if (installed == 0xFFFF && has(x, 0x17, 4))
+      result.size = decode_size(field<ps::size4>(x, 0x17), 0x7FFFFFFF);
+    else
+      result.size = decode_size(installed, 0x7FFF);
+
+    if (has(x, 0x11, 1)) result.type = cache_type(field<ps::size1>(x, 0x11));
+    if (has(x, 0x12, 1))
+    {
+      switch (field<ps::size1>(x, 0x12))
+      {
+      case 0x03: result.ways = 1; break;
+      case 0x04: result.ways = 2; break;
+      case 0x05: result.ways = 4; break;
+      case 0x06: result.ways = ~ps::size4(0); break;
+      case 0x07: result.ways = 8; break;
+      case 0x08: result.ways = 16; break;
+      case 0x09: result.ways = 12; break;
+      case 0x0A: result.ways = 24; break;
+      case 0x0B: result.ways = 32; break;
+      case 0x0C: result.ways = 48; break;
+      case 0x0D: result.ways = 64; break;
+      case 0x0E: result.ways = 20; break;
+      default:   result.ways = 0; break;
+      }
+    }
+
+    return true;
+  }
+
+  inline
+  auto decode ( header const & x, memory_array & result ) -> bool
+  {
+    using detail::field;
+    using detail::has;
+
+    if (x.type != ps::size1(structure_type::memory_array) || ! has(x, 0x0D, 2)) return false;
+
+    result = {};
+    result.handle = x.handle;
+    result.location = field<ps::size1>(x, 0x04);
+    result.use = field<ps::size1>(x, 0x05);
+    result.devices = field<ps::size2>(x, 0x0D);
+
+    // Maximum capacity is in KiB; 0x80000000 selects the extended field, in bytes.
+    auto const capacity = field<ps::size4>(x, 0x07);
+    if (capacity == 0x80000000)
+      result.maximum_capacity = has(x, 0x0F, 8) ? field<ps::size8>(x, 0x0F) : 0;
+    else
+      result.maximum_capacity = ps::size8(capacity) * 1024;
+
+    return true;
+  }
+
+  inline
+  auto decode ( header const & x, memory_device & result ) -> bool
+  {
+    using detail::field;
+    using detail::has;
+
+    if (x.type != ps::size1(structure_type::memory_device) || ! has(x, 0x04, 0x11)) return false;
+
+    result = {};
+    result.handle = x.handle;
+    result.array = field<ps::size2>(x, 0x04);
+    result.form_factor = field<ps::size1>(x, 0x0E);
+    result.locator = string(x, field<ps::size1>(x, 0x10));
+    result.type = has(x, 0x12, 1) ? field<ps::size1>(x, 0x12) : 0;
+
+    // Size is in MiB, or in KiB if bit 15 is set; 0x7FFF selects the extended field, in MiB.
+    auto const size = field<ps::size2>(x, 0x0C);
+    if (size == 0xFFFF)
+      result.size = ~ps::size8(0);
+    else if (size == 0x7FFF)
+      result.size = has(x, 0x1C, 4) ? ps::size8(field<ps::size4>(x, 0x1C) & 0x7FFFFFFF) << 20 : ~ps::size8(0);
+    else if ((size & 0x8000) != 0)
+      result.size = ps::size8(size & 0x7FFF) << 10;
+    else
+      result.size = ps::size8(size) << 20;
+
+    // Speed 0xFFFF selects the extended field.
+    if (has(x, 0x15, 2)) result.speed = field<ps::size2>(x, 0x15);
+    if (result.speed == 0xFFFF) result.speed = has(x, 0x54, 4) ? field<ps::size4>(x, 0x54) : 0;
+
+    return true;
+  }
+
+  inline
+  auto decode ( header const & x, memory_range & result ) -> bool
+  {
+    using detail::field;
+    using detail::has;
+
+    if (x.type != ps::size1(structure_type::memory_array_address) || ! has(x, 0x04, 11)) return false;
+
+    result = {};
+    result.handle = x.handle;
+    result.array = field<ps::size2>(x, 0x0C);
+    result.partition_width = field<ps::size1>(x, 0x0E);
+
+    // Addresses are in KiB, end inclusive; 0xFFFFFFFF start selects extended fields, in bytes.
+    auto const start = field<ps::size4>(x, 0x04);
+    auto const end = field<ps::size4>(x, 0x08);
+    if (start == 0xFFFFFFFF)
+    {
+      if (! has(x, 0x0F, 16)) return false;
+      result.start = field<ps::size8>(x, 0x0F);
+      result.end = field<ps::size8>(x, 0x17) + 1;
+    }
+    else
+    {
+      result.start = ps::size8(start) << 10;
+      result.end = (ps::size8(end) + 1) << 10;
+    }
+
+    return true;
+  }
+
+  template <typename T>
+  inline
+  auto collect ( table const & x, T * results, unsigned capacity ) -> unsigned
+  {
+    unsigned count = 0;
+    for (auto & structure : x)
+    {
+      T result;
+      if (! decode(structure, result)) continue;
+      if (count < capacity) results[count] = result;
+      ++count;
+    }
+    return count;
+  }
+
+  inline
+  auto installed_memory ( table const & x ) -> ps::size8
+  {
+    ps::size8 total = 0;
+    for (auto & structure : x)
+    {
+      memory_device device;
+      if (! decode(structure, device) || device.size == ~ps::size8(0)) continue;
+      total += device.size;
+    }
+    return total;
+  }
+}
@@ -0,0 +1,5 @@
+#include <smbios/entry_point.h>
+
+static_assert(sizeof(smbios::entry_point_2) == 31, "unexpected size of smbios::entry_point_2");
+
+static_assert(sizeof(smbios::entry_point_3) == 24, "unexpected size of smbios::entry_point_3");
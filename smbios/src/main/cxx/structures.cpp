@@ -0,0 +1,3 @@
+#include <smbios/structures.h>
+
+static_assert(sizeof(smbios::header) == 4, "unexpected size of smbios::header");
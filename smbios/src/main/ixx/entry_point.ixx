@@ -0,0 +1,16 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <smbios/entry_point.h>
+
+export module br.dev.pedrolamarao.metal.smbios:entry_point;
+
+export namespace smbios
+{
+    using ::smbios::entry_point_2;
+    using ::smbios::entry_point_3;
+    using ::smbios::table_location;
+    using ::smbios::locate;
+    using ::smbios::find_entry_point;
+}
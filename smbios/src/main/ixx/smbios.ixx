@@ -0,0 +1,6 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+export module br.dev.pedrolamarao.metal.smbios;
+
+export import :entry_point;
+export import :structures;
@@ -0,0 +1,24 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <smbios/structures.h>
+
+export module br.dev.pedrolamarao.metal.smbios:structures;
+
+export namespace smbios
+{
+    using ::smbios::structure_type;
+    using ::smbios::header;
+    using ::smbios::table;
+    using ::smbios::string;
+    using ::smbios::processor;
+    using ::smbios::cache_type;
+    using ::smbios::cache;
+    using ::smbios::memory_array;
+    using ::smbios::memory_device;
+    using ::smbios::memory_range;
+    using ::smbios::decode;
+    using ::smbios::collect;
+    using ::smbios::installed_memory;
+}
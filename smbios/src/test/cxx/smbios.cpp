@@ -0,0 +1,304 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.smbios;
+
+namespace
+{
+    struct builder
+    {
+        ps::size1 bytes [1024] {};
+        unsigned  size {};
+
+        void put (ps::size8 value, unsigned width)
+        {
+            for (unsigned i = 0; i != width; ++i) bytes[size++] = ps::size1(value >> (i * 8));
+        }
+
+        //! Begin structure with formatted area length; returns structure offset.
+
+        auto begin (ps::size1 type, ps::size1 length, ps::size2 handle) -> unsigned
+        {
+            auto const offset = size;
+            put(type, 1);
+            put(length, 1);
+            put(handle, 2);
+            size = offset + length;
+            return offset;
+        }
+
+        void at (unsigned structure, unsigned offset, ps::size8 value, unsigned width)
+        {
+            for (unsigned i = 0; i != width; ++i) bytes[structure + offset + i] = ps::size1(value >> (i * 8));
+        }
+
+        void strings (char const * text, unsigned length)
+        {
+            for (unsigned i = 0; i != length; ++i) bytes[size++] = text[i];
+            if (length == 0) bytes[size++] = 0;
+            bytes[size++] = 0;
+        }
+    };
+
+    void checksum (ps::size1 * bytes, unsigned length, unsigned at)
+    {
+        ps::size1 sum = 0;
+        for (unsigned i = 0; i != length; ++i) sum += bytes[i];
+        bytes[at] = ps::size1(- sum);
+    }
+
+    TEST(smbios, entry_point_3)
+    {
+        alignas(16) ps::size1 area [64] {};
+        auto const x = area + 32;
+        x[0] = '_'; x[1] = 'S'; x[2] = 'M'; x[3] = '3'; x[4] = '_';
+        x[6] = 24; x[7] = 3; x[8] = 2;
+        x[12] = 0x00; x[13] = 0x10;
+        x[16] = 0x00; x[17] = 0x00; x[18] = 0x0E; x[19] = 0x00;
+        checksum(x, 24, 5);
+
+        auto const found = smbios::find_entry_point(area, sizeof(area));
+        ASSERT_EQ(found, x);
+
+        smbios::table_location location {};
+        ASSERT_TRUE(smbios::locate(found, location));
+        ASSERT_EQ(location.address, 0xE0000);
+        ASSERT_EQ(location.length, 0x1000);
+        ASSERT_EQ(location.count, 0);
+        ASSERT_EQ(location.major, 3);
+        ASSERT_EQ(location.minor, 2);
+
+        x[9] ^= 1;
+        ASSERT_FALSE(smbios::locate(found, location));
+        ASSERT_EQ(smbios::find_entry_point(area, sizeof(area)), nullptr);
+    }
+
+    TEST(smbios, entry_point_2)
+    {
+        alignas(16) ps::size1 x [32] {};
+        x[0] = '_'; x[1] = 'S'; x[2] = 'M'; x[3] = '_';
+        x[5] = 31; x[6] = 2; x[7] = 8;
+        x[16] = '_'; x[17] = 'D'; x[18] = 'M'; x[19] = 'I'; x[20] = '_';
+        x[22] = 0x34; x[23] = 0x02;
+        x[24] = 0x00; x[25] = 0x00; x[26] = 0x0F; x[27] = 0x00;
+        x[28] = 9;
+        x[30] = 0x28;
+        // Intermediate checksum covers bytes 0x10 to 0x1E.
+        checksum(x + 16, 15, 5);
+        checksum(x, 31, 4);
+
+        smbios::table_location location {};
+        ASSERT_TRUE(smbios::locate(x, location));
+        ASSERT_EQ(location.address, 0xF0000);
+        ASSERT_EQ(location.length, 0x234);
+        ASSERT_EQ(location.count, 9);
+        ASSERT_EQ(location.major, 2);
+        ASSERT_EQ(location.minor, 8);
+
+        x[17] = 'X';
+        ASSERT_FALSE(smbios::locate(x, location));
+    }
+
+    TEST(smbios, entry_point_bounds)
+    {
+        // 2.1 entry points near the end of the area: one with a length byte past the area,
+        // one whose structure does not fit.
+        alignas(16) ps::size1 area [64] {};
+        auto const x = area + 32;
+        x[0] = '_'; x[1] = 'S'; x[2] = 'M'; x[3] = '_';
+        x[5] = 31; x[6] = 2; x[7] = 8;
+        x[16] = '_'; x[17] = 'D'; x[18] = 'M'; x[19] = 'I'; x[20] = '_';
+        checksum(x + 16, 15, 5);
+        checksum(x, 31, 4);
+        ASSERT_EQ(smbios::find_entry_point(area, sizeof(area)), x);
+
+        x[5] = 0xFF;
+        ASSERT_EQ(smbios::find_entry_point(area, sizeof(area)), nullptr);
+
+        auto const y = area + 48;
+        y[0] = '_'; y[1] = 'S'; y[2] = 'M'; y[3] = '_';
+        y[5] = 16;
+        ASSERT_EQ(smbios::find_entry_point(area, sizeof(area)), nullptr);
+    }
+
+    TEST(smbios, structures)
+    {
+        builder b;
+
+        // processor: socket "CPU0", populated, 3000/2400 MHz, 300 cores and threads via 3.0 fields
+        auto const p = b.begin(4, 0x30, 0x0400);
+        b.at(p, 0x04, 1, 1);
+        b.at(p, 0x06, 0xC6, 1);
+        b.at(p, 0x14, 3000, 2);
+        b.at(p, 0x16, 2400, 2);
+        b.at(p, 0x18, 0x41, 1);
+        b.at(p, 0x1A, 0x0700, 2);
+        b.at(p, 0x1C, 0x0701, 2);
+        b.at(p, 0x1E, 0xFFFF, 2);
+        b.at(p, 0x23, 0xFF, 1);
+        b.at(p, 0x25, 0xFF, 1);
+        b.at(p, 0x2A, 300, 2);
+        b.at(p, 0x2E, 300, 2);
+        b.strings("CPU0\0", 5);
+
+        // cache: L1 data, 48 KiB, 12 ways, enabled
+        auto const c1 = b.begin(7, 0x1B, 0x0700);
+        b.at(c1, 0x05, 0x0080, 2);
+        b.at(c1, 0x09, 48, 2);
+        b.at(c1, 0x11, 4, 1);
+        b.at(c1, 0x12, 0x09, 1);
+        b.strings("", 0);
+
+        // cache: L2 unified, 2 MiB in 64 KiB granularity via extended field, fully associative
+        auto const c2 = b.begin(7, 0x1B, 0x0701);
+        b.at(c2, 0x05, 0x0081, 2);
+        b.at(c2, 0x09, 0xFFFF, 2);
+        b.at(c2, 0x11, 5, 1);
+        b.at(c2, 0x12, 0x06, 1);
+        b.at(c2, 0x17, 0x80000020, 4);
+        b.strings("", 0);
+
+        // memory array: 2 devices, extended maximum capacity 8 TiB
+        auto const a = b.begin(16, 0x17, 0x1000);
+        b.at(a, 0x04, 3, 1);
+        b.at(a, 0x05, 3, 1);
+        b.at(a, 0x07, 0x80000000, 4);
+        b.at(a, 0x0D, 2, 2);
+        b.at(a, 0x0F, 0x80000000000, 8);
+        b.strings("", 0);
+
+        // memory device: "DIMM0", 16 GiB, 4800 MT/s
+        auto const d0 = b.begin(17, 0x28, 0x1100);
+        b.at(d0, 0x04, 0x1000, 2);
+        b.at(d0, 0x0C, 16384, 2);
+        b.at(d0, 0x0E, 0x09, 1);
+        b.at(d0, 0x10, 2, 1);
+        b.at(d0, 0x12, 0x22, 1);
+        b.at(d0, 0x15, 4800, 2);
+        b.strings("BANK 0\0DIMM0\0", 13);
+
+        // memory device: 64 GiB via extended size, extended speed 70000 MT/s
+        auto const d1 = b.begin(17, 0x5C, 0x1101);
+        b.at(d1, 0x04, 0x1000, 2);
+        b.at(d1, 0x0C, 0x7FFF, 2);
+        b.at(d1, 0x15, 0xFFFF, 2);
+        b.at(d1, 0x1C, 65536, 4);
+        b.at(d1, 0x54, 70000, 4);
+        b.strings("", 0);
+
+        // memory device: empty slot
+        auto const d2 = b.begin(17, 0x28, 0x1102);
+        b.at(d2, 0x04, 0x1000, 2);
+        b.strings("", 0);
+
+        // mapped range: [0, 2 GiB) in KiB
+        auto const r0 = b.begin(19, 0x1F, 0x1300);
+        b.at(r0, 0x04, 0, 4);
+        b.at(r0, 0x08, 0x1FFFFF, 4);
+        b.at(r0, 0x0C, 0x1000, 2);
+        b.at(r0, 0x0E, 2, 1);
+        b.strings("", 0);
+
+        // mapped range: [4 TiB, 4 TiB + 78 GiB) via extended fields
+        auto const r1 = b.begin(19, 0x1F, 0x1301);
+        b.at(r1, 0x04, 0xFFFFFFFF, 4);
+        b.at(r1, 0x08, 0xFFFFFFFF, 4);
+        b.at(r1, 0x0C, 0x1000, 2);
+        b.at(r1, 0x0F, 0x40000000000, 8);
+        b.at(r1, 0x17, 0x40000000000 + 0x1380000000 - 1, 8);
+        b.strings("", 0);
+
+        b.begin(127, 4, 0xFEFF);
+        b.strings("", 0);
+
+        // Trailing bytes after end of table are ignored.
+        b.begin(17, 0x28, 0x1103);
+        b.strings("", 0);
+
+        smbios::table table { b.bytes, b.size };
+
+        unsigned count = 0;
+        for (auto & x : table) { (void) x; ++count; }
+        ASSERT_EQ(count, 10);
+
+        ASSERT_NE(table.find(0x0701), nullptr);
+        ASSERT_EQ(table.find(0x0701)->type, 7);
+        ASSERT_EQ(table.find(0x1103), nullptr);
+
+        smbios::processor processors [2] {};
+        ASSERT_EQ(smbios::collect(table, processors, 2), 1);
+        ASSERT_EQ(processors[0].family, 0xC6);
+        ASSERT_TRUE(processors[0].populated);
+        ASSERT_EQ(processors[0].maximum_speed, 3000);
+        ASSERT_EQ(processors[0].current_speed, 2400);
+        ASSERT_EQ(processors[0].core_count, 300);
+        ASSERT_EQ(processors[0].thread_count, 300);
+        ASSERT_EQ(processors[0].l1_cache, 0x0700);
+        ASSERT_EQ(processors[0].l3_cache, 0xFFFF);
+        ASSERT_STREQ(processors[0].socket, "CPU0");
+
+        smbios::cache caches [1] {};
+        ASSERT_EQ(smbios::collect(table, caches, 1), 2);
+        ASSERT_EQ(caches[0].level, 1);
+        ASSERT_TRUE(caches[0].enabled);
+        ASSERT_EQ(caches[0].type, smbios::cache_type::data);
+        ASSERT_EQ(caches[0].size, 48 * 1024);
+        ASSERT_EQ(caches[0].ways, 12);
+
+        smbios::cache l2 {};
+        ASSERT_TRUE(smbios::decode(* table.find(0x0701), l2));
+        ASSERT_EQ(l2.level, 2);
+        ASSERT_EQ(l2.type, smbios::cache_type::unified);
+        ASSERT_EQ(l2.size, 2 * 1024 * 1024);
+        ASSERT_EQ(l2.ways, ~ps::size4(0));
+
+        smbios::memory_array arrays [1] {};
+        ASSERT_EQ(smbios::collect(table, arrays, 1), 1);
+        ASSERT_EQ(arrays[0].devices, 2);
+        ASSERT_EQ(arrays[0].maximum_capacity, 0x80000000000);
+
+        smbios::memory_device devices [4] {};
+        ASSERT_EQ(smbios::collect(table, devices, 4), 3);
+        ASSERT_EQ(devices[0].size, ps::size8(16) << 30);
+        ASSERT_EQ(devices[0].speed, 4800);
+        ASSERT_EQ(devices[0].type, 0x22);
+        ASSERT_STREQ(devices[0].locator, "DIMM0");
+        ASSERT_EQ(devices[1].size, ps::size8(64) << 30);
+        ASSERT_EQ(devices[1].speed, 70000);
+        ASSERT_EQ(devices[1].locator, nullptr);
+        ASSERT_EQ(devices[2].size, 0);
+        ASSERT_EQ(smbios::installed_memory(table), ps::size8(80) << 30);
+
+        smbios::memory_range ranges [2] {};
+        ASSERT_EQ(smbios::collect(table, ranges, 2), 2);
+        ASSERT_EQ(ranges[0].start, 0);
+        ASSERT_EQ(ranges[0].end, 0x80000000);
+        ASSERT_EQ(ranges[0].partition_width, 2);
+        ASSERT_EQ(ranges[1].start, 0x40000000000);
+        ASSERT_EQ(ranges[1].end, 0x40000000000 + 0x1380000000);
+    }
+
+    TEST(smbios, truncated)
+    {
+        builder b;
+        auto const d = b.begin(17, 0x28, 0x1100);
+        b.at(d, 0x0C, 1024, 2);
+        b.strings("DIMM0\0", 6);
+
+        // Count bounds iteration.
+        smbios::table counted { b.bytes, b.size + 8, 1 };
+        unsigned count = 0;
+        for (auto & x : counted) { (void) x; ++count; }
+        ASSERT_EQ(count, 1);
+
+        // String set without terminator ends iteration.
+        smbios::table truncated { b.bytes, b.size - 1 };
+        ASSERT_EQ(truncated.begin(), truncated.end());
+
+        // Formatted area too short for memory device.
+        b.bytes[1] = 0x0C;
+        smbios::table short_ { b.bytes, b.size };
+        smbios::memory_device device {};
+        ASSERT_FALSE(smbios::decode(* short_.begin(), device));
+    }
+}
@@ -1,4 +1,4 @@
-// Copyright (C) 2015,2016 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+// Copyright (C) 2015,2016,2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
 
 #pragma once
 
@@ -9,7 +9,7 @@ namespace x86
 {
 	struct apic_location
 	{
-		ps::size4 value;
+		ps::size4 volatile value;
 		ps::size4 unused0;
 		ps::size4 unused1;
 		ps::size4 unused2;
@@ -17,7 +17,7 @@ namespace x86
 
 	struct apic_r_location : public apic_location
 	{
-		constexpr explicit operator ps::size4 () const { return value; }
+		explicit operator ps::size4 () const { return value; }
 	};
 
 	struct apic_w_location : public apic_location
@@ -27,7 +27,7 @@ namespace x86
 
 	struct apic_rw_location : public apic_location
 	{
-		constexpr explicit operator ps::size4 () const { return value; }
+		explicit operator ps::size4 () const { return value; }
 
 		auto operator= (ps::size4 x) -> apic_rw_location & { value = x; return *this; }
 	};
@@ -42,31 +42,58 @@ namespace x86
 		apic_location reserved_03;
 		apic_location reserved_04;
 		apic_location reserved_05;
-		apic_location task_priority;
-		apic_location arbitration_priority;
-		apic_location processor_priority;
-		apic_location eoi;
-		apic_location remote_read;
-		apic_location logical_destination;
-		apic_location destination_format;
-		apic_location spurious_interrupt_vector;
+		apic_rw_location task_priority;
+		apic_r_location arbitration_priority;
+		apic_r_location processor_priority;
+		apic_w_location eoi;
+		apic_r_location remote_read;
+		apic_rw_location logical_destination;
+		apic_rw_location destination_format;
+		apic_rw_location spurious_interrupt_vector;
+		apic_r_location in_service [8];
+		apic_r_location trigger_mode [8];
+		apic_r_location interrupt_request [8];
+		apic_r_location error_status;
+		apic_location reserved_06 [6];
+		apic_rw_location lvt_cmci;
+		apic_rw_location interrupt_command_low;
+		apic_rw_location interrupt_command_high;
+		apic_rw_location lvt_timer;
+		apic_rw_location lvt_thermal;
+		apic_rw_location lvt_performance;
+		apic_rw_location lvt_lint0;
+		apic_rw_location lvt_lint1;
+		apic_rw_location lvt_error;
+		apic_rw_location timer_initial_count;
+		apic_r_location timer_current_count;
+		apic_location reserved_07 [4];
+		apic_rw_location timer_divide;
+		apic_location reserved_08;
 	};
 
-	constexpr inline
+	//! Test if this processor has a local APIC.
+
+	inline
 	auto has_apic () -> bool
 	{
-		return false;
+		return has_local_apic();
 	}
 
+	//! Test if local APIC is enabled, given the APIC_BASE model-specific register.
+
 	constexpr inline
 	auto is_apic_enabled (ps::size8 location) -> bool
 	{
-		return false;
+		return (location & (1 << 11)) != 0;
 	}
 
-	constexpr inline
+	//! Get local APIC memory map, given the APIC_BASE model-specific register.
+	//!
+	//! Assumes the local APIC page is identity mapped.
+
+	inline
 	auto get_apic_memory_map (ps::size8 location) -> apic_memory_map *
 	{
-		return nullptr;
+		return reinterpret_cast<apic_memory_map *>(static_cast<ps::size>(location & 0xFFFFFFFFFF000));
 	}
 }
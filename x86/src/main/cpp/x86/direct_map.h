@@ -0,0 +1,191 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <x86/pages.h>
+
+
+// Interface.
+
+namespace x86
+{
+    //! Direct map base: physical address zero, in the upper half of the long mode address space.
+
+    constexpr size8 direct_map_base = 0xFFFF800000000000;
+
+    //! Direct map address of physical address.
+
+    constexpr
+    auto phys_to_virt ( size8 physical ) -> size8;
+
+    //! Physical address of direct map address.
+
+    constexpr
+    auto virt_to_phys ( size8 virtual_address ) -> size8;
+
+    //! Direct map of physical memory at direct_map_base, with tables owned by this object.
+    //!
+    //! Each page map entry covers 512 GiB with one page directory pointer table.
+    //! Ranges are mapped exactly, to 4 KiB: with the largest page that fits inside the range,
+    //! 1 GiB if enabled, then 2 MiB, then 4 KiB; memory outside every range stays unmapped.
+    //! Tables must live where virtual is physical: entries hold their addresses.
+
+    template <unsigned Pointers = 1, unsigned Directories = 4, unsigned Tables = 4>
+    class direct_map
+    {
+        static_assert(Pointers <= 0x100, "direct map exceeds the upper half");
+
+        alignas(0x1000) long_small_page_directory_pointer_entry _pointers [Pointers][0x200] {};
+        alignas(0x1000) long_small_page_directory_entry _directories [Directories][0x200] {};
+        alignas(0x1000) long_page_table_entry _tables [Tables][0x200] {};
+        unsigned _pointer_count {};
+        unsigned _directory_count {};
+        unsigned _table_count {};
+        size8    _limit { ~size8(0) };
+        bool     _gigabyte;
+
+    public:
+
+        //! Direct map with 1 GiB pages if gigabyte, 2 MiB pages otherwise.
+
+        constexpr explicit
+        direct_map ( bool gigabyte = false ) : _gigabyte { gigabyte } { }
+
+        direct_map ( direct_map const & ) = delete;
+
+        //! Use 1 GiB pages if gigabyte, 2 MiB pages otherwise; false if some range is already mapped.
+
+        auto use_gigabyte_pages ( bool gigabyte ) -> bool
+        {
+            if (_pointer_count != 0) return false;
+            _gigabyte = gigabyte;
+            return true;
+        }
+
+        //! Largest page size.
+
+        auto page_size () const -> size8 { return _gigabyte ? 0x40000000 : 0x200000; }
+
+        //! Lowest physical address left unmapped for lack of tables; all ones if none.
+
+        auto limit () const -> size8 { return _limit; }
+
+        auto directory_count () const -> unsigned { return _directory_count; }
+
+        auto table_count () const -> unsigned { return _table_count; }
+
+        //! Map physical range from begin to end, widened to 4 KiB boundaries; false if out of tables.
+        //!
+        //! Ranges may overlap ranges already mapped.
+        //! Out of tables, pages from limit on are left unmapped.
+
+        auto map ( size8 begin, size8 end ) -> bool;
+
+        //! Install page map entries from direct_map_base.
+
+        void install ( long_page_map_entry * page_map ) const;
+    };
+}
+
+// Definitions.
+
+namespace x86
+{
+    constexpr inline
+    auto phys_to_virt ( size8 physical ) -> size8
+    {
+        return physical + direct_map_base;
+    }
+
+    constexpr inline
+    auto virt_to_phys ( size8 virtual_address ) -> size8
+    {
+        return virtual_address - direct_map_base;
+    }
+
+    namespace internal
+    {
+        // Entry maps a page instead of pointing to a table.
+
+        template <typename Entry>
+        auto is_large_page ( Entry const & entry ) -> bool
+        {
+            return (reinterpret_cast<size8 const &>(entry) & 0x81) == 0x81;
+        }
+    }
+
+    template <unsigned Pointers, unsigned Directories, unsigned Tables>
+    auto direct_map<Pointers, Directories, Tables>::map ( size8 begin, size8 end ) -> bool
+    {
+        constexpr size8 giga = 0x40000000, mega = 0x200000, kilo = 0x1000;
+
+        auto const fail = [&] ( size8 physical ) -> bool
+        {
+            if (physical < _limit) _limit = physical;
+            return false;
+        };
+
+        end = (end + kilo - 1) & ~(kilo - 1);
+        for (auto physical = begin & ~(kilo - 1); physical < end; )
+        {
+            auto const table = physical >> 39;
+            if (table >= Pointers) return fail(physical);
+            if (table >= _pointer_count) _pointer_count = unsigned(table + 1);
+
+            auto & pointer = _pointers[table][(physical >> 30) & 0x1FF];
+            if (internal::is_large_page(pointer)) {
+                physical = (physical | (giga - 1)) + 1;
+                continue;
+            }
+            if (_gigabyte && ! pointer.present() && (physical & (giga - 1)) == 0 && end - physical >= giga) {
+                reinterpret_cast<long_large_page_directory_pointer_entry &>(pointer) = {
+                    true, true, false, false, false, false, false, 0, false, 0, physical, 0, false
+                };
+                physical += giga;
+                continue;
+            }
+            if (! pointer.present()) {
+                if (_directory_count == Directories) return fail(physical);
+                pointer = {
+                    true, true, false, false, false, false, 0, size8(reinterpret_cast<size>(_directories[_directory_count++])), false
+                };
+            }
+
+            auto & directory = reinterpret_cast<long_small_page_directory_entry *>(size(pointer.address()))[(physical >> 21) & 0x1FF];
+            if (internal::is_large_page(directory)) {
+                physical = (physical | (mega - 1)) + 1;
+                continue;
+            }
+            if (! directory.present() && (physical & (mega - 1)) == 0 && end - physical >= mega) {
+                reinterpret_cast<long_large_page_directory_entry &>(directory) = {
+                    true, true, false, false, false, false, false, 0, false, 0, physical, 0, false
+                };
+                physical += mega;
+                continue;
+            }
+            if (! directory.present()) {
+                if (_table_count == Tables) return fail(physical);
+                directory = {
+                    true, true, false, false, false, false, 0, size8(reinterpret_cast<size>(_tables[_table_count++])), false
+                };
+            }
+
+            reinterpret_cast<long_page_table_entry *>(size(directory.address()))[(physical >> 12) & 0x1FF] = {
+                true, true, false, false, false, false, false, 0, false, 0, physical, 0, false
+            };
+            physical += kilo;
+        }
+        return true;
+    }
+
+    template <unsigned Pointers, unsigned Directories, unsigned Tables>
+    void direct_map<Pointers, Directories, Tables>::install ( long_page_map_entry * page_map ) const
+    {
+        auto const first = (direct_map_base >> 39) & 0x1FF;
+        for (unsigned i = 0; i != _pointer_count; ++i) {
+            page_map[first + i] = {
+                true, true, false, false, false, false, 0, size8(reinterpret_cast<size>(_pointers[i])), false
+            };
+        }
+    }
+}
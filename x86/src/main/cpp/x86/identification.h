@@ -37,6 +37,39 @@ namespace x86
         return (cpuid(0x80000001).d & (1 << 29)) != 0;
     }
 
+    //! Test if this processor supports 1 GiB pages in long mode.
+
+    inline
+    auto has_gigabyte_pages () -> bool
+    {
+        return cpuid(0x80000000).a >= 0x80000001 && (cpuid(0x80000001).d & (1 << 26)) != 0;
+    }
+
+    //! Test if this processor has MONITOR and MWAIT instructions.
+
+    inline
+    auto has_monitor () -> bool
+    {
+        return (cpuid(1).c & (1 << 3)) != 0;
+    }
+
+    //! Test if MWAIT may break on interrupts while interrupts are disabled.
+
+    inline
+    auto has_mwait_interrupt_break () -> bool
+    {
+        return cpuid(0).a >= 5 && (cpuid(5).c & 0x3) == 0x3;
+    }
+
+    //! Count MWAIT sub-states of C-state, from zero for C0 up to seven; zero if not enumerated.
+
+    inline
+    auto mwait_substates ( unsigned cstate ) -> unsigned
+    {
+        if (cstate > 7 || cpuid(0).a < 5 || (cpuid(5).c & 0x1) == 0) return 0;
+        return (cpuid(5).d >> (cstate * 4)) & 0xF;
+    }
+
     //! Test if this processor has model-specific registers.
 
     inline
@@ -49,6 +49,18 @@ namespace x86
 
     auto in4 ( size2 port ) -> size4;
 
+    //! Invalidate translation lookaside buffer entries for page containing address.
+
+    void invlpg ( size address );
+
+    //! Arm address monitoring hardware on the cache line containing address.
+
+    void monitor ( void const * address, size4 extensions = 0, size4 hints = 0 );
+
+    //! Wait for a store to the monitored address, or an interrupt, in the C-state requested by hint.
+
+    void mwait ( size4 hint, size4 extensions = 0 );
+
     //! Write to I/O port.
 
     void out1 ( size2 port, size1 data );
@@ -69,6 +81,14 @@ namespace x86
 
     auto rdmsr (size4 id) -> size8;
 
+    //! Read time-stamp counter.
+
+    auto rdtsc () -> size8;
+
+    //! Write back and invalidate all caches.
+
+    void wbinvd ();
+
     //! Write to model-specific register.
 
     void wrmsr (size4 id, size8 value);
@@ -187,6 +187,14 @@ namespace x86
 
     void disable_interrupts ();
 
+    //! Enable interrupts and halt this processor, without an interrupt window in between.
+
+    void enable_interrupts_and_halt ();
+
+    //! Enable interrupts and wait on the armed monitor, without an interrupt window in between.
+
+    void enable_interrupts_and_mwait ( size4 hint, size4 extensions = 0 );
+
     //! Interrupt this processor.
 
     template <unsigned N>
@@ -0,0 +1,496 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <x86/apic.h>
+#include <x86/instructions.h>
+#include <x86/registers.h>
+
+
+// Interface.
+
+namespace x86
+{
+    //! Interprocessor interrupt delivery mode.
+
+    enum class ipi_delivery : size1
+    {
+        fixed           = 0,
+        lowest_priority = 1,
+        smi             = 2,
+        nmi             = 4,
+        init            = 5,
+        startup         = 6,
+    };
+
+    //! Interprocessor interrupt destination shorthand.
+
+    enum class ipi_shorthand : size1
+    {
+        none         = 0,
+        self         = 1,
+        all          = 2,
+        all_but_self = 3,
+    };
+
+    //! Interrupt command register, low half.
+
+    constexpr
+    auto interrupt_command (size1 vector, ipi_delivery delivery, ipi_shorthand shorthand) -> size4;
+
+    //! Send interprocessor interrupt to processor with APIC id, or to shorthand destination.
+
+    void send_ipi (apic_memory_map & apic, size1 destination, size4 command);
+
+    //! Set of processors, by index.
+
+    class cpu_set
+    {
+    public:
+
+        static constexpr unsigned capacity = 64;
+
+        constexpr
+        cpu_set () = default;
+
+        constexpr explicit
+        cpu_set (unsigned long long bits) : _bits { bits } { }
+
+        constexpr
+        auto bits () const -> unsigned long long { return _bits; }
+
+        constexpr
+        auto contains (unsigned index) const -> bool { return index < capacity && (_bits & (1ULL << index)) != 0; }
+
+        constexpr
+        auto empty () const -> bool { return _bits == 0; }
+
+        constexpr
+        auto count () const -> unsigned { return __builtin_popcountll(_bits); }
+
+        constexpr
+        void add (unsigned index) { if (index < capacity) _bits |= 1ULL << index; }
+
+        constexpr
+        void remove (unsigned index) { if (index < capacity) _bits &= ~(1ULL << index); }
+
+        constexpr
+        auto operator== (cpu_set const &) const -> bool = default;
+
+    private:
+
+        unsigned long long _bits {};
+    };
+
+    //! Set containing only processor with index.
+
+    constexpr
+    auto only (unsigned index) -> cpu_set;
+
+    //! Set containing processors with index less than count.
+
+    constexpr
+    auto first (unsigned count) -> cpu_set;
+
+    //! Interprocessor interrupt controller.
+    //!
+    //! Processors are identified by index, assigned in order of registration.
+    //! Handlers for the call and shootdown vectors must invoke on_call and on_shootdown;
+    //! these signal end of interrupt.
+    //! Initiators spin until targets acknowledge; they must run with interrupts enabled,
+    //! otherwise two concurrent initiators may wait on each other forever.
+
+    class ipi_controller
+    {
+    public:
+
+        //! Procedure called on target processors.
+
+        using function_type = void (*) (void *);
+
+        //! Maximum page ranges batched per target before falling back to a complete flush.
+
+        static constexpr unsigned batch_capacity = 16;
+
+        //! Maximum pages invalidated one by one before falling back to a complete flush.
+
+        static constexpr unsigned flush_threshold = 32;
+
+        //! Page size.
+
+        static constexpr size page_size = 0x1000;
+
+        //! Page range.
+
+        struct page_range
+        {
+            size     address;
+            unsigned pages;
+        };
+
+    private:
+
+        struct batch
+        {
+            page_range ranges [batch_capacity];
+            unsigned   count;
+            unsigned   pages;
+            bool       complete;
+        };
+
+        static constexpr size1 unknown = 0xFF;
+
+        apic_memory_map *  _apic {};
+        size1              _call_vector {};
+        size1              _shootdown_vector {};
+
+        size1              _apic_ids [cpu_set::capacity] {};
+        size1              _indices [256] {};
+        unsigned           _count {};
+
+        ps::spin_lock      _call_lock {};
+        function_type      _call_function {};
+        void *             _call_argument {};
+        unsigned long long _call_pending {};
+
+        ps::spin_lock      _shootdown_lock {};
+        batch              _batches [cpu_set::capacity] {};
+        unsigned           _shootdown_pending {};
+
+    public:
+
+        //! Object.
+        //! @{
+
+        ipi_controller (apic_memory_map & apic, size1 call_vector, size1 shootdown_vector);
+
+        ipi_controller (ipi_controller const &) = delete;
+
+        //! @}
+
+        //! Processors.
+        //! @{
+
+        //! Register processor with APIC id; returns its index, or capacity if full.
+
+        auto add (size1 apic_id) -> unsigned;
+
+        //! Registered processors.
+
+        auto all () const -> cpu_set { return first(_count); }
+
+        //! Number of registered processors.
+
+        auto count () const -> unsigned { return _count; }
+
+        //! Index of this processor.
+
+        auto current () const -> unsigned;
+
+        //! APIC id of processor with index; 0xFF if index is not registered.
+
+        auto apic_id (unsigned index) const -> size1 { return index < _count ? _apic_ids[index] : unknown; }
+
+        //! @}
+
+        //! Interrupts.
+        //! @{
+
+        //! Send fixed interrupt to processor with index; ignores unregistered index.
+
+        void send (unsigned index, size1 vector);
+
+        //! Send fixed interrupt to all processors.
+
+        void send_all (size1 vector);
+
+        //! Send fixed interrupt to all processors except this one.
+
+        void send_all_but_self (size1 vector);
+
+        //! Send fixed interrupt to every processor in set, broadcasting when possible.
+
+        void send (cpu_set targets, size1 vector);
+
+        //! Signal end of interrupt.
+
+        void eoi () { _apic->eoi = 0; }
+
+        //! @}
+
+        //! Function calls.
+        //! @{
+
+        //! Call function on every processor in set, including this one; returns after all completed.
+
+        void call (cpu_set targets, function_type function, void * argument);
+
+        //! Handle call interrupt.
+
+        void on_call ();
+
+        //! @}
+
+        //! TLB shootdown.
+        //! @{
+
+        //! Begin shootdown; subsequent invalidations are batched per target until commit.
+
+        void begin_shootdown () { _shootdown_lock.lock(); }
+
+        //! Add page range to the batch of every processor in set.
+
+        void invalidate (cpu_set targets, size address, unsigned pages);
+
+        //! Send one interrupt per target with pending invalidations; returns after all acknowledged.
+
+        void commit_shootdown ();
+
+        //! Invalidate page range on every processor in set.
+
+        void shootdown (cpu_set targets, size address, unsigned pages);
+
+        //! Handle shootdown interrupt.
+
+        void on_shootdown ();
+
+        //! Pending invalidations for processor with index.
+
+        auto pending (unsigned index) const -> unsigned { return _batches[index].count; }
+
+        //! @}
+
+    private:
+
+        void flush (batch & target);
+    };
+}
+
+// Definitions.
+
+namespace x86
+{
+    constexpr inline
+    auto interrupt_command (size1 vector, ipi_delivery delivery, ipi_shorthand shorthand) -> size4
+    {
+        // Level assert, edge triggered, physical destination.
+        return size4{vector}
+             | (size4(delivery) & 7) << 8
+             | size4{1} << 14
+             | (size4(shorthand) & 3) << 18;
+    }
+
+    inline
+    void send_ipi (apic_memory_map & apic, size1 destination, size4 command)
+    {
+        while ((size4(apic.interrupt_command_low) & (1 << 12)) != 0)
+            pause();
+        apic.interrupt_command_high = size4{destination} << 24;
+        apic.interrupt_command_low = command;
+    }
+
+    constexpr inline
+    auto only (unsigned index) -> cpu_set
+    {
+        return cpu_set { 1ULL << index };
+    }
+
+    constexpr inline
+    auto first (unsigned count) -> cpu_set
+    {
+        return cpu_set { count >= cpu_set::capacity ? ~0ULL : (1ULL << count) - 1 };
+    }
+
+    inline
+    ipi_controller::ipi_controller (apic_memory_map & apic, size1 call_vector, size1 shootdown_vector) :
+        _apic { & apic },
+        _call_vector { call_vector },
+        _shootdown_vector { shootdown_vector }
+    {
+        for (auto & index : _indices) index = unknown;
+    }
+
+    inline
+    auto ipi_controller::add (size1 apic_id) -> unsigned
+    {
+        if (_indices[apic_id] != unknown) return _indices[apic_id];
+        if (_count == cpu_set::capacity) return cpu_set::capacity;
+        _apic_ids[_count] = apic_id;
+        _indices[apic_id] = _count;
+        return _count++;
+    }
+
+    inline
+    auto ipi_controller::current () const -> unsigned
+    {
+        return _indices[(size4(_apic->id) >> 24) & 0xFF];
+    }
+
+    inline
+    void ipi_controller::send (unsigned index, size1 vector)
+    {
+        if (index >= _count) return;
+        send_ipi(*_apic, _apic_ids[index], interrupt_command(vector, ipi_delivery::fixed, ipi_shorthand::none));
+    }
+
+    inline
+    void ipi_controller::send_all (size1 vector)
+    {
+        send_ipi(*_apic, 0, interrupt_command(vector, ipi_delivery::fixed, ipi_shorthand::all));
+    }
+
+    inline
+    void ipi_controller::send_all_but_self (size1 vector)
+    {
+        send_ipi(*_apic, 0, interrupt_command(vector, ipi_delivery::fixed, ipi_shorthand::all_but_self));
+    }
+
+    inline
+    void ipi_controller::send (cpu_set targets, size1 vector)
+    {
+        auto const self = current();
+        auto others = all();
+        if (self != unknown) others.remove(self);
+        if (targets == others && ! others.empty()) {
+            send_all_but_self(vector);
+            return;
+        }
+        for (auto bits = targets.bits(); bits != 0; bits &= bits - 1)
+            send(__builtin_ctzll(bits), vector);
+    }
+
+    inline
+    void ipi_controller::call (cpu_set targets, function_type function, void * argument)
+    {
+        ps::lock_guard guard { _call_lock };
+
+        // Unregistered processors would never acknowledge.
+        targets = cpu_set { targets.bits() & all().bits() };
+
+        auto const self = current();
+        auto others = targets;
+        if (self != unknown) others.remove(self);
+
+        _call_function = function;
+        _call_argument = argument;
+        __atomic_store_n(&_call_pending, others.bits(), __ATOMIC_RELEASE);
+
+        send(others, _call_vector);
+
+        if (self != unknown && targets.contains(self))
+            function(argument);
+
+        while (__atomic_load_n(&_call_pending, __ATOMIC_ACQUIRE) != 0)
+            pause();
+    }
+
+    inline
+    void ipi_controller::on_call ()
+    {
+        auto const self = current();
+        if (self != unknown && (__atomic_load_n(&_call_pending, __ATOMIC_ACQUIRE) & (1ULL << self)) != 0)
+        {
+            _call_function(_call_argument);
+            __atomic_fetch_and(&_call_pending, ~(1ULL << self), __ATOMIC_RELEASE);
+        }
+        eoi();
+    }
+
+    inline
+    void ipi_controller::invalidate (cpu_set targets, size address, unsigned pages)
+    {
+        address &= ~(page_size - 1);
+        for (auto bits = targets.bits(); bits != 0; bits &= bits - 1)
+        {
+            auto & target = _batches[__builtin_ctzll(bits)];
+            if (target.complete) continue;
+
+            target.pages += pages;
+            if (target.pages > flush_threshold) {
+                target.complete = true;
+                continue;
+            }
+
+            // Merge with last range when contiguous.
+            if (target.count != 0) {
+                auto & last = target.ranges[target.count - 1];
+                if (last.address + last.pages * page_size == address) {
+                    last.pages += pages;
+                    continue;
+                }
+            }
+
+            if (target.count == batch_capacity) {
+                target.complete = true;
+                continue;
+            }
+
+            target.ranges[target.count++] = { address, pages };
+        }
+    }
+
+    inline
+    void ipi_controller::commit_shootdown ()
+    {
+        auto const self = current();
+
+        cpu_set targets {};
+        for (unsigned i = 0; i != _count; ++i)
+            if (i != self && (_batches[i].count != 0 || _batches[i].complete))
+                targets.add(i);
+
+        __atomic_store_n(&_shootdown_pending, targets.count(), __ATOMIC_RELEASE);
+
+        send(targets, _shootdown_vector);
+
+        if (self != unknown)
+            flush(_batches[self]);
+
+        while (__atomic_load_n(&_shootdown_pending, __ATOMIC_ACQUIRE) != 0)
+            pause();
+
+        _shootdown_lock.unlock();
+    }
+
+    inline
+    void ipi_controller::shootdown (cpu_set targets, size address, unsigned pages)
+    {
+        begin_shootdown();
+        invalidate(targets, address, pages);
+        commit_shootdown();
+    }
+
+    inline
+    void ipi_controller::on_shootdown ()
+    {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        auto const self = current();
+        if (self != unknown)
+        {
+            auto & target = _batches[self];
+            if (target.count != 0 || target.complete)
+            {
+                flush(target);
+                __atomic_sub_fetch(&_shootdown_pending, 1, __ATOMIC_RELEASE);
+            }
+        }
+        eoi();
+    }
+
+    inline
+    void ipi_controller::flush (batch & target)
+    {
+        // #XXX: reloading CR3 does not invalidate global pages
+        if (target.complete) {
+            cr3(cr3());
+        }
+        else {
+            for (unsigned i = 0; i != target.count; ++i)
+                for (unsigned j = 0; j != target.ranges[i].pages; ++j)
+                    invlpg(target.ranges[i].address + j * page_size);
+        }
+        target.count = 0;
+        target.pages = 0;
+        target.complete = false;
+    }
+}
@@ -1029,6 +1029,250 @@ namespace x86
 
     static_assert(sizeof(long_small_page_directory_entry) == 8, "unexpected size of long_small_page_directory_entry");
 
+    //! 2 MiB page directory entry.
+
+    class long_large_page_directory_entry
+    {
+        size8 _present        :  1 {};
+        size8 _writable       :  1 {};
+        size8 _user           :  1 {};
+        size8 _write_through  :  1 {};
+        size8 _cache          :  1 {};
+        size8 _accessed       :  1 {};
+        size8 _dirty          :  1 {};
+        size8 _large          :  1 { 1 };
+        size8 _global         :  1 {};
+        size8 _available_low  :  3 {};
+        size8 _attribute      :  1 {};
+        size8 _zero           :  8 { 0 };
+        size8 _address        : 31 {};
+        size8 _available_high :  7 {};
+        size8 _mpk            :  4 {};
+        size8 _nonexecutable  :  1 {};
+
+    public:
+
+        //! Default constructor.
+
+        constexpr
+        long_large_page_directory_entry () = default;
+
+        //! Field constructor.
+
+        constexpr
+        long_large_page_directory_entry (
+            unsigned _BitInt(1)  present,
+            unsigned _BitInt(1)  writable,
+            unsigned _BitInt(1)  user,
+            unsigned _BitInt(1)  write_through,
+            unsigned _BitInt(1)  cache,
+            unsigned _BitInt(1)  accessed,
+            unsigned _BitInt(1)  dirty,
+            unsigned _BitInt(1)  global,
+            unsigned _BitInt(3)  available_low,
+            unsigned _BitInt(1)  attribute,
+            unsigned _BitInt(31) address,
+            unsigned _BitInt(7)  available_high,
+            unsigned _BitInt(4)  mpk,
+            unsigned _BitInt(1)  nonexecutable
+        );
+
+        //! Semantic constructor.
+
+        constexpr
+        long_large_page_directory_entry (
+            bool present,
+            bool writable,
+            bool user,
+            bool write_through,
+            bool cache,
+            bool accessed,
+            bool dirty,
+            unsigned _BitInt(3) attribute,
+            bool global,
+            unsigned _BitInt(10) available,
+            size8 address,
+            unsigned _BitInt(4) mpk,
+            bool nonexecutable
+        );
+
+        //! Page is present in memory.
+
+        auto present () const -> bool;
+
+        //! Page is writable.
+
+        auto writable () const -> bool;
+
+        //! Page is accessible by user (i.e. DPL 0).
+
+        auto user () const -> bool;
+
+        //! Page has write through.
+
+        auto write_through () const -> bool;
+
+        //! Page has cache.
+
+        auto cache () const -> bool;
+
+        //! Page was accessed.
+
+        auto accessed () const -> bool;
+
+        //! Page is dirty.
+
+        auto dirty () const -> bool;
+
+        //! Page attribute.
+
+        auto attribute () const -> unsigned _BitInt(3);
+
+        //! Page is global.
+
+        auto global () const -> bool;
+
+        //! Bits available to software.
+
+        auto available () const -> unsigned _BitInt(10);
+
+        //! Page address.
+
+        auto address () const -> size8;
+
+        //! Page memory protection key.
+
+        auto mpk () const -> unsigned _BitInt(4);
+
+        //! Page is not executable.
+
+        auto nonexecutable () const -> bool;
+    };
+
+    static_assert(sizeof(long_large_page_directory_entry) == 8, "unexpected size of long_large_page_directory_entry");
+
+    //! 1 GiB page directory pointer entry.
+
+    class long_large_page_directory_pointer_entry
+    {
+        size8 _present        :  1 {};
+        size8 _writable       :  1 {};
+        size8 _user           :  1 {};
+        size8 _write_through  :  1 {};
+        size8 _cache          :  1 {};
+        size8 _accessed       :  1 {};
+        size8 _dirty          :  1 {};
+        size8 _large          :  1 { 1 };
+        size8 _global         :  1 {};
+        size8 _available_low  :  3 {};
+        size8 _attribute      :  1 {};
+        size8 _zero           : 17 { 0 };
+        size8 _address        : 22 {};
+        size8 _available_high :  7 {};
+        size8 _mpk            :  4 {};
+        size8 _nonexecutable  :  1 {};
+
+    public:
+
+        //! Default constructor.
+
+        constexpr
+        long_large_page_directory_pointer_entry () = default;
+
+        //! Field constructor.
+
+        constexpr
+        long_large_page_directory_pointer_entry (
+            unsigned _BitInt(1)  present,
+            unsigned _BitInt(1)  writable,
+            unsigned _BitInt(1)  user,
+            unsigned _BitInt(1)  write_through,
+            unsigned _BitInt(1)  cache,
+            unsigned _BitInt(1)  accessed,
+            unsigned _BitInt(1)  dirty,
+            unsigned _BitInt(1)  global,
+            unsigned _BitInt(3)  available_low,
+            unsigned _BitInt(1)  attribute,
+            unsigned _BitInt(22) address,
+            unsigned _BitInt(7)  available_high,
+            unsigned _BitInt(4)  mpk,
+            unsigned _BitInt(1)  nonexecutable
+        );
+
+        //! Semantic constructor.
+
+        constexpr
+        long_large_page_directory_pointer_entry (
+            bool present,
+            bool writable,
+            bool user,
+            bool write_through,
+            bool cache,
+            bool accessed,
+            bool dirty,
+            unsigned _BitInt(3) attribute,
+            bool global,
+            unsigned _BitInt(10) available,
+            size8 address,
+            unsigned _BitInt(4) mpk,
+            bool nonexecutable
+        );
+
+        //! Page is present in memory.
+
+        auto present () const -> bool;
+
+        //! Page is writable.
+
+        auto writable () const -> bool;
+
+        //! Page is accessible by user (i.e. DPL 0).
+
+        auto user () const -> bool;
+
+        //! Page has write through.
+
+        auto write_through () const -> bool;
+
+        //! Page has cache.
+
+        auto cache () const -> bool;
+
+        //! Page was accessed.
+
+        auto accessed () const -> bool;
+
+        //! Page is dirty.
+
+        auto dirty () const -> bool;
+
+        //! Page attribute.
+
+        auto attribute () const -> unsigned _BitInt(3);
+
+        //! Page is global.
+
+        auto global () const -> bool;
+
+        //! Bits available to software.
+
+        auto available () const -> unsigned _BitInt(10);
+
+        //! Page address.
+
+        auto address () const -> size8;
+
+        //! Page memory protection key.
+
+        auto mpk () const -> unsigned _BitInt(4);
+
+        //! Page is not executable.
+
+        auto nonexecutable () const -> bool;
+    };
+
+    static_assert(sizeof(long_large_page_directory_pointer_entry) == 8, "unexpected size of long_large_page_directory_pointer_entry");
+
     //! 4 KiB page directory pointer entry.
 
     class long_small_page_directory_pointer_entry
@@ -2195,6 +2439,224 @@ namespace x86
     auto long_small_page_directory_entry::nonexecutable () const -> bool { return _nonexecutable; }
 }
 
+// Implementation: long_large_page_directory_entry
+
+namespace x86
+{
+    constexpr inline
+    long_large_page_directory_entry::long_large_page_directory_entry (
+        unsigned _BitInt(1)  present,
+        unsigned _BitInt(1)  writable,
+        unsigned _BitInt(1)  user,
+        unsigned _BitInt(1)  write_through,
+        unsigned _BitInt(1)  cache,
+        unsigned _BitInt(1)  accessed,
+        unsigned _BitInt(1)  dirty,
+        unsigned _BitInt(1)  global,
+        unsigned _BitInt(3)  available_low,
+        unsigned _BitInt(1)  attribute,
+        unsigned _BitInt(31) address,
+        unsigned _BitInt(7)  available_high,
+        unsigned _BitInt(4)  mpk,
+        unsigned _BitInt(1)  nonexecutable
+    ) :
+        _present{present},
+        _writable{writable},
+        _user{user},
+        _write_through{write_through},
+        _cache{cache},
+        _accessed{accessed},
+        _dirty{dirty},
+        _global{global},
+        _available_low{available_low},
+        _attribute{attribute},
+        _address{address},
+        _available_high{available_high},
+        _mpk{mpk},
+        _nonexecutable{nonexecutable}
+    { }
+
+    constexpr inline
+    long_large_page_directory_entry::long_large_page_directory_entry (
+        bool present,
+        bool writable,
+        bool user,
+        bool write_through,
+        bool cache,
+        bool accessed,
+        bool dirty,
+        unsigned _BitInt(3) attribute,
+        bool global,
+        unsigned _BitInt(10) available,
+        size8 address,
+        unsigned _BitInt(4) mpk,
+        bool nonexecutable
+    ) :
+        _present{present},
+        _writable{writable},
+        _user{user},
+        _write_through{write_through},
+        _cache{cache},
+        _accessed{accessed},
+        _dirty{dirty},
+        _global{global},
+        _available_low{available},
+        _attribute{attribute>>2},
+        _address{address>>21},
+        _available_high{available>>3},
+        _mpk{mpk},
+        _nonexecutable{nonexecutable}
+    { }
+
+    inline
+    auto long_large_page_directory_entry::present () const -> bool { return _present; }
+
+    inline
+    auto long_large_page_directory_entry::writable () const -> bool { return _writable; }
+
+    inline
+    auto long_large_page_directory_entry::user () const -> bool { return _user; }
+
+    inline
+    auto long_large_page_directory_entry::write_through () const -> bool { return _write_through; }
+
+    inline
+    auto long_large_page_directory_entry::cache () const -> bool { return _cache; }
+
+    inline
+    auto long_large_page_directory_entry::accessed () const -> bool { return _accessed; }
+
+    inline
+    auto long_large_page_directory_entry::dirty () const -> bool { return _dirty; }
+
+    inline
+    auto long_large_page_directory_entry::attribute () const -> unsigned _BitInt(3) { return _attribute << 2; }
+
+    inline
+    auto long_large_page_directory_entry::global () const -> bool { return _global; }
+
+    inline
+    auto long_large_page_directory_entry::available () const -> unsigned _BitInt(10) { return (_available_high << 3) | _available_low; }
+
+    inline
+    auto long_large_page_directory_entry::address () const -> size8 { return size8{_address} << 21; }
+
+    inline
+    auto long_large_page_directory_entry::mpk () const -> unsigned _BitInt(4) { return _mpk; }
+
+    inline
+    auto long_large_page_directory_entry::nonexecutable () const -> bool { return _nonexecutable; }
+}
+
+// Implementation: long_large_page_directory_pointer_entry
+
+namespace x86
+{
+    constexpr inline
+    long_large_page_directory_pointer_entry::long_large_page_directory_pointer_entry (
+        unsigned _BitInt(1)  present,
+        unsigned _BitInt(1)  writable,
+        unsigned _BitInt(1)  user,
+        unsigned _BitInt(1)  write_through,
+        unsigned _BitInt(1)  cache,
+        unsigned _BitInt(1)  accessed,
+        unsigned _BitInt(1)  dirty,
+        unsigned _BitInt(1)  global,
+        unsigned _BitInt(3)  available_low,
+        unsigned _BitInt(1)  attribute,
+        unsigned _BitInt(22) address,
+        unsigned _BitInt(7)  available_high,
+        unsigned _BitInt(4)  mpk,
+        unsigned _BitInt(1)  nonexecutable
+    ) :
+        _present{present},
+        _writable{writable},
+        _user{user},
+        _write_through{write_through},
+        _cache{cache},
+        _accessed{accessed},
+        _dirty{dirty},
+        _global{global},
+        _available_low{available_low},
+        _attribute{attribute},
+        _address{address},
+        _available_high{available_high},
+        _mpk{mpk},
+        _nonexecutable{nonexecutable}
+    { }
+
+    constexpr inline
+    long_large_page_directory_pointer_entry::long_large_page_directory_pointer_entry (
+        bool present,
+        bool writable,
+        bool user,
+        bool write_through,
+        bool cache,
+        bool accessed,
+        bool dirty,
+        unsigned _BitInt(3) attribute,
+        bool global,
+        unsigned _BitInt(10) available,
+        size8 address,
+        unsigned _BitInt(4) mpk,
+        bool nonexecutable
+    ) :
+        _present{present},
+        _writable{writable},
+        _user{user},
+        _write_through{write_through},
+        _cache{cache},
+        _accessed{accessed},
+        _dirty{dirty},
+        _global{global},
+        _available_low{available},
+        _attribute{attribute>>2},
+        _address{address>>30},
+        _available_high{available>>3},
+        _mpk{mpk},
+        _nonexecutable{nonexecutable}
+    { }
+
+    inline
+    auto long_large_page_directory_pointer_entry::present () const -> bool { return _present; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::writable () const -> bool { return _writable; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::user () const -> bool { return _user; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::write_through () const -> bool { return _write_through; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::cache () const -> bool { return _cache; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::accessed () const -> bool { return _accessed; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::dirty () const -> bool { return _dirty; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::attribute () const -> unsigned _BitInt(3) { return _attribute << 2; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::global () const -> bool { return _global; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::available () const -> unsigned _BitInt(10) { return (_available_high << 3) | _available_low; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::address () const -> size8 { return size8{_address} << 30; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::mpk () const -> unsigned _BitInt(4) { return _mpk; }
+
+    inline
+    auto long_large_page_directory_pointer_entry::nonexecutable () const -> bool { return _nonexecutable; }
+}
+
 // Implementation: long_small_page_directory_pointer_entry
 
 namespace x86
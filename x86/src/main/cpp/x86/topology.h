@@ -0,0 +1,157 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <x86/instructions.h>
+#include <x86/ipi.h>
+
+
+// Interface.
+
+namespace x86
+{
+    //! APIC id field widths: SMT thread in bits [0, smt), core in bits [smt, package), package above.
+    //!
+    //! Cache sharing: processors with equal APIC id above bit cache share the last level cache.
+
+    struct topology_shifts
+    {
+        unsigned smt;
+        unsigned package;
+        unsigned cache;
+    };
+
+    //! Find APIC id field widths for this processor, with cpuid leaf 0x1F, 0xB, or legacy leaves 1 and 4.
+
+    auto find_topology_shifts () -> topology_shifts;
+
+    //! Processor location.
+
+    struct processor_location
+    {
+        size4 package;
+        size4 core;
+        size4 thread;
+    };
+
+    //! Decompose APIC id into location.
+
+    constexpr
+    auto locate (size4 apic_id, topology_shifts shifts) -> processor_location;
+
+    //! Processor topology.
+    //!
+    //! Processors are identified by index, assigned in order of registration, like ipi_controller.
+
+    class topology
+    {
+        topology_shifts _shifts {};
+        size4           _apic_ids [cpu_set::capacity] {};
+        unsigned        _count {};
+
+        auto match (unsigned index, unsigned shift) const -> cpu_set;
+
+    public:
+
+        //! Object.
+        //! @{
+
+        explicit constexpr
+        topology (topology_shifts shifts) : _shifts { shifts } { }
+
+        //! Topology of processors with APIC ids.
+
+        topology (topology_shifts shifts, size4 const * apic_ids, unsigned count);
+
+        //! @}
+
+        //! Properties.
+        //! @{
+
+        auto shifts () const -> topology_shifts { return _shifts; }
+
+        auto count () const -> unsigned { return _count; }
+
+        auto apic_id (unsigned index) const -> size4 { return _apic_ids[index]; }
+
+        auto location (unsigned index) const -> processor_location { return locate(_apic_ids[index], _shifts); }
+
+        //! @}
+
+        //! Register processor with APIC id; returns its index, or capacity if full.
+
+        auto add (size4 apic_id) -> unsigned;
+
+        //! Processors sharing a core with processor index, including itself.
+
+        auto core_siblings (unsigned index) const -> cpu_set { return match(index, _shifts.smt); }
+
+        //! Processors sharing the last level cache with processor index, including itself.
+
+        auto cache_siblings (unsigned index) const -> cpu_set { return match(index, _shifts.cache); }
+
+        //! Processors in the same package as processor index, including itself.
+
+        auto package_siblings (unsigned index) const -> cpu_set { return match(index, _shifts.package); }
+
+        //! Number of packages.
+
+        auto packages () const -> unsigned;
+    };
+}
+
+// Definitions.
+
+namespace x86
+{
+    constexpr inline
+    auto locate (size4 apic_id, topology_shifts shifts) -> processor_location
+    {
+        auto const thread = apic_id & ((size4(1) << shifts.smt) - 1);
+        auto const core = (apic_id >> shifts.smt) & ((size4(1) << (shifts.package - shifts.smt)) - 1);
+        auto const package = shifts.package < 32 ? apic_id >> shifts.package : size4(0);
+        return { package, core, thread };
+    }
+
+    inline
+    topology::topology (topology_shifts shifts, size4 const * apic_ids, unsigned count) : _shifts { shifts }
+    {
+        for (unsigned i = 0; i != count; ++i) add(apic_ids[i]);
+    }
+
+    inline
+    auto topology::add (size4 apic_id) -> unsigned
+    {
+        for (unsigned i = 0; i != _count; ++i)
+            if (_apic_ids[i] == apic_id) return i;
+        if (_count == cpu_set::capacity) return cpu_set::capacity;
+        _apic_ids[_count] = apic_id;
+        return _count++;
+    }
+
+    inline
+    auto topology::match (unsigned index, unsigned shift) const -> cpu_set
+    {
+        cpu_set result {};
+        auto const key = shift < 32 ? _apic_ids[index] >> shift : size4(0);
+        for (unsigned i = 0; i != _count; ++i) {
+            auto const other = shift < 32 ? _apic_ids[i] >> shift : size4(0);
+            if (other == key) result.add(i);
+        }
+        return result;
+    }
+
+    inline
+    auto topology::packages () const -> unsigned
+    {
+        cpu_set seen {};
+        unsigned result = 0;
+        for (unsigned i = 0; i != _count; ++i) {
+            if (seen.contains(i)) continue;
+            auto const siblings = package_siblings(i);
+            seen = cpu_set { seen.bits() | siblings.bits() };
+            ++result;
+        }
+        return result;
+    }
+}
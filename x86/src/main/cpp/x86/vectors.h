@@ -0,0 +1,213 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#pragma once
+
+#include <x86/ipi.h>
+
+
+// Interface.
+
+namespace x86
+{
+    //! Interrupt vector on processor with index.
+    //!
+    //! Vector zero means allocation failed.
+
+    struct interrupt_vector
+    {
+        unsigned cpu;
+        size1    vector;
+    };
+
+    //! Interrupt vector allocator.
+    //!
+    //! Each processor has its own vector space; allocation prefers the least loaded processor in the affinity set.
+
+    class vector_allocator
+    {
+        ps::spin_lock      _lock {};
+        unsigned           _count {};
+        unsigned           _first {};
+        unsigned           _limit {};
+        unsigned long long _used [cpu_set::capacity][4] {};
+        unsigned           _load [cpu_set::capacity] {};
+
+    public:
+
+        //! Object.
+        //! @{
+
+        //! Allocator for processors [0, count) and vectors [first, limit).
+
+        vector_allocator (unsigned count, unsigned first = 0x30, unsigned limit = 0xF0);
+
+        vector_allocator (vector_allocator const &) = delete;
+
+        //! @}
+
+        //! Properties.
+        //! @{
+
+        //! Number of vectors allocated on processor with index.
+
+        auto load (unsigned cpu) const -> unsigned { return _load[cpu]; }
+
+        //! Test if vector is in use on processor with index.
+
+        auto is_used (unsigned cpu, size1 vector) const -> bool;
+
+        //! @}
+
+        //! Allocation.
+        //! @{
+
+        //! Reserve vector on every processor in set, for example for interprocessor interrupts.
+
+        void reserve (cpu_set targets, size1 vector);
+
+        //! Allocate one vector on the least loaded processor in affinity set.
+
+        auto allocate (cpu_set affinity) -> interrupt_vector;
+
+        //! Allocate count contiguous vectors, aligned to count, on the least loaded processor in affinity set.
+        //!
+        //! Count must be a power of two; multiple message MSI requires such blocks.
+
+        auto allocate_block (cpu_set affinity, unsigned count) -> interrupt_vector;
+
+        //! Allocate one vector per queue, spreading queues over processors in affinity set.
+        //!
+        //! Returns number of vectors allocated.
+
+        auto spread (cpu_set affinity, interrupt_vector * queues, unsigned count) -> unsigned;
+
+        //! Release count contiguous vectors.
+        //!
+        //! Vectors not currently allocated are ignored; releasing the failure result is a no-op.
+
+        void release (interrupt_vector allocation, unsigned count = 1);
+
+        //! @}
+
+    private:
+
+        auto least_loaded (cpu_set affinity, unsigned count) const -> unsigned;
+
+        auto find (unsigned cpu, unsigned count) const -> unsigned;
+
+        void mark (unsigned cpu, unsigned vector, unsigned count, bool used);
+    };
+}
+
+// Definitions.
+
+namespace x86
+{
+    inline
+    vector_allocator::vector_allocator (unsigned count, unsigned first, unsigned limit) :
+        _count { count < cpu_set::capacity ? count : cpu_set::capacity },
+        _first { first },
+        _limit { limit < 256 ? limit : 256 }
+    { }
+
+    inline
+    auto vector_allocator::is_used (unsigned cpu, size1 vector) const -> bool
+    {
+        unsigned const v = vector;
+        return (_used[cpu][v / 64] & (1ULL << (v % 64))) != 0;
+    }
+
+    inline
+    void vector_allocator::reserve (cpu_set targets, size1 vector)
+    {
+        ps::lock_guard guard { _lock };
+        for (auto bits = targets.bits() & first(_count).bits(); bits != 0; bits &= bits - 1)
+        {
+            unsigned const cpu = __builtin_ctzll(bits);
+            unsigned const v = vector;
+            _used[cpu][v / 64] |= 1ULL << (v % 64);
+        }
+    }
+
+    inline
+    auto vector_allocator::allocate (cpu_set affinity) -> interrupt_vector
+    {
+        return allocate_block(affinity, 1);
+    }
+
+    inline
+    auto vector_allocator::allocate_block (cpu_set affinity, unsigned count) -> interrupt_vector
+    {
+        if (count == 0 || (count & (count - 1)) != 0) return {};
+
+        ps::lock_guard guard { _lock };
+        auto const cpu = least_loaded(affinity, count);
+        if (cpu == cpu_set::capacity) return {};
+        auto const vector = find(cpu, count);
+        mark(cpu, vector, count, true);
+        return { cpu, size1(vector) };
+    }
+
+    inline
+    auto vector_allocator::spread (cpu_set affinity, interrupt_vector * queues, unsigned count) -> unsigned
+    {
+        // Least loaded processor first, so that queues land on distinct processors until all are taken.
+        for (unsigned i = 0; i != count; ++i)
+        {
+            queues[i] = allocate(affinity);
+            if (queues[i].vector == 0) return i;
+        }
+        return count;
+    }
+
+    inline
+    void vector_allocator::release (interrupt_vector allocation, unsigned count)
+    {
+        if (allocation.vector == 0 || allocation.cpu >= _count) return;
+        if (count == 0 || allocation.vector + count > 256) return;
+        ps::lock_guard guard { _lock };
+        mark(allocation.cpu, allocation.vector, count, false);
+    }
+
+    inline
+    auto vector_allocator::least_loaded (cpu_set affinity, unsigned count) const -> unsigned
+    {
+        auto result = cpu_set::capacity;
+        for (auto bits = affinity.bits() & first(_count).bits(); bits != 0; bits &= bits - 1)
+        {
+            unsigned const cpu = __builtin_ctzll(bits);
+            if (result != cpu_set::capacity && _load[cpu] >= _load[result]) continue;
+            if (find(cpu, count) == 0) continue;
+            result = cpu;
+        }
+        return result;
+    }
+
+    inline
+    auto vector_allocator::find (unsigned cpu, unsigned count) const -> unsigned
+    {
+        auto const start = (_first + count - 1) & ~(count - 1);
+        for (auto vector = start; vector + count <= _limit; vector += count)
+        {
+            auto free = true;
+            for (unsigned i = 0; i != count && free; ++i)
+                free = ! is_used(cpu, vector + i);
+            if (free) return vector;
+        }
+        return 0;
+    }
+
+    inline
+    void vector_allocator::mark (unsigned cpu, unsigned vector, unsigned count, bool used)
+    {
+        unsigned changed = 0;
+        for (unsigned i = vector; i != vector + count; ++i)
+        {
+            if (is_used(cpu, i) == used) continue;
+            _used[cpu][i / 64] ^= 1ULL << (i % 64);
+            ++changed;
+        }
+        if (used) _load[cpu] += changed;
+        else      _load[cpu] -= changed;
+    }
+}
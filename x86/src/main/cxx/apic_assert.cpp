@@ -10,3 +10,13 @@ static_assert(__is_standard_layout(x86::apic_w_location), "x86::apic_w_location
 static_assert(__is_standard_layout(x86::apic_rw_location), "x86::apic_rw_location is not standard layout");
 
 static_assert(__is_standard_layout(x86::apic_memory_map), "x86::apic_memory_map is not standard layout");
+
+static_assert(sizeof(x86::apic_memory_map) == 0x400, "unexpected size of x86::apic_memory_map");
+
+static_assert(__builtin_offsetof(x86::apic_memory_map, eoi) == 0xB0, "unexpected offset of x86::apic_memory_map::eoi");
+
+static_assert(__builtin_offsetof(x86::apic_memory_map, error_status) == 0x280, "unexpected offset of x86::apic_memory_map::error_status");
+
+static_assert(__builtin_offsetof(x86::apic_memory_map, interrupt_command_low) == 0x300, "unexpected offset of x86::apic_memory_map::interrupt_command_low");
+
+static_assert(__builtin_offsetof(x86::apic_memory_map, timer_divide) == 0x3E0, "unexpected offset of x86::apic_memory_map::timer_divide");
@@ -70,6 +70,24 @@ namespace x86
         return _in.data;
     }
 
+    void invlpg ( size address )
+    {
+        auto const _address = reinterpret_cast<void const *>(address);
+        __asm__ volatile ( "invlpg (%0)" : : "r"(_address) : "memory" );
+    }
+
+    void monitor ( void const * address, size4 extensions, size4 hints )
+    {
+        carrier4 _extensions { extensions }, _hints { hints };
+        __asm__ volatile ( "monitor" : : "a"(address), "c"(_extensions), "d"(_hints) : "memory" );
+    }
+
+    void mwait ( size4 hint, size4 extensions )
+    {
+        carrier4 _hint { hint }, _extensions { extensions };
+        __asm__ volatile ( "mwait" : : "a"(_hint), "c"(_extensions) : "memory" );
+    }
+
     void out1 ( size2 port, size1 data )
     {
         carrier2 _port { port };
@@ -104,6 +122,18 @@ namespace x86
         return _value.data;
     }
 
+    auto rdtsc () -> size8
+    {
+        carrier4 _low {}, _high {};
+        __asm__ volatile ( "rdtsc" : "=a"(_low), "=d"(_high) : : );
+        return (size8{_high.data} << 32) | _low.data;
+    }
+
+    void wbinvd ()
+    {
+        __asm__ volatile ( "wbinvd" : : : "memory" );
+    }
+
     void wrmsr (size4 id, size8  value)
     {
         carrier4 _id { id };
@@ -5,6 +5,11 @@
 
 namespace x86
 {
+    // #XXX: LLVM 13 doesn't know how to do extended asm with _ExtInt
+
+    struct carrier4 { size4 data {}; };
+    static_assert(sizeof(carrier4) == sizeof(size4), "unexpected size of carrier4");
+
     void enable_interrupts ()
     {
         __asm__ volatile ( "sti" : : : );
@@ -14,4 +19,17 @@ namespace x86
     {
         __asm__ volatile ( "cli" : : : );
     }
+
+    // STI delays interrupts until after the next instruction.
+
+    void enable_interrupts_and_halt ()
+    {
+        __asm__ volatile ( "sti; hlt" : : : "memory" );
+    }
+
+    void enable_interrupts_and_mwait ( size4 hint, size4 extensions )
+    {
+        carrier4 _hint { hint }, _extensions { extensions };
+        __asm__ volatile ( "sti; mwait" : : "a"(_hint), "c"(_extensions) : "memory" );
+    }
 }
\ No newline at end of file
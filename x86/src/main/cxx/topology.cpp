@@ -0,0 +1,88 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+#include <x86/topology.h>
+
+namespace x86
+{
+    namespace
+    {
+        auto ceil_log2 (unsigned value) -> unsigned
+        {
+            return value <= 1 ? 0 : 32 - __builtin_clz(value - 1);
+        }
+
+        //! Cache sharing shift from deterministic cache parameters: Intel leaf 4, AMD leaf 0x8000001D.
+
+        auto find_cache_shift (size leaf, unsigned fallback) -> unsigned
+        {
+            auto result = fallback;
+            unsigned deepest = 0;
+            for (size subleaf = 0; subleaf != 16; ++subleaf)
+            {
+                auto const r = cpuid(leaf, subleaf);
+                if ((r.a & 0x1F) == 0) break;
+                unsigned const level = (r.a >> 5) & 7;
+                if (level < deepest) continue;
+                deepest = level;
+                result = ceil_log2(unsigned((r.a >> 14) & 0xFFF) + 1);
+            }
+            return result;
+        }
+
+        //! Processor vendor is AMD: leaf 4 is reserved, core count comes from leaf 0x80000008.
+
+        auto is_amd (cpuid_type const & r) -> bool
+        {
+            return r.b == 0x68747541 && r.d == 0x69746E65 && r.c == 0x444D4163;
+        }
+    }
+
+    auto find_topology_shifts () -> topology_shifts
+    {
+        topology_shifts result { 0, 0, 0 };
+
+        auto const identification = cpuid(0);
+        auto const maximum = identification.a;
+        auto const extended = cpuid(0x80000000).a;
+
+        size leaf = 0;
+        if (maximum >= 0x1F && cpuid(0x1F).b != 0) leaf = 0x1F;
+        else if (maximum >= 0x0B && cpuid(0x0B).b != 0) leaf = 0x0B;
+
+        if (leaf != 0)
+        {
+            // Levels are enumerated from SMT upwards; the last level shift gives the package id.
+            for (size subleaf = 0; subleaf != 8; ++subleaf)
+            {
+                auto const r = cpuid(leaf, subleaf);
+                auto const type = (r.c >> 8) & 0xFF;
+                if (type == 0) break;
+                unsigned const shift = r.a & 0x1F;
+                if (type == 1) result.smt = shift;
+                result.package = shift;
+            }
+        }
+        else
+        {
+            auto const r = cpuid(1);
+            unsigned const logical = (r.d & (1 << 28)) != 0 ? unsigned((r.b >> 16) & 0xFF) : 1;
+            unsigned cores = 1;
+            if (is_amd(identification)) {
+                if (extended >= 0x80000008) cores = unsigned(cpuid(0x80000008).c & 0xFF) + 1;
+            }
+            else if (maximum >= 4) {
+                cores = unsigned((cpuid(4, 0).a >> 26) & 0x3F) + 1;
+            }
+            result.package = ceil_log2(logical);
+            result.smt = ceil_log2(logical > cores ? logical / cores : 1);
+        }
+
+        result.cache = result.package;
+        if (extended >= 0x8000001D && (cpuid(0x80000001).c & (1 << 22)) != 0)
+            result.cache = find_cache_shift(0x8000001D, result.package);
+        else if (maximum >= 4)
+            result.cache = find_cache_shift(4, result.package);
+
+        return result;
+    }
+}
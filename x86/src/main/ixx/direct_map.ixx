@@ -0,0 +1,15 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <x86/direct_map.h>
+
+export module br.dev.pedrolamarao.metal.x86:direct_map;
+
+export namespace x86
+{
+    using ::x86::direct_map_base;
+    using ::x86::phys_to_virt;
+    using ::x86::virt_to_phys;
+    using ::x86::direct_map;
+}
@@ -10,7 +10,11 @@ export namespace x86
 {
     using ::x86::find_age;
     using ::x86::has_cpuid;
+    using ::x86::has_gigabyte_pages;
     using ::x86::has_local_apic;
     using ::x86::has_long_mode;
+    using ::x86::has_monitor;
     using ::x86::has_msr;
+    using ::x86::has_mwait_interrupt_break;
+    using ::x86::mwait_substates;
 }
\ No newline at end of file
@@ -17,10 +17,15 @@ export namespace x86
     using ::x86::in1;
     using ::x86::in2;
     using ::x86::in4;
+    using ::x86::invlpg;
+    using ::x86::monitor;
+    using ::x86::mwait;
     using ::x86::out1;
     using ::x86::out2;
     using ::x86::out4;
     using ::x86::pause;
     using ::x86::rdmsr;
+    using ::x86::rdtsc;
+    using ::x86::wbinvd;
     using ::x86::wrmsr;
 }
\ No newline at end of file
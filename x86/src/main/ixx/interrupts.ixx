@@ -14,5 +14,7 @@ export namespace x86
     using ::x86::set_interrupt_descriptor_table;
     using ::x86::enable_interrupts;
     using ::x86::disable_interrupts;
+    using ::x86::enable_interrupts_and_halt;
+    using ::x86::enable_interrupts_and_mwait;
     using ::x86::interrupt;
 }
\ No newline at end of file
@@ -0,0 +1,19 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <x86/ipi.h>
+
+export module br.dev.pedrolamarao.metal.x86:ipi;
+
+export namespace x86
+{
+    using ::x86::ipi_delivery;
+    using ::x86::ipi_shorthand;
+    using ::x86::interrupt_command;
+    using ::x86::send_ipi;
+    using ::x86::cpu_set;
+    using ::x86::only;
+    using ::x86::first;
+    using ::x86::ipi_controller;
+}
@@ -19,6 +19,8 @@ export namespace x86
     using ::x86::extended_paging;
     using ::x86::long_page_table_entry;
     using ::x86::long_small_page_directory_entry;
+    using ::x86::long_large_page_directory_entry;
+    using ::x86::long_large_page_directory_pointer_entry;
     using ::x86::long_small_page_directory_pointer_entry;
     using ::x86::long_page_map_entry;
     using ::x86::long_paging;
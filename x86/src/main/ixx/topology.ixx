@@ -0,0 +1,16 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <x86/topology.h>
+
+export module br.dev.pedrolamarao.metal.x86:topology;
+
+export namespace x86
+{
+    using ::x86::topology_shifts;
+    using ::x86::find_topology_shifts;
+    using ::x86::processor_location;
+    using ::x86::locate;
+    using ::x86::topology;
+}
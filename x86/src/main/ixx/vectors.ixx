@@ -0,0 +1,13 @@
+// Copyright (C) 2023 Pedro Lamarão <pedro.lamarao@gmail.com>. All rights reserved.
+
+module;
+
+#include <x86/vectors.h>
+
+export module br.dev.pedrolamarao.metal.x86:vectors;
+
+export namespace x86
+{
+    using ::x86::interrupt_vector;
+    using ::x86::vector_allocator;
+}
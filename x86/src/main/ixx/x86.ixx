@@ -4,11 +4,15 @@ export module br.dev.pedrolamarao.metal.x86;
 
 export import :apic;
 export import :common;
+export import :direct_map;
 export import :identification;
 export import :instructions;
 export import :interrupts;
+export import :ipi;
 export import :msr;
 export import :pages;
 export import :ports;
 export import :registers;
-export import :segments;
\ No newline at end of file
+export import :segments;
+export import :topology;
+export import :vectors;
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace
+{
+    using x86::long_large_page_directory_entry;
+    using x86::long_large_page_directory_pointer_entry;
+    using x86::long_page_map_entry;
+    using x86::long_page_table_entry;
+    using x86::long_small_page_directory_entry;
+    using x86::long_small_page_directory_pointer_entry;
+
+    TEST(direct_map, translate)
+    {
+        ASSERT_EQ(x86::phys_to_virt(0), 0xFFFF800000000000);
+        ASSERT_EQ(x86::phys_to_virt(0xFEE00000), 0xFFFF8000FEE00000);
+        ASSERT_EQ(x86::virt_to_phys(0xFFFF8000FEE00000), 0xFEE00000);
+    }
+
+    TEST(direct_map, gigabyte)
+    {
+        static x86::direct_map<2, 2, 1> map { true };
+        ASSERT_EQ(map.page_size(), 0x40000000);
+
+        // Largest pages inside the range: 2 MiB up to 1 GiB, 1 GiB pages, then a 4 KiB page.
+        ASSERT_TRUE(map.map(0x20000000, 0xC0000800));
+        ASSERT_EQ(map.directory_count(), 2);
+        ASSERT_EQ(map.table_count(), 1);
+        ASSERT_TRUE(map.map(0x8000000000, 0x8040000000));
+        ASSERT_TRUE(map.map(0xC0200000, 0xC0400000));
+        ASSERT_EQ(map.limit(), ~ps::size8(0));
+
+        // Out of tables: the lowest address left unmapped is the limit.
+        ASSERT_FALSE(map.map(0x10000000000, 0x10000001000));
+        ASSERT_FALSE(map.map(0x100000000, 0x100001000));
+        ASSERT_EQ(map.limit(), 0x100000000);
+
+        alignas(0x1000) static long_page_map_entry page_map [0x200] {};
+        map.install(page_map);
+        ASSERT_FALSE(page_map[0xFF].present());
+        ASSERT_TRUE(page_map[0x100].present());
+        ASSERT_TRUE(page_map[0x101].present());
+        ASSERT_FALSE(page_map[0x102].present());
+
+        auto pointers = reinterpret_cast<long_large_page_directory_pointer_entry *>(ps::size(page_map[0x100].address()));
+        ASSERT_EQ(pointers[1].address(), 0x40000000);
+        ASSERT_EQ(pointers[2].address(), 0x80000000);
+        ASSERT_FALSE(pointers[4].present());
+
+        auto directory = reinterpret_cast<long_large_page_directory_entry *>(ps::size(reinterpret_cast<long_small_page_directory_pointer_entry *>(pointers)[0].address()));
+        ASSERT_FALSE(directory[0xFF].present());
+        ASSERT_EQ(directory[0x100].address(), 0x20000000);
+        ASSERT_EQ(directory[0x1FF].address(), 0x3FE00000);
+
+        directory = reinterpret_cast<long_large_page_directory_entry *>(ps::size(reinterpret_cast<long_small_page_directory_pointer_entry *>(pointers)[3].address()));
+        ASSERT_EQ(directory[1].address(), 0xC0200000);
+        ASSERT_FALSE(directory[2].present());
+        auto const table = reinterpret_cast<long_page_table_entry *>(ps::size(reinterpret_cast<long_small_page_directory_entry *>(directory)[0].address()));
+        ASSERT_EQ(table[0].address(), 0xC0000000);
+        ASSERT_FALSE(table[1].present());
+
+        pointers = reinterpret_cast<long_large_page_directory_pointer_entry *>(ps::size(page_map[0x101].address()));
+        ASSERT_EQ(pointers[0].address(), 0x8000000000);
+        ASSERT_FALSE(pointers[1].present());
+    }
+
+    TEST(direct_map, megabyte)
+    {
+        static x86::direct_map<1, 2, 1> map {};
+        ASSERT_EQ(map.page_size(), 0x200000);
+        ASSERT_TRUE(map.use_gigabyte_pages(true));
+        ASSERT_EQ(map.page_size(), 0x40000000);
+        ASSERT_TRUE(map.use_gigabyte_pages(false));
+
+        // Low memory and its hole share one page table.
+        ASSERT_TRUE(map.map(0, 0x9F000));
+        ASSERT_EQ(map.table_count(), 1);
+        // The partial 2 MiB at the end needs another page table.
+        ASSERT_FALSE(map.map(0x100000, 0x7FE0000));
+        ASSERT_EQ(map.limit(), 0x7E00000);
+        ASSERT_EQ(map.directory_count(), 1);
+        ASSERT_FALSE(map.use_gigabyte_pages(true));
+
+        // Range crossing 1 GiB takes a second directory; a third GiB finds none.
+        ASSERT_TRUE(map.map(0x3FE00000, 0x40400000));
+        ASSERT_EQ(map.directory_count(), 2);
+        ASSERT_FALSE(map.map(0x80000000, 0x80200000));
+        ASSERT_EQ(map.limit(), 0x7E00000);
+
+        alignas(0x1000) static long_page_map_entry page_map [0x200] {};
+        map.install(page_map);
+        auto const pointers = reinterpret_cast<long_small_page_directory_pointer_entry *>(ps::size(page_map[0x100].address()));
+        ASSERT_TRUE(pointers[0].present());
+        ASSERT_TRUE(pointers[1].present());
+        ASSERT_FALSE(pointers[2].present());
+
+        auto directory = reinterpret_cast<long_large_page_directory_entry *>(ps::size(pointers[0].address()));
+        for (auto i = 1; i != 0x3F; ++i) {
+            ASSERT_TRUE(directory[i].present());
+            ASSERT_EQ(directory[i].address(), ps::size8(i) << 21);
+        }
+        ASSERT_FALSE(directory[0x3F].present());
+        ASSERT_TRUE(directory[0x1FF].present());
+
+        // Video memory and firmware, between low memory and 1 MiB, stay unmapped.
+        auto const table = reinterpret_cast<long_page_table_entry *>(ps::size(reinterpret_cast<long_small_page_directory_entry *>(directory)[0].address()));
+        ASSERT_EQ(table[0x9E].address(), 0x9E000);
+        ASSERT_FALSE(table[0x9F].present());
+        ASSERT_FALSE(table[0xA0].present());
+        ASSERT_FALSE(table[0xFF].present());
+        ASSERT_EQ(table[0x100].address(), 0x100000);
+        ASSERT_EQ(table[0x1FF].address(), 0x1FF000);
+
+        directory = reinterpret_cast<long_large_page_directory_entry *>(ps::size(pointers[1].address()));
+        ASSERT_EQ(directory[0].address(), 0x40000000);
+        ASSERT_EQ(directory[1].address(), 0x40200000);
+        ASSERT_FALSE(directory[2].present());
+    }
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace
+{
+    unsigned called {};
+
+    void increment (void * argument)
+    {
+        called += *static_cast<unsigned *>(argument);
+    }
+
+    TEST(ipi, interrupt_command)
+    {
+        ASSERT_EQ(x86::interrupt_command(0x40, x86::ipi_delivery::fixed, x86::ipi_shorthand::none), 0x4040);
+        ASSERT_EQ(x86::interrupt_command(0x40, x86::ipi_delivery::fixed, x86::ipi_shorthand::all_but_self), 0xC4040);
+        ASSERT_EQ(x86::interrupt_command(0x08, x86::ipi_delivery::startup, x86::ipi_shorthand::none), 0x4608);
+    }
+
+    TEST(ipi, cpu_set)
+    {
+        auto set = x86::first(3);
+        ASSERT_EQ(set.count(), 3);
+        ASSERT_TRUE(set.contains(2));
+        set.remove(1);
+        ASSERT_FALSE(set.contains(1));
+        ASSERT_EQ(set.bits(), 5);
+        ASSERT_EQ(x86::first(64).count(), 64);
+        ASSERT_EQ(x86::only(5).bits(), 32);
+
+        // Indexes beyond capacity, such as unknown processors, are never members.
+        set.add(255);
+        set.remove(255);
+        ASSERT_EQ(set.bits(), 5);
+        ASSERT_FALSE(set.contains(255));
+    }
+
+    TEST(ipi_controller, send)
+    {
+        // Local APIC is simulated by memory: this processor has APIC id 2.
+
+        alignas(16) static x86::apic_memory_map apic {};
+        apic.id.value = 2 << 24;
+
+        static x86::ipi_controller controller { apic, 0x40, 0x41 };
+        ASSERT_EQ(controller.add(2), 0);
+        ASSERT_EQ(controller.add(4), 1);
+        ASSERT_EQ(controller.add(6), 2);
+        ASSERT_EQ(controller.add(4), 1);
+        ASSERT_EQ(controller.count(), 3);
+        ASSERT_EQ(controller.current(), 0);
+
+        controller.send(1, 0x50);
+        ASSERT_EQ(apic.interrupt_command_high.value, 4 << 24);
+        ASSERT_EQ(apic.interrupt_command_low.value, 0x4050);
+
+        controller.send(x86::only(2), 0x51);
+        ASSERT_EQ(apic.interrupt_command_high.value, 6 << 24);
+        ASSERT_EQ(apic.interrupt_command_low.value, 0x4051);
+
+        // Unregistered index: nothing is sent.
+        ASSERT_EQ(controller.apic_id(3), 0xFF);
+        controller.send(3, 0x54);
+        controller.send(x86::only(5), 0x54);
+        ASSERT_EQ(apic.interrupt_command_high.value, 6 << 24);
+        ASSERT_EQ(apic.interrupt_command_low.value, 0x4051);
+
+        // All but self: one broadcast.
+        apic.interrupt_command_high.value = 0;
+        controller.send(x86::cpu_set { 6 }, 0x52);
+        ASSERT_EQ(apic.interrupt_command_high.value, 0);
+        ASSERT_EQ(apic.interrupt_command_low.value, 0xC4052);
+
+        // Only self: runs locally, no acknowledgement pending.
+        unsigned argument = 3;
+        called = 0;
+        controller.call(x86::only(0), increment, &argument);
+        ASSERT_EQ(called, 3);
+
+        // Unregistered processors are not waited for.
+        controller.call(x86::cpu_set { 1 | 1ULL << 9 }, increment, &argument);
+        ASSERT_EQ(called, 6);
+
+        // Unregistered processor: all registered processors are others.
+        apic.id.value = 9 << 24;
+        ASSERT_EQ(controller.current(), 0xFF);
+        controller.send(x86::cpu_set { 7 }, 0x53);
+        ASSERT_EQ(apic.interrupt_command_low.value, 0xC4053);
+        apic.id.value = 2 << 24;
+    }
+
+    TEST(ipi_controller, batch)
+    {
+        alignas(16) static x86::apic_memory_map apic {};
+        static x86::ipi_controller controller { apic, 0x40, 0x41 };
+        controller.add(0);
+        controller.add(1);
+
+        // Contiguous ranges merge.
+        controller.invalidate(x86::only(1), 0x10000, 1);
+        controller.invalidate(x86::only(1), 0x11000, 2);
+        ASSERT_EQ(controller.pending(1), 1);
+        ASSERT_EQ(controller.pending(0), 0);
+
+        controller.invalidate(x86::first(2), 0x20000, 1);
+        ASSERT_EQ(controller.pending(0), 1);
+        ASSERT_EQ(controller.pending(1), 2);
+    }
+}
@@ -3034,6 +3034,884 @@ namespace x86
     }
 }
 
+// long_large_page_directory_entry
+
+namespace x86
+{
+    TEST(long_large_page_directory_entry_64, zero)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 0;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, present)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_TRUE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            true, false, false, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, writable)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_TRUE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 1;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, true, false, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, user)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_TRUE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 2;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, true, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, write_through)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_TRUE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 3;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, true, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, cache)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_TRUE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 4;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, true, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, accessed)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_TRUE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 5;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, true, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, dirty)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_TRUE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 6;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, true, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, global)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_TRUE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 8;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, false, 0, true, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, available)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0x3FF,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 0x7F0000000000E00;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0x7, 0, 0, 0x7F, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, false, 0, false, 0x3FF, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, attribute)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(4,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 12;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, false, 7, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, address)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0xFFFFFFFE00000,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 0xFFFFFFFE00000;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x7FFFFFFF, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0xFFFFFFFE00000, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, mpk)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0xF,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = size8{0xF} << 59;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xF, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0, 0xF, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_entry_64, nonexecutable)
+    {
+        auto test = [] (long_large_page_directory_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_TRUE(value.nonexecutable());
+        };
+
+        size8 memory = size8{1} << 63;
+        auto& reference = reinterpret_cast<long_large_page_directory_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0, 0, true
+        };
+        test(semantic);
+    }
+}
+
+// long_large_page_directory_pointer_entry
+
+namespace x86
+{
+    TEST(long_large_page_directory_pointer_entry_64, zero)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 0;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, present)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_TRUE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            true, false, false, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, writable)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_TRUE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 1;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, true, false, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, user)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_TRUE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 2;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, true, false, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, write_through)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_TRUE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 3;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, true, false, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, cache)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_TRUE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 4;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, true, false, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, accessed)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_TRUE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 5;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, true, false, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, dirty)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_TRUE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 6;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, true, 0, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, global)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_TRUE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 8;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, false, 0, true, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, available)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0x3FF,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 0x7F0000000000E00;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0x7, 0, 0, 0x7F, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, false, 0, false, 0x3FF, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, attribute)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(4,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 1 << 12;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, false, 7, false, 0, 0, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, address)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0xFFFFFC0000000,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = 0xFFFFFC0000000;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0x3FFFFF, 0, 0, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0xFFFFFC0000000, 0, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, mpk)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0xF,value.mpk());
+            ASSERT_FALSE(value.nonexecutable());
+        };
+
+        size8 memory = size8{0xF} << 59;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xF, 0 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0, 0xF, false
+        };
+        test(semantic);
+    }
+
+    TEST(long_large_page_directory_pointer_entry_64, nonexecutable)
+    {
+        auto test = [] (long_large_page_directory_pointer_entry& value) {
+            ASSERT_FALSE(value.present());
+            ASSERT_FALSE(value.writable());
+            ASSERT_FALSE(value.user());
+            ASSERT_FALSE(value.write_through());
+            ASSERT_FALSE(value.cache());
+            ASSERT_FALSE(value.accessed());
+            ASSERT_FALSE(value.dirty());
+            ASSERT_EQ(0,value.attribute());
+            ASSERT_FALSE(value.global());
+            ASSERT_EQ(0,value.available());
+            ASSERT_EQ(0,value.address());
+            ASSERT_EQ(0,value.mpk());
+            ASSERT_TRUE(value.nonexecutable());
+        };
+
+        size8 memory = size8{1} << 63;
+        auto& reference = reinterpret_cast<long_large_page_directory_pointer_entry&>(memory);
+        test(reference);
+
+        auto fields = long_large_page_directory_pointer_entry { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1 };
+        test(fields);
+
+        auto semantic = long_large_page_directory_pointer_entry {
+            false, false, false, false, false, false, false, 0, false, 0, 0, 0, true
+        };
+        test(semantic);
+    }
+}
+
 // long_small_page_directory_pointer_entry
     
 namespace x86
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace
+{
+    TEST(topology, locate)
+    {
+        x86::topology_shifts const shifts { 1, 4, 3 };
+        auto const location = x86::locate(0x1B, shifts);
+        ASSERT_EQ(location.package, 1);
+        ASSERT_EQ(location.core, 5);
+        ASSERT_EQ(location.thread, 1);
+    }
+
+    TEST(topology, siblings)
+    {
+        // Two packages, two cores with two threads each; cache shared by core pairs.
+        x86::topology_shifts const shifts { 1, 4, 2 };
+        ps::size4 const ids [] = { 0x00, 0x01, 0x02, 0x03, 0x10, 0x11, 0x12, 0x13 };
+        x86::topology topology { shifts, ids, 8 };
+        ASSERT_EQ(topology.count(), 8);
+        ASSERT_EQ(topology.packages(), 2);
+        ASSERT_EQ(topology.core_siblings(2).bits(), 0x0C);
+        ASSERT_EQ(topology.cache_siblings(5).bits(), 0xF0);
+        ASSERT_EQ(topology.package_siblings(1).bits(), 0x0F);
+        ASSERT_EQ(topology.location(6).package, 1);
+        ASSERT_EQ(topology.location(6).core, 1);
+        ASSERT_EQ(topology.add(0x11), 5);
+    }
+}
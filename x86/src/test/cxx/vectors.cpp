@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+
+import br.dev.pedrolamarao.metal.psys;
+import br.dev.pedrolamarao.metal.x86;
+
+namespace
+{
+    TEST(vector_allocator, allocate)
+    {
+        static x86::vector_allocator vectors { 2 };
+        vectors.reserve(x86::first(2), 0x30);
+
+        auto const a = vectors.allocate(x86::first(2));
+        ASSERT_EQ(a.cpu, 0);
+        ASSERT_EQ(a.vector, 0x31);
+
+        // Least loaded processor is preferred.
+        auto const b = vectors.allocate(x86::first(2));
+        ASSERT_EQ(b.cpu, 1);
+        ASSERT_EQ(b.vector, 0x31);
+
+        // Affinity is respected.
+        auto const c = vectors.allocate(x86::only(1));
+        ASSERT_EQ(c.cpu, 1);
+        ASSERT_EQ(c.vector, 0x32);
+
+        vectors.release(c);
+        ASSERT_FALSE(vectors.is_used(1, 0x32));
+        ASSERT_EQ(vectors.load(1), 1);
+
+        // Double release and release of failure result are ignored.
+        vectors.release(c);
+        ASSERT_EQ(vectors.load(1), 1);
+        vectors.release({});
+        ASSERT_EQ(vectors.load(0), 1);
+
+        // Processors outside the allocator are ignored.
+        ASSERT_EQ(vectors.allocate(x86::only(2)).vector, 0);
+    }
+
+    TEST(vector_allocator, block)
+    {
+        static x86::vector_allocator vectors { 1, 0x30, 0x40 };
+        vectors.reserve(x86::only(0), 0x31);
+
+        auto const a = vectors.allocate_block(x86::only(0), 4);
+        ASSERT_EQ(a.vector, 0x34);
+        ASSERT_EQ(vectors.allocate_block(x86::only(0), 3).vector, 0);
+        ASSERT_EQ(vectors.allocate_block(x86::only(0), 8).vector, 0x38);
+        ASSERT_EQ(vectors.allocate_block(x86::only(0), 8).vector, 0);
+    }
+
+    TEST(vector_allocator, spread)
+    {
+        static x86::vector_allocator vectors { 4 };
+        x86::interrupt_vector queues [8] {};
+        ASSERT_EQ(vectors.spread(x86::first(4), queues, 8), 8);
+        for (unsigned cpu = 0; cpu != 4; ++cpu)
+            ASSERT_EQ(vectors.load(cpu), 2);
+    }
+}